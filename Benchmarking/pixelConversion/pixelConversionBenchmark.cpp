@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pixelConversionBenchmark.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Throughput benchmark for the texture upload row converters
+ *
+ *  @scope
+ *
+ *  Converts a synthetic image with both the scalar and the runtime
+ *  selected (vectorized) row converter of each supported format pair,
+ *  verifies that the outputs match and reports the throughput in
+ *  megapixels per second.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "utils/pixelConverters.h"
+
+static const char *converterNames[ROW_CONVERTER_MAX] = {
+    "RGB8     -> RGBA8",
+    "BGRA8    -> RGBA8",
+    "RGB565   -> RGBA8",
+    "RGBA4444 -> RGBA8",
+    "RGBA5551 -> RGBA8",
+    "L8       -> RGBA8",
+    "LA8      -> RGBA8",
+    "A8       -> RGBA8"
+};
+
+static const uint32_t srcPixelSizes[ROW_CONVERTER_MAX] = { 3, 4, 2, 2, 2, 1, 2, 1 };
+
+static double
+Measure(RowConverterFunPtr converter, const uint8_t *src, uint8_t *dst,
+        uint32_t width, uint32_t height, uint32_t srcStride, uint32_t iterations)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for(uint32_t it = 0; it < iterations; ++it) {
+        for(uint32_t row = 0; row < height; ++row) {
+            converter(src + row * srcStride, dst + row * width * 4, width);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return (static_cast<double>(width) * height * iterations) / (seconds * 1e6);
+}
+
+int
+main(int argc, char **argv)
+{
+    uint32_t width      = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : 1024;
+    uint32_t height     = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 1024;
+    uint32_t iterations = argc > 3 ? static_cast<uint32_t>(atoi(argv[3])) : 20;
+
+    if(!width || !height || !iterations) {
+        printf("usage: %s [width] [height] [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> src(width * height * 4);
+    std::vector<uint8_t> dstScalar(width * height * 4);
+    std::vector<uint8_t> dstFast(width * height * 4);
+
+    srand(0);
+    for(auto &byte : src) {
+        byte = static_cast<uint8_t>(rand());
+    }
+
+    printf("Pixel conversion throughput, %ux%u, %u iterations\n\n", width, height, iterations);
+    printf("%-20s %12s %12s %8s %8s\n", "conversion", "scalar MP/s", "fast MP/s", "speedup", "isa");
+
+    int status = EXIT_SUCCESS;
+    for(uint32_t i = 0; i < ROW_CONVERTER_MAX; ++i) {
+        rowConverter_e type      = static_cast<rowConverter_e>(i);
+        uint32_t       srcStride = width * srcPixelSizes[i];
+
+        double scalar = Measure(GetScalarRowConverter(type), src.data(), dstScalar.data(), width, height, srcStride, iterations);
+        double fast   = Measure(GetRowConverter(type),       src.data(), dstFast.data(),   width, height, srcStride, iterations);
+
+        bool match = !memcmp(dstScalar.data(), dstFast.data(), dstFast.size());
+        if(!match) {
+            status = EXIT_FAILURE;
+        }
+
+        printf("%-20s %12.1f %12.1f %7.2fx %8s%s\n", converterNames[i], scalar, fast, fast / scalar,
+               GetRowConverterIsaName(GetRowConverterIsa(type)), match ? "" : "  MISMATCH");
+    }
+
+    return status;
+}
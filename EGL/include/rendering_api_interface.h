@@ -34,6 +34,7 @@ extern "C" {
 #endif
 #include "EGL/egl.h"
 #include "vulkan/vulkan.h"
+#include <mutex>
 
 typedef struct EGLSurfaceInterface_t {
     void    *surface;
@@ -48,6 +49,7 @@ typedef struct EGLSurfaceInterface_t {
     uint32_t height;
     uint32_t depthSize;
     uint32_t stencilSize;
+    uint32_t samples;
 } EGLSurfaceInterface;
 
 typedef void * api_state_t;
@@ -56,7 +58,7 @@ typedef void (*GLPROC)(void);
 
 typedef api_state_t (*init_API_cb_t)();
 typedef void (*terminate_API_cb_t)();
-typedef api_context_t (*create_context_cb_t)();
+typedef api_context_t (*create_context_cb_t)(api_context_t share_context);
 typedef void (*set_read_write_surface_cb_t)(api_context_t api_context, EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
 typedef void (*delete_shared_surface_data_cb_t)(EGLSurfaceInterface *eglSurfaceInterface);
 typedef void (*delete_context_cb_t)(api_context_t api_context);
@@ -64,7 +66,11 @@ typedef void (*release_system_fbo_cb_t)(api_context_t api_context);
 typedef GLPROC (*get_proc_addr_cb_t)(const char* procname);
 typedef void (*flush_cb_t)(api_context_t api_context);
 typedef void (*finish_cb_t)(api_context_t api_context);
+typedef void (*finish_frame_cb_t)(api_context_t api_context);
 typedef void (*bind_to_texture_cb_t)(api_context_t api_context, uint32_t bind);
+typedef uint64_t (*create_fence_sync_cb_t)(api_context_t api_context);
+typedef bool (*client_wait_fence_sync_cb_t)(api_context_t api_context, uint64_t sync, uint64_t timeout);
+typedef void (*release_current_context_cb_t)(api_context_t api_context);
 
 typedef struct rendering_api_interface {
     api_state_t state;
@@ -78,7 +84,11 @@ typedef struct rendering_api_interface {
     get_proc_addr_cb_t get_proc_addr_cb;
     flush_cb_t flush_cb;
     finish_cb_t finish_cb;
+    finish_frame_cb_t finish_frame_cb;
     bind_to_texture_cb_t bind_to_texture_cb;
+    create_fence_sync_cb_t create_fence_sync_cb;
+    client_wait_fence_sync_cb_t client_wait_fence_sync_cb;
+    release_current_context_cb_t release_current_context_cb;
 } rendering_api_interface_t;
 
 extern rendering_api_interface_t GLES2Interface;
@@ -108,6 +118,7 @@ typedef struct vkInterface {
     VkDevice                            vkDevice;
     VkPhysicalDeviceMemoryProperties    vkDeviceMemoryProperties;
     vkSyncItems_t                       *vkSyncItems;
+    std::mutex                          *vkQueueMutex;
 } vkInterface_t;
 
 #endif // __RENDERING_API_INTERFACE_H__
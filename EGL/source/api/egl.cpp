@@ -34,7 +34,7 @@
 #endif // DEBUG_DEPTH
 #define DEBUG_DEPTH                          EGL_LOG_INFO
 
-RenderingThread currentThread;
+thread_local RenderingThread currentThread;
 EGLGlobalResourceManager eglGlobalResourceManager;
 
 #define THREAD_EXEC_RETURN(func)             FUN_ENTRY(DEBUG_DEPTH);                                                      \
@@ -131,7 +131,9 @@ eglCreateContext(EGLDisplay dpy, EGLConfig config, EGLContext share_context, con
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_CONTEXT)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_CONTEXT)
     EGLContext_t* eglShareContext = static_cast<EGLContext_t*>(share_context);
-    // TODO::check for valid context
+    if(eglShareContext != EGL_NO_CONTEXT && eglDriver->CheckBadContext(eglShareContext) == EGL_FALSE) {
+        return EGL_NO_CONTEXT;
+    }
     THREAD_EXEC_RETURN(CreateContext(eglDriver, eglConfig, eglShareContext, attrib_list));
 }
 
@@ -458,7 +460,6 @@ eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image)
     return eglDriver->DestroyImageKHR(image);
 }
 
-//TODO: Implement the KHR_fence_sync extension
 EGLSyncKHR EGLAPIENTRY
 eglCreateSyncKHR(EGLDisplay dpy, EGLenum type, const EGLint *attrib_list)
 {
@@ -488,3 +489,13 @@ eglClientWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags, EGLTimeKHR t
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->ClientWaitSyncKHR(sync, flags, timeout);
 }
+
+EGLBoolean EGLAPIENTRY
+eglGetSyncAttribKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint attribute, EGLint *value)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
+    return eglDriver->GetSyncAttribKHR(sync, attribute, value);
+}
@@ -28,11 +28,11 @@
 #include "thread/renderingThread.h"
 #include <algorithm>
 
-EGLContext_t::EGLContext_t(EGLDisplay_t* display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList):
+EGLContext_t::EGLContext_t(EGLDisplay_t* display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList):
 EGLRefObject(),
 mAPIContext(nullptr), mRenderingAPI(rendering_api), mAPIInterface(nullptr),
 mDisplay(display), mReadSurface(nullptr), mDrawSurface(nullptr),
-mConfig(config), mAttribList(attribList), mClientVersion(1),
+mConfig(config), mShareContext(shareContext), mAttribList(attribList), mClientVersion(1),
 mIsCurrent(false)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
@@ -100,8 +100,6 @@ EGLContext_t::Validate()
         return EGL_FALSE;
     }
 
-    // TODO:: generate EGL_BAD_MATCH for incompatible share_contets
-
     return EGL_TRUE;
 }
 
@@ -122,7 +120,17 @@ EGLContext_t::Create()
         return EGL_FALSE;
     }
 
-    mAPIContext = mAPIInterface->create_context_cb();
+    // the objects of a context can only be shared with a context of the same client API version
+    api_context_t shareAPIContext = nullptr;
+    if(mShareContext != nullptr) {
+        if(mShareContext->mAPIInterface != mAPIInterface) {
+            currentThread.RecordError(EGL_BAD_MATCH);
+            return EGL_FALSE;
+        }
+        shareAPIContext = mShareContext->mAPIContext;
+    }
+
+    mAPIContext = mAPIInterface->create_context_cb(shareAPIContext);
 
     return mAPIContext != nullptr ? EGL_TRUE : EGL_FALSE;
 }
@@ -173,6 +181,16 @@ EGLContext_t::MakeCurrent(EGLDisplay_t *dpy, EGLSurface_t *draw, EGLSurface_t *r
     return EGL_TRUE;
 }
 
+void
+EGLContext_t::SetNotCurrent()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    mIsCurrent = false;
+
+    mAPIInterface->release_current_context_cb(mAPIContext);
+}
+
 void
 EGLContext_t::Flush()
 {
@@ -189,6 +207,14 @@ EGLContext_t::Finish()
     mAPIInterface->finish_cb(mAPIContext);
 }
 
+void
+EGLContext_t::FinishFrame()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    mAPIInterface->finish_frame_cb(mAPIContext);
+}
+
 void
 EGLContext_t::BindToTexture(EGLint bind)
 {
@@ -197,6 +223,22 @@ EGLContext_t::BindToTexture(EGLint bind)
     mAPIInterface->bind_to_texture_cb(mAPIContext, bind);
 }
 
+uint64_t
+EGLContext_t::CreateFenceSync()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    return mAPIInterface->create_fence_sync_cb(mAPIContext);
+}
+
+bool
+EGLContext_t::ClientWaitFenceSync(uint64_t sync, uint64_t timeout)
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    return mAPIInterface->client_wait_fence_sync_cb(mAPIContext, sync, timeout);
+}
+
 EGLBoolean
 EGLContext_t::ParseAttributeList(const EGLint* attrib_list)
 {
@@ -41,6 +41,7 @@ private:
     class EGLSurface_t          *mReadSurface;
     class EGLSurface_t          *mDrawSurface;
     struct EGLConfig_t          *mConfig;
+    EGLContext_t                *mShareContext;
     const EGLint                *mAttribList;
     EGLenum                      mClientVersion;
     bool                         mIsCurrent;
@@ -50,7 +51,7 @@ private:
     EGLBoolean                   Validate();
 
 public:
-    EGLContext_t(struct EGLDisplay_t * display, EGLenum rendering_api, EGLConfig_t* config, const EGLint *attribList);
+    EGLContext_t(struct EGLDisplay_t * display, EGLenum rendering_api, EGLConfig_t* config, EGLContext_t *shareContext, const EGLint *attribList);
     ~EGLContext_t();
 
     EGLBoolean                   Create();
@@ -59,10 +60,13 @@ public:
     //void                         SetNextImageIndex(uint32_t index);
     void                         Flush();
     void                         Finish();
+    void                         FinishFrame();
     void                         BindToTexture(EGLint bind);
+    uint64_t                     CreateFenceSync();
+    bool                         ClientWaitFenceSync(uint64_t sync, uint64_t timeout);
     void                         ReleaseSurfaceResources();
 
-    inline void                  SetNotCurrent()                                { FUN_ENTRY(EGL_LOG_TRACE); mIsCurrent = false; }
+    void                         SetNotCurrent();
 
     inline EGLenum               GetRenderingAPI()                        const { FUN_ENTRY(EGL_LOG_TRACE); return mRenderingAPI; }
     inline EGLDisplay_t         *GetDisplay()                             const { FUN_ENTRY(EGL_LOG_TRACE); return mDisplay; }
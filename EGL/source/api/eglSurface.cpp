@@ -29,7 +29,7 @@
 EGLSurface_t::EGLSurface_t():
 EGLRefObject (),
 Config(nullptr), Type(0), Width(0), Height(0),
-DepthSize(0), StencilSize(0), RedSize(0), GreenSize(0), BlueSize(0), AlphaSize(0),
+DepthSize(0), StencilSize(0), Samples(0), RedSize(0), GreenSize(0), BlueSize(0), AlphaSize(0),
 TextureFormat(0), TextureTarget(0), MipmapTexture(EGL_FALSE),
 LargestPbuffer(EGL_FALSE), RenderBuffer(0), VGAlphaFormat(0), VGColorspace(0),
 MipmapLevel(0), MultisampleResolve(0), SwapBehavior(0), HorizontalResolution(0),
@@ -242,6 +242,7 @@ EGLSurface_t::InitSurface(EGLint type, EGLConfig_t *conf, const EGLint *attrib_l
     AlphaSize         = GetConfigKey(conf, EGL_ALPHA_SIZE);
     DepthSize         = GetConfigKey(conf, EGL_DEPTH_SIZE);
     StencilSize       = GetConfigKey(conf, EGL_STENCIL_SIZE);
+    Samples           = GetConfigKey(conf, EGL_SAMPLES);
     BindToTextureRGB  = GetConfigKey(conf, EGL_BIND_TO_TEXTURE_RGB);
     BindToTextureRGBA = GetConfigKey(conf, EGL_BIND_TO_TEXTURE_RGBA);
 
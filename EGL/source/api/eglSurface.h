@@ -50,6 +50,7 @@ private:
     /* attributes set by attribute list */
     EGLint                           Width, Height;
     EGLint                           DepthSize, StencilSize;
+    EGLint                           Samples;
     EGLint                           RedSize, GreenSize, BlueSize, AlphaSize;
     EGLenum                          TextureFormat;
     EGLenum                          TextureTarget;
@@ -115,6 +116,7 @@ public:
     inline EGLint                    GetHeight()                                          const { FUN_ENTRY(EGL_LOG_TRACE); return Height; }
     inline EGLint                    GetDepthSize()                                       const { FUN_ENTRY(EGL_LOG_TRACE); return DepthSize; }
     inline EGLint                    GetStencilSize()                                     const { FUN_ENTRY(EGL_LOG_TRACE); return StencilSize; }
+    inline EGLint                    GetSamples()                                         const { FUN_ENTRY(EGL_LOG_TRACE); return Samples; }
     inline EGLint                    GetCurrentImageIndex()                               const { FUN_ENTRY(EGL_LOG_TRACE); return CurrentImageIndex; }
     inline EGLint                    GetColorFormat()                                     const { FUN_ENTRY(EGL_LOG_TRACE); return ColorFormat; }
     inline EGLSurfaceInterface_t    *GetEGLSurfaceInterface()                                   { FUN_ENTRY(EGL_LOG_TRACE); return &SurfaceInterface; }
@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       eglSync.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      EGL fence sync object (EGL_KHR_fence_sync). It is signaled when
+ *              the client API submission current at creation time has completed
+ *
+ */
+
+#include "utils/egl_defs.h"
+#include "eglSync.h"
+#include "thread/renderingThread.h"
+
+EGLSync_t::EGLSync_t(EGLContext_t *context, EGLenum type):
+mContext(context), mType(type), mSync(0), mSignaled(false)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+}
+
+EGLSync_t::~EGLSync_t()
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+}
+
+EGLBoolean
+EGLSync_t::Create()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    if(mContext == nullptr) {
+        return EGL_FALSE;
+    }
+
+    // pending commands are submitted here, so EGL_SYNC_FLUSH_COMMANDS_BIT_KHR
+    // has nothing left to flush when waiting
+    mSync = mContext->CreateFenceSync();
+
+    return EGL_TRUE;
+}
+
+EGLint
+EGLSync_t::ClientWait(EGLint flags, EGLTimeKHR timeout)
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    (void)flags;
+
+    if(!mSignaled) {
+        // EGL_FOREVER_KHR maps onto UINT64_MAX, which Vulkan treats as an infinite timeout
+        mSignaled = mContext->ClientWaitFenceSync(mSync, static_cast<uint64_t>(timeout));
+    }
+
+    return mSignaled ? EGL_CONDITION_SATISFIED_KHR : EGL_TIMEOUT_EXPIRED_KHR;
+}
+
+EGLBoolean
+EGLSync_t::GetAttrib(EGLint attribute, EGLint *value)
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    switch(attribute) {
+    case EGL_SYNC_TYPE_KHR:         *value = mType; break;
+    case EGL_SYNC_CONDITION_KHR:    *value = EGL_SYNC_PRIOR_COMMANDS_COMPLETE_KHR; break;
+    case EGL_SYNC_STATUS_KHR:       {
+                                        // poll without blocking
+                                        if(!mSignaled) {
+                                            mSignaled = mContext->ClientWaitFenceSync(mSync, 0);
+                                        }
+                                        *value = mSignaled ? EGL_SIGNALED_KHR : EGL_UNSIGNALED_KHR;
+                                        break;
+                                    }
+    default:                        { currentThread.RecordError(EGL_BAD_ATTRIBUTE); return EGL_FALSE; }
+    }
+
+    return EGL_TRUE;
+}
+
+void
+EGLSync_t::DetachContext()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    // the context is about to be destroyed, its submission has to complete first
+    if(!mSignaled) {
+        mContext->ClientWaitFenceSync(mSync, EGL_FOREVER_KHR);
+    }
+
+    mContext  = nullptr;
+    mSignaled = true;
+}
@@ -0,0 +1,52 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       eglSync.h
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      EGL fence sync object (EGL_KHR_fence_sync). It is signaled when
+ *              the client API submission current at creation time has completed
+ *
+ */
+
+#ifndef __EGL_SYNC_H__
+#define __EGL_SYNC_H__
+
+#include "EGL/egl.h"
+#include "EGL/eglext.h"
+#include "utils/eglLogger.h"
+#include "eglContext.h"
+
+class EGLSync_t {
+private:
+    EGLContext_t                *mContext;
+    EGLenum                      mType;
+    uint64_t                     mSync;
+    bool                         mSignaled;
+
+public:
+    EGLSync_t(EGLContext_t *context, EGLenum type);
+    ~EGLSync_t();
+
+    EGLBoolean                   Create();
+    EGLint                       ClientWait(EGLint flags, EGLTimeKHR timeout);
+    EGLBoolean                   GetAttrib(EGLint attribute, EGLint *value);
+    void                         DetachContext();
+
+    inline EGLContext_t         *GetContext()                             const { FUN_ENTRY(EGL_LOG_TRACE); return mContext; }
+};
+
+#endif // __EGL_SYNC_H__
@@ -41,7 +41,7 @@ void setCallingThread(RenderingThread *thread) { callingThread = thread; }
 
 DisplayDriver::DisplayDriver(EGLDisplay_t* eglDisplay)
 : mEGLDisplay(eglDisplay),
-  mActiveContext(nullptr), mWindowInterface(nullptr),
+  mWindowInterface(nullptr),
   mInitialized(false)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
@@ -148,11 +148,11 @@ DisplayDriver::Terminate()
 }
 
 EGLContext
-DisplayDriver::CreateContext(EGLenum rendering_api, EGLConfig_t* config, const EGLint* attribList)
+DisplayDriver::CreateContext(EGLenum rendering_api, EGLConfig_t* config, EGLContext_t* shareContext, const EGLint* attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t *eglContext = mDisplayDriverResourceManager.AddEGLContext(mEGLDisplay, rendering_api, config, attribList);
+    EGLContext_t *eglContext = mDisplayDriverResourceManager.AddEGLContext(mEGLDisplay, rendering_api, config, shareContext, attribList);
     return static_cast<EGLContext>(eglContext);
 }
 
@@ -344,6 +344,7 @@ DisplayDriver::CreateEGLSurfaceInterface(EGLSurface_t *eglSurface)
     surfaceInterface->height                = eglSurface->GetHeight();
     surfaceInterface->depthSize             = eglSurface->GetDepthSize();
     surfaceInterface->stencilSize           = eglSurface->GetStencilSize();
+    surfaceInterface->samples               = eglSurface->GetSamples();
     surfaceInterface->surfaceColorFormat    = eglSurface->GetColorFormat();
     surfaceInterface->nextImageIndex        = eglSurface->GetCurrentImageIndex();
 }
@@ -449,9 +450,10 @@ DisplayDriver::BindTexImage(EGLSurface_t* eglSurface, EGLint buffer)
 
     //TODO: We are assuming that the BindTexImage refers to the surface that is currently active for GLOVE.
     //If we have multiple surfaces for GLES, additional information may need to be passed to GLOVE.
-    mActiveContext->BindToTexture(EGL_TRUE);
+    EGLContext_t *eglContext = currentThread.GetCurrentContext();
+    eglContext->BindToTexture(EGL_TRUE);
     //If display and surface are the display and surface for the calling thread's current context, eglBindTexImage performs an implicit glFlush
-    mActiveContext->Finish();
+    eglContext->Finish();
 
     return EGL_TRUE;
 }
@@ -471,7 +473,7 @@ DisplayDriver::ReleaseTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
     }
-    mActiveContext->BindToTexture(EGL_FALSE);
+    currentThread.GetCurrentContext()->BindToTexture(EGL_FALSE);
 
     return EGL_TRUE;
 }
@@ -481,12 +483,13 @@ DisplayDriver::SwapInterval(EGLint interval)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    if(currentThread.GetCurrentContext() == nullptr) {
+    EGLContext_t *eglContext = currentThread.GetCurrentContext();
+    if(eglContext == nullptr) {
         currentThread.RecordError(EGL_BAD_CONTEXT);
         return EGL_FALSE;
     }
 
-    EGLSurface_t* surface = static_cast<EGLSurface_t*>(mActiveContext->GetDrawSurface());
+    EGLSurface_t* surface = static_cast<EGLSurface_t*>(eglContext->GetDrawSurface());
     if(surface == nullptr) {
         currentThread.RecordError(EGL_BAD_SURFACE);
         return EGL_FALSE;
@@ -495,7 +498,7 @@ DisplayDriver::SwapInterval(EGLint interval)
     //If the interval remains the same, there is no need to update the surface
     if(interval != surface->GetSwapInterval()) {
         surface->ClampSwapInterval(interval);
-        mActiveContext->Finish();
+        eglContext->Finish();
         UpdateSurface(surface);
     }
     return EGL_TRUE;
@@ -515,7 +518,15 @@ DisplayDriver::SwapBuffers(EGLSurface_t* eglSurface)
         return EGL_TRUE;
     }
 
-    mActiveContext->Finish();
+    // the frame ends here, unless the color buffer is preserved the contents
+    // of the multisampled and depth/stencil buffers are not needed anymore
+    EGLint swapBehavior = EGL_BUFFER_DESTROYED;
+    eglSurface->QuerySurface(EGL_SWAP_BEHAVIOR, &swapBehavior);
+    if(swapBehavior == EGL_BUFFER_PRESERVED) {
+        currentThread.GetCurrentContext()->Finish();
+    } else {
+        currentThread.GetCurrentContext()->FinishFrame();
+    }
 
     if(mWindowInterface->PresentImage(eglSurface) == EGL_FALSE) {
         UpdateSurface(eglSurface);
@@ -536,14 +547,15 @@ DisplayDriver::UpdateSurface(EGLSurface_t* eglSurface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    assert(mActiveContext != nullptr);
+    EGLContext_t *eglContext = currentThread.GetCurrentContext();
+    assert(eglContext != nullptr);
     assert(mWindowInterface != nullptr);
 
-    mActiveContext->ReleaseSurfaceResources();
+    eglContext->ReleaseSurfaceResources();
     mWindowInterface->DestroySurfaceImages(eglSurface);
     mWindowInterface->AllocateSurfaceImages(eglSurface);
     CreateEGLSurfaceInterface(eglSurface);
-    mActiveContext->MakeCurrent(mEGLDisplay, eglSurface, eglSurface);
+    eglContext->MakeCurrent(mEGLDisplay, eglSurface, eglSurface);
 }
 
 EGLBoolean
@@ -660,8 +672,26 @@ EGLSyncKHR
 DisplayDriver::CreateSyncKHR(EGLenum type, const EGLint *attrib_list)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
-    uintptr_t sync = 0xFE4CE000;
-    return ((EGLSyncKHR)sync);
+
+    if(type != EGL_SYNC_FENCE_KHR || (attrib_list != nullptr && *attrib_list != EGL_NONE)) {
+        currentThread.RecordError(EGL_BAD_ATTRIBUTE);
+        return EGL_NO_SYNC_KHR;
+    }
+
+    // the fence is inserted in the command stream of the current context
+    EGLContext_t *eglContext = currentThread.GetCurrentContext();
+    if(eglContext == nullptr) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        return EGL_NO_SYNC_KHR;
+    }
+
+    EGLSync_t *eglSync = mDisplayDriverResourceManager.AddEGLSync(eglContext, type);
+    if(eglSync == nullptr) {
+        currentThread.RecordError(EGL_BAD_ALLOC);
+        return EGL_NO_SYNC_KHR;
+    }
+
+    return static_cast<EGLSyncKHR>(eglSync);
 }
 
 EGLBoolean
@@ -669,6 +699,11 @@ DisplayDriver::DestroySyncKHR(EGLSyncKHR sync)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
+    if(mDisplayDriverResourceManager.RemoveEGLSync(static_cast<EGLSync_t *>(sync)) == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
     return EGL_TRUE;
 }
 
@@ -677,12 +712,32 @@ DisplayDriver::ClientWaitSyncKHR(EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeo
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
-    return EGL_CONDITION_SATISFIED_KHR;
+    EGLSync_t *eglSync = static_cast<EGLSync_t *>(sync);
+    if(mDisplayDriverResourceManager.FindEGLSync(eglSync) == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    return eglSync->ClientWait(flags, timeout);
+}
+
+EGLBoolean
+DisplayDriver::GetSyncAttribKHR(EGLSyncKHR sync, EGLint attribute, EGLint *value)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    EGLSync_t *eglSync = static_cast<EGLSync_t *>(sync);
+    if(mDisplayDriverResourceManager.FindEGLSync(eglSync) == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    return eglSync->GetAttrib(attribute, value);
 }
 
 const char *DisplayDriver::GetExtensions()
 {
-    return "";
+    return "EGL_KHR_fence_sync";
 }
 
 EGLBoolean
@@ -46,7 +46,6 @@ void setCallingThread(RenderingThread *thread);
 class DisplayDriver {
 private:
     EGLDisplay_t                *mEGLDisplay;
-    EGLContext_t                *mActiveContext;
     PlatformWindowInterface     *mWindowInterface;
     DisplayDriverResourceManager mDisplayDriverResourceManager;
     bool                         mInitialized;
@@ -60,7 +59,6 @@ public:
     DisplayDriver(EGLDisplay_t *eglDisplay);
     ~DisplayDriver(void);
 
-    inline void                  SetActiveContext(EGLContext ctx)               { FUN_ENTRY(EGL_LOG_TRACE); mActiveContext = static_cast<EGLContext_t *>(ctx); }
     inline bool                  Initialized()                            const { FUN_ENTRY(EGL_LOG_TRACE); return mInitialized; }
     void                         CleanMarkedResources(void);
 
@@ -73,7 +71,7 @@ public:
     /// EGL API core functions
     EGLBoolean                   Initialize(EGLint *major, EGLint *minor);
     EGLBoolean                   Terminate(void);
-    EGLContext                   CreateContext(EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext                   CreateContext(EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   DestroyContext(EGLContext_t *eglContext);
     EGLBoolean                   GetConfigs(EGLConfig *configs, EGLint config_size, EGLint *num_config);
     EGLBoolean                   ChooseConfig(const EGLint *attrib_list, EGLConfig *configs, EGLint config_size, EGLint *num_config);
@@ -98,6 +96,7 @@ public:
     EGLSyncKHR                   CreateSyncKHR(EGLenum type, const EGLint *attrib_list);
     EGLBoolean                   DestroySyncKHR(EGLSyncKHR sync);
     EGLint                       ClientWaitSyncKHR(EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeout);
+    EGLBoolean                   GetSyncAttribKHR(EGLSyncKHR sync, EGLint attribute, EGLint *value);
 };
 
 #endif // __DISPLAY_DRIVER_H__
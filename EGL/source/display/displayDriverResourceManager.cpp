@@ -129,11 +129,11 @@ DisplayDriverResourceManager::FindEGLContext(const EGLContext_t* eglContext) con
 }
 
 EGLContext_t*
-DisplayDriverResourceManager::CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList)
+DisplayDriverResourceManager::CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t * eglContext = new EGLContext_t(display, rendering_api, config, attribList);
+    EGLContext_t * eglContext = new EGLContext_t(display, rendering_api, config, shareContext, attribList);
 
     if(eglContext->Create() == EGL_FALSE) {
         delete eglContext;
@@ -148,6 +148,13 @@ DisplayDriverResourceManager::DeleteEGLContext(EGLContext_t* eglContext)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    // fences of the context cannot be waited on once it is gone
+    for(auto syncIter : mSyncList) {
+        if(syncIter->GetContext() == eglContext) {
+            syncIter->DetachContext();
+        }
+    }
+
     if(eglContext->Destroy() == EGL_FALSE) {
         return EGL_FALSE;
     }
@@ -156,11 +163,11 @@ DisplayDriverResourceManager::DeleteEGLContext(EGLContext_t* eglContext)
 }
 
 EGLContext_t*
-DisplayDriverResourceManager::AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList)
+DisplayDriverResourceManager::AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t *eglContext = CreateEGLContext(display, rendering_api, config, attribList);
+    EGLContext_t *eglContext = CreateEGLContext(display, rendering_api, config, shareContext, attribList);
 
     if(eglContext) {
         mContextList.push_back(eglContext);
@@ -182,6 +189,49 @@ DisplayDriverResourceManager::RemoveEGLContext(EGLContext_t* eglContext)
     return EGL_FALSE;
 }
 
+EGLBoolean
+DisplayDriverResourceManager::FindEGLSync(const EGLSync_t* eglSync) const
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    const auto iter = std::find(mSyncList.begin(), mSyncList.end(), eglSync);
+    if(iter == mSyncList.end()) {
+        return EGL_FALSE;
+    }
+    return EGL_TRUE;
+}
+
+EGLSync_t*
+DisplayDriverResourceManager::AddEGLSync(EGLContext_t *eglContext, EGLenum type)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    EGLSync_t *eglSync = new EGLSync_t(eglContext, type);
+
+    if(eglSync->Create() == EGL_FALSE) {
+        delete eglSync;
+        return nullptr;
+    }
+
+    mSyncList.push_back(eglSync);
+
+    return eglSync;
+}
+
+EGLBoolean
+DisplayDriverResourceManager::RemoveEGLSync(EGLSync_t* eglSync)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    const auto iter = std::find(mSyncList.begin(), mSyncList.end(), eglSync);
+    if(iter != mSyncList.end()) {
+        mSyncList.erase(iter);
+        delete eglSync;
+        return EGL_TRUE;
+    }
+    return EGL_FALSE;
+}
+
 void
 DisplayDriverResourceManager::CleanMarkedResources(PlatformWindowInterface *windowInterface)
 {
@@ -228,4 +278,10 @@ DisplayDriverResourceManager::CleanResources(PlatformWindowInterface *windowInte
         DeleteEGLContext(contextIter);
     }
     mContextList.clear();
+
+    // clear syncs
+    for (auto syncIter : mSyncList) {
+        delete syncIter;
+    }
+    mSyncList.clear();
 }
@@ -29,6 +29,7 @@
 #include "api/eglContext.h"
 #include "api/eglConfig.h"
 #include "api/eglSurface.h"
+#include "api/eglSync.h"
 #include "vector"
 
 class DisplayDriverResourceManager
@@ -38,9 +39,10 @@ protected:
     std::vector<EGLSurface_t*>   mSurfaceList;
     std::vector<EGLConfig_t*>    mConfigList;
     std::vector<EGLContext_t*>   mContextList;
+    std::vector<EGLSync_t*>      mSyncList;
 
     // EGLContext resources
-    EGLContext_t                *CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext_t                *CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   DeleteEGLContext(EGLContext_t* eglContext);
 
     // EGLSurface resources
@@ -61,10 +63,15 @@ public:
     EGLBoolean                   FindEGLSurface(const EGLSurface_t* eglSurface) const;
 
     // EGLContext resources
-    EGLContext_t                *AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext_t                *AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   RemoveEGLContext(EGLContext_t* eglContext);
     EGLBoolean                   FindEGLContext(const EGLContext_t* eglContext) const;
 
+    // EGLSync resources
+    EGLSync_t                   *AddEGLSync(EGLContext_t *eglContext, EGLenum type);
+    EGLBoolean                   RemoveEGLSync(EGLSync_t* eglSync);
+    EGLBoolean                   FindEGLSync(const EGLSync_t* eglSync) const;
+
     void                         CleanResources(class PlatformWindowInterface *windowInterface);
     void                         CleanMarkedResources(class PlatformWindowInterface *windowInterface);
 
@@ -356,6 +356,9 @@ VulkanWindowInterface::PresentImage(EGLSurface_t *surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    // the queue and the semaphore chain are shared with the submissions of all contexts
+    std::lock_guard<std::mutex> lock(*mVkInterface->vkQueueMutex);
+
     std::vector<VkSemaphore> pSems;
     if(mVkInterface->vkSyncItems->drawSemaphoreFlag) {
         pSems.push_back(mVkInterface->vkSyncItems->vkDrawSemaphore);
@@ -26,6 +26,10 @@
 #include "display/displayDriver.h"
 #include "utils/eglLogger.h"
 #include "api/eglGlobalResourceManager.h"
+#include <mutex>
+
+// serializes eglMakeCurrent calls, as a context can be current to one thread only
+static std::mutex makeCurrentMutex;
 
 const char * const RenderingThread::EGLErrors[] = {   "EGL_SUCCESS",
                                                       "EGL_NOT_INITIALIZED",
@@ -44,7 +48,7 @@ const char * const RenderingThread::EGLErrors[] = {   "EGL_SUCCESS",
                                                       "EGL_CONTEXT_LOST"};
 
 RenderingThread::RenderingThread()
-: mCurrentAPI(EGL_OPENGL_ES_API), mLastError(EGL_SUCCESS)
+: mCurrentAPI(EGL_OPENGL_ES_API), mGLESCurrentContext(nullptr), mVGCurrentContext(nullptr), mLastError(EGL_SUCCESS)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 }
@@ -114,9 +118,26 @@ RenderingThread::ReleaseThread(void)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    NOT_IMPLEMENTED();
+    // release the contexts of all client APIs that are current to the calling thread
+    EGLContext_t *currentContexts[] = {mGLESCurrentContext, mVGCurrentContext};
+    EGLenum       currentAPIs[]     = {EGL_OPENGL_ES_API, EGL_OPENVG_API};
+    for(uint32_t i = 0; i < 2; ++i) {
+        if(currentContexts[i] == nullptr) {
+            continue;
+        }
+
+        EGLDisplay_t *dpy = currentContexts[i]->GetDisplay();
+        DisplayDriver *eglDriver = eglGlobalResourceManager.FindDriver(dpy);
+        if(eglDriver != nullptr) {
+            mCurrentAPI = currentAPIs[i];
+            MakeCurrent(eglDriver, dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+    }
 
-    return EGL_FALSE;
+    mCurrentAPI = EGL_OPENGL_ES_API;
+    mLastError  = EGL_SUCCESS;
+
+    return EGL_TRUE;
 }
 
 void
@@ -202,7 +223,13 @@ RenderingThread::CreateContext(DisplayDriver* eglDriver, EGLConfig_t* eglConfig,
         return EGL_NO_CONTEXT;
     }
 
-    return eglDriver->CreateContext(mCurrentAPI, eglConfig, attrib_list);
+    // objects can only be shared between contexts of the same client API
+    if(eglShareContext != nullptr && eglShareContext->GetRenderingAPI() != mCurrentAPI) {
+        RecordError(EGL_BAD_MATCH);
+        return EGL_NO_CONTEXT;
+    }
+
+    return eglDriver->CreateContext(mCurrentAPI, eglConfig, eglShareContext, attrib_list);
 }
 
 EGLBoolean
@@ -291,8 +318,13 @@ RenderingThread::ValidateCurrentContext(DisplayDriver* eglDriver, EGLSurface_t*
         return EGL_FALSE;
     }
 
-    // TODO:: If ctx is current to some other thread, or if either draw or read are bound to
-    // contexts in another thread, an EGL_BAD_ACCESS error is generated.
+    // generate EGL_BAD_ACCESS if ctx is current to some other thread
+    if(eglContext != EGL_NO_CONTEXT && eglContext->IsCurrent() && eglContext != GetCurrentContext()) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
+
+    // TODO:: If either draw or read are bound to contexts in another thread, an EGL_BAD_ACCESS error is generated.
 
     // TODO:: If binding ctx would exceed the number of current contexts of that client
     // API type supported by the implementation, an EGL_BAD_ACCESS error is generated
@@ -321,6 +353,9 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     EGLContext_t* eglContext = static_cast<EGLContext_t*>(ctx);
     EGLSurface_t *eglDrawSurface = static_cast<EGLSurface_t*>(draw);
     EGLSurface_t *eglReadSurface = static_cast<EGLSurface_t*>(read);
+
+    std::lock_guard<std::mutex> lock(makeCurrentMutex);
+
     if(ValidateCurrentContext(eglDriver, eglDrawSurface, eglReadSurface, eglContext) == EGL_FALSE) {
         return EGL_FALSE;
     }
@@ -338,7 +373,7 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     }
 
     // mark as not context the last context
-    if(currentContext != nullptr) {
+    if(currentContext != nullptr && currentContext != eglContext) {
         currentContext->SetNotCurrent();
     }
 
@@ -347,8 +382,6 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     currentContext = GetCurrentContext();
     UpdateCurrentContextResourcesRef(currentContext, true);
 
-    eglDriver->SetActiveContext(currentContext);
-
     // clean any marked resources that may have been released after the current call to MakeCurrent
     eglDriver->CleanMarkedResources();
 
@@ -381,7 +414,7 @@ RenderingThread::WaitNative(EGLint engine)
     }
 
     // TODO:: implement EGL_BAD_CURRENT_SURFACE
-    NOT_IMPLEMENTED();
-
-    return EGL_FALSE;
+    // there is no native renderer that could be drawing to the current surfaces,
+    // so there is nothing to wait for and the current context stays bound
+    return EGL_TRUE;
 }
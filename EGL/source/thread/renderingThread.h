@@ -64,6 +64,7 @@ public:
     EGLBoolean              WaitNative(EGLint engine);
 };
 
-extern RenderingThread currentThread;
+/// The EGL state of the calling thread (current API, current contexts and last error)
+extern thread_local RenderingThread currentThread;
 
 #endif // __RENDERINGTHREAD_H__
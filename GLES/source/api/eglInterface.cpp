@@ -30,7 +30,7 @@ static api_state_t    gles2_state = nullptr;
 
 api_state_t           init_API();
           void        terminate_API();
-api_context_t         create_context();
+api_context_t         create_context(api_context_t share_context);
 void                  set_read_write_surface(api_context_t api_context, EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
 void                  delete_shared_surface_data(EGLSurfaceInterface *eglSurfaceInterface);
 void                  delete_context(api_context_t api_context);
@@ -38,9 +38,14 @@ void                  release_system_fbo(api_context_t api_context);
 GLPROC                get_proc_addr(const char* procname);
 void                  flush(api_context_t api_context);
 void                  finish(api_context_t api_context);
+void                  finish_frame(api_context_t api_context);
 void                  bind_to_texture(api_context_t api_context, uint32_t bind);
+uint64_t              create_fence_sync(api_context_t api_context);
+bool                  client_wait_fence_sync(api_context_t api_context, uint64_t sync, uint64_t timeout);
+void                  release_current_context(api_context_t api_context);
 
 static void           FillInVkInterface(vulkanAPI::vkContext_t* vkContext);
+static void           ExecuteOnContext(Context *ctx, const CommandStream::command_t &command);
 
 rendering_api_interface_t GLES2Interface = {
     gles2_state,
@@ -54,7 +59,11 @@ rendering_api_interface_t GLES2Interface = {
     get_proc_addr,
     flush,
     finish,
-    bind_to_texture
+    finish_frame,
+    bind_to_texture,
+    create_fence_sync,
+    client_wait_fence_sync,
+    release_current_context
 };
 
 #ifdef WIN32
@@ -73,6 +82,19 @@ static void FillInVkInterface(vulkanAPI::vkContext_t* vkContext)
     vkInterface.vkDeviceMemoryProperties = vkContext->vkDeviceMemoryProperties;
     vkInterface.vkDevice = vkContext->vkDevice;
     vkInterface.vkSyncItems = vkContext->vkSyncItems;
+    vkInterface.vkQueueMutex = &vkContext->vkQueueMutex;
+}
+
+static void ExecuteOnContext(Context *ctx, const CommandStream::command_t &command)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // the backend thread of the context, if any, owns its Vulkan recording
+    if(ctx->GetCommandStream()) {
+        ctx->GetCommandStream()->Execute(command);
+    } else {
+        command();
+    }
 }
 
 api_state_t init_API()
@@ -94,11 +116,11 @@ void terminate_API()
     GLLogger::Shutdown();
 }
 
-api_context_t create_context()
+api_context_t create_context(api_context_t share_context)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    Context *ctx = new Context();
+    Context *ctx = new Context(reinterpret_cast<Context *>(share_context));
     return ctx;
 }
 
@@ -108,7 +130,7 @@ void set_read_write_surface(api_context_t api_context, EGLSurfaceInterface *eglR
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
     SetCurrentContext(ctx);
-    ctx->SetReadWriteSurfaces(eglReadSurfaceInterface, eglWriteSurfaceInterface);
+    ExecuteOnContext(ctx, [&]() { ctx->SetReadWriteSurfaces(eglReadSurfaceInterface, eglWriteSurfaceInterface); });
 }
 
 void delete_shared_surface_data(EGLSurfaceInterface *eglSurfaceInterface)
@@ -124,6 +146,9 @@ void delete_context(api_context_t api_context)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
+    if(GetCurrentContext() == ctx) {
+        SetCurrentContext(nullptr);
+    }
     delete ctx;
 }
 
@@ -132,7 +157,7 @@ void release_system_fbo(api_context_t api_context)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
-    ctx->ReleaseSystemFBO();
+    ExecuteOnContext(ctx, [&]() { ctx->ReleaseSystemFBO(); });
 }
 
 GLPROC get_proc_addr(const char* procname)
@@ -147,7 +172,7 @@ void flush(api_context_t api_context)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
-    ctx->Flush();
+    ExecuteOnContext(ctx, [&]() { ctx->Flush(); });
 }
 
 void finish(api_context_t api_context)
@@ -155,7 +180,15 @@ void finish(api_context_t api_context)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
-    ctx->Finish();
+    ExecuteOnContext(ctx, [&]() { ctx->Finish(); });
+}
+
+void finish_frame(api_context_t api_context)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    ExecuteOnContext(ctx, [&]() { ctx->FinishFrame(); });
 }
 
 void bind_to_texture(api_context_t api_context, uint32_t bind)
@@ -163,5 +196,37 @@ void bind_to_texture(api_context_t api_context, uint32_t bind)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
-    ctx->BindToTexture(bind);
+    ExecuteOnContext(ctx, [&]() { ctx->BindToTexture(bind); });
+}
+
+uint64_t create_fence_sync(api_context_t api_context)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    uint64_t sync = 0;
+    ExecuteOnContext(ctx, [&]() { sync = ctx->CreateFenceSync(); });
+    return sync;
+}
+
+bool client_wait_fence_sync(api_context_t api_context, uint64_t sync, uint64_t timeout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    bool signaled = false;
+    ExecuteOnContext(ctx, [&]() { signaled = ctx->ClientWaitFenceSync(sync, timeout); });
+    return signaled;
+}
+
+void release_current_context(api_context_t api_context)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // another context may have already been made current on this thread
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    ExecuteOnContext(ctx, [&]() { ctx->FlushPendingDraw(); });
+    if(GetCurrentContext() == ctx) {
+        SetCurrentContext(nullptr);
+    }
 }
@@ -23,26 +23,91 @@
 
 #include "context/context.h"
 
-#define CONTEXT_EXEC(func)          FUN_ENTRY(GL_LOG_INFO);                      \
-                                    Context * context = GetCurrentContext();     \
-                                    if (context) {                               \
-                                        context->func;                           \
+/// Any call other than a draw call ends the run of draws the context may coalesce,
+/// so the state they have been recorded with cannot change until they are flushed.
+///
+/// With GLOVE_ENABLE_DEFERRED_COMMAND_STREAM the calls are executed by the backend thread of the context:
+/// - CONTEXT_EXEC waits for the call to complete, as its pointer arguments are only valid during the call
+/// - CONTEXT_EXEC_RETURN waits for the call to complete and returns its result
+/// - CONTEXT_EXEC_ASYNC queues a call that takes its arguments by value
+/// - CONTEXT_EXEC_ASYNC_COPY queues a call after copying the size bytes of ptr, which func refers to as copied
+/// - CONTEXT_TRACK records the client vertex array state that decides whether a draw may be queued
+#define CONTEXT_EXEC(func)          FUN_ENTRY(GL_LOG_INFO);                                             \
+                                    Context * context = GetCurrentContext();                            \
+                                    if (context) {                                                      \
+                                        CommandStream *stream = context->GetCommandStream();            \
+                                        if (stream) {                                                   \
+                                            stream->Execute([&]() { context->FlushPendingDraw();        \
+                                                                    context->func; });                  \
+                                        } else {                                                        \
+                                            context->FlushPendingDraw();                                \
+                                            context->func;                                              \
+                                        }                                                               \
                                     }
 
-#define CONTEXT_EXEC_RETURN(func)   FUN_ENTRY(GL_LOG_INFO);                      \
-                                    Context * context = GetCurrentContext();     \
-                                    return context ? context->func : 0;
+#define CONTEXT_EXEC_RETURN(func)   FUN_ENTRY(GL_LOG_INFO);                                             \
+                                    Context * context = GetCurrentContext();                            \
+                                    if (!context) {                                                     \
+                                        return 0;                                                       \
+                                    }                                                                   \
+                                    CommandStream *stream = context->GetCommandStream();                \
+                                    if (stream) {                                                       \
+                                        decltype(context->func) result{};                               \
+                                        stream->Execute([&]() { context->FlushPendingDraw();            \
+                                                                result = context->func; });             \
+                                        return result;                                                  \
+                                    }                                                                   \
+                                    context->FlushPendingDraw();                                        \
+                                    return context->func;
+
+#define CONTEXT_EXEC_ASYNC(func)    FUN_ENTRY(GL_LOG_INFO);                                             \
+                                    Context * context = GetCurrentContext();                            \
+                                    if (context) {                                                      \
+                                        CommandStream *stream = context->GetCommandStream();            \
+                                        if (stream) {                                                   \
+                                            stream->Enqueue([=]() { context->FlushPendingDraw();        \
+                                                                    context->func; });                  \
+                                        } else {                                                        \
+                                            context->FlushPendingDraw();                                \
+                                            context->func;                                              \
+                                        }                                                               \
+                                    }
+
+#define CONTEXT_EXEC_ASYNC_COPY(func, ptr, size)                                                        \
+                                    FUN_ENTRY(GL_LOG_INFO);                                             \
+                                    Context * context = GetCurrentContext();                            \
+                                    if (context) {                                                      \
+                                        CommandStream *stream = context->GetCommandStream();            \
+                                        if (stream) {                                                   \
+                                            CommandStream::data_t streamData = CommandStream::CopyData(ptr, size); \
+                                            stream->Enqueue([=]() {                                     \
+                                                auto copied = reinterpret_cast<decltype(ptr)>(streamData ? streamData->data() : nullptr); \
+                                                context->FlushPendingDraw();                            \
+                                                context->func; });                                      \
+                                        } else {                                                        \
+                                            auto copied = ptr;                                          \
+                                            context->FlushPendingDraw();                                \
+                                            context->func;                                              \
+                                        }                                                               \
+                                    }
+
+#define CONTEXT_TRACK(func)         {                                                                   \
+                                        Context * trackedContext = GetCurrentContext();                 \
+                                        if (trackedContext && trackedContext->GetCommandStream()) {     \
+                                            trackedContext->GetCommandStream()->func;                   \
+                                        }                                                               \
+                                    }
 
 void GL_APIENTRY
 glActiveTexture(GLenum texture)
 {
-    CONTEXT_EXEC(ActiveTexture(texture));
+    CONTEXT_EXEC_ASYNC(ActiveTexture(texture));
 }
 
 void GL_APIENTRY
 glAttachShader(GLuint program, GLuint shader)
 {
-    CONTEXT_EXEC(AttachShader(program, shader));
+    CONTEXT_EXEC_ASYNC(AttachShader(program, shader));
 }
 
 void GL_APIENTRY
@@ -54,61 +119,62 @@ glBindAttribLocation(GLuint program, GLuint index, const char* name)
 void GL_APIENTRY
 glBindBuffer(GLenum target, GLuint buffer)
 {
-    CONTEXT_EXEC(BindBuffer(target, buffer));
+    CONTEXT_TRACK(BindBuffer(target, buffer));
+    CONTEXT_EXEC_ASYNC(BindBuffer(target, buffer));
 }
 
 void GL_APIENTRY
 glBindFramebuffer(GLenum target, GLuint framebuffer)
 {
-    CONTEXT_EXEC(BindFramebuffer(target, framebuffer));
+    CONTEXT_EXEC_ASYNC(BindFramebuffer(target, framebuffer));
 }
 
 void GL_APIENTRY
 glBindRenderbuffer(GLenum target, GLuint renderbuffer)
 {
-    CONTEXT_EXEC(BindRenderbuffer(target, renderbuffer));
+    CONTEXT_EXEC_ASYNC(BindRenderbuffer(target, renderbuffer));
 }
 
 void GL_APIENTRY
 glBlendColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
 {
-    CONTEXT_EXEC(BlendColor(red, green, blue, alpha));
+    CONTEXT_EXEC_ASYNC(BlendColor(red, green, blue, alpha));
 }
 
 void GL_APIENTRY
 glBlendEquation(GLenum mode)
 {
-    CONTEXT_EXEC(BlendEquation(mode));
+    CONTEXT_EXEC_ASYNC(BlendEquation(mode));
 }
 
 void GL_APIENTRY
 glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
 {
-    CONTEXT_EXEC(BlendEquationSeparate(modeRGB, modeAlpha));
+    CONTEXT_EXEC_ASYNC(BlendEquationSeparate(modeRGB, modeAlpha));
 }
 
 void GL_APIENTRY
 glBlendFunc(GLenum sfactor, GLenum dfactor)
 {
-    CONTEXT_EXEC(BlendFunc(sfactor, dfactor));
+    CONTEXT_EXEC_ASYNC(BlendFunc(sfactor, dfactor));
 }
 
 void GL_APIENTRY
 glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
 {
-    CONTEXT_EXEC(BlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha));
+    CONTEXT_EXEC_ASYNC(BlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha));
 }
 
 void GL_APIENTRY
 glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
 {
-    CONTEXT_EXEC(BufferData(target, size, data, usage));
+    CONTEXT_EXEC_ASYNC_COPY(BufferData(target, size, copied, usage), data, size);
 }
 
 void GL_APIENTRY
 glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
 {
-    CONTEXT_EXEC(BufferSubData(target, offset, size, data));
+    CONTEXT_EXEC_ASYNC_COPY(BufferSubData(target, offset, size, copied), data, size);
 }
 
 GLenum GL_APIENTRY
@@ -120,61 +186,61 @@ glCheckFramebufferStatus(GLenum target)
 void GL_APIENTRY
 glClear(GLbitfield mask)
 {
-    CONTEXT_EXEC(Clear(mask));
+    CONTEXT_EXEC_ASYNC(Clear(mask));
 }
 
 void GL_APIENTRY
 glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
 {
-    CONTEXT_EXEC(ClearColor(red, green, blue, alpha));
+    CONTEXT_EXEC_ASYNC(ClearColor(red, green, blue, alpha));
 }
 
 void GL_APIENTRY
 glClearDepthf(GLclampf depth)
 {
-    CONTEXT_EXEC(ClearDepthf(depth));
+    CONTEXT_EXEC_ASYNC(ClearDepthf(depth));
 }
 
 void GL_APIENTRY
 glClearStencil(GLint s)
 {
-    CONTEXT_EXEC(ClearStencil(s));
+    CONTEXT_EXEC_ASYNC(ClearStencil(s));
 }
 
 void GL_APIENTRY
 glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
 {
-    CONTEXT_EXEC(ColorMask(red, green, blue, alpha));
+    CONTEXT_EXEC_ASYNC(ColorMask(red, green, blue, alpha));
 }
 
 void GL_APIENTRY
 glCompileShader(GLuint shader)
 {
-    CONTEXT_EXEC(CompileShader(shader));
+    CONTEXT_EXEC_ASYNC(CompileShader(shader));
 }
 
 void GL_APIENTRY
 glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
 {
-    CONTEXT_EXEC(CompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data));
+    CONTEXT_EXEC_ASYNC_COPY(CompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, copied), data, imageSize);
 }
 
 void GL_APIENTRY
 glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data)
 {
-    CONTEXT_EXEC(CompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data));
+    CONTEXT_EXEC_ASYNC_COPY(CompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, copied), data, imageSize);
 }
 
 void GL_APIENTRY
 glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)
 {
-    CONTEXT_EXEC(CopyTexImage2D(target, level, internalformat, x, y, width, height, border));
+    CONTEXT_EXEC_ASYNC(CopyTexImage2D(target, level, internalformat, x, y, width, height, border));
 }
 
 void GL_APIENTRY
 glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    CONTEXT_EXEC(CopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height));
+    CONTEXT_EXEC_ASYNC(CopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height));
 }
 
 GLuint GL_APIENTRY
@@ -192,103 +258,141 @@ glCreateShader(GLenum type)
 void GL_APIENTRY
 glCullFace(GLenum mode)
 {
-    CONTEXT_EXEC(CullFace(mode));
+    CONTEXT_EXEC_ASYNC(CullFace(mode));
 }
 
 void GL_APIENTRY
 glDeleteBuffers(GLsizei n, const GLuint* buffers)
 {
-    CONTEXT_EXEC(DeleteBuffers(n, buffers));
+    CONTEXT_TRACK(DeleteBuffers(n, buffers));
+    CONTEXT_EXEC_ASYNC_COPY(DeleteBuffers(n, copied), buffers, n * sizeof(GLuint));
 }
 
 void GL_APIENTRY
 glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
 {
-    CONTEXT_EXEC(DeleteFramebuffers(n, framebuffers));
+    CONTEXT_EXEC_ASYNC_COPY(DeleteFramebuffers(n, copied), framebuffers, n * sizeof(GLuint));
 }
 
 void GL_APIENTRY
 glDeleteProgram(GLuint program)
 {
-    CONTEXT_EXEC(DeleteProgram(program));
+    CONTEXT_EXEC_ASYNC(DeleteProgram(program));
 }
 
 void GL_APIENTRY
 glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
 {
-    CONTEXT_EXEC(DeleteRenderbuffers(n, renderbuffers));
+    CONTEXT_EXEC_ASYNC_COPY(DeleteRenderbuffers(n, copied), renderbuffers, n * sizeof(GLuint));
 }
 
 void GL_APIENTRY
 glDeleteShader(GLuint shader)
 {
-    CONTEXT_EXEC(DeleteShader(shader));
+    CONTEXT_EXEC_ASYNC(DeleteShader(shader));
 }
 
 void GL_APIENTRY
 glDeleteTextures(GLsizei n, const GLuint* textures)
 {
-    CONTEXT_EXEC(DeleteTextures(n, textures));
+    CONTEXT_EXEC_ASYNC_COPY(DeleteTextures(n, copied), textures, n * sizeof(GLuint));
 }
 
 void GL_APIENTRY
 glDepthFunc(GLenum func)
 {
-    CONTEXT_EXEC(DepthFunc(func));
+    CONTEXT_EXEC_ASYNC(DepthFunc(func));
 }
 
 void GL_APIENTRY
 glDepthMask(GLboolean flag)
 {
-    CONTEXT_EXEC(DepthMask(flag));
+    CONTEXT_EXEC_ASYNC(DepthMask(flag));
 }
 
 void GL_APIENTRY
 glDepthRangef(GLclampf zNear, GLclampf zFar)
 {
-    CONTEXT_EXEC(DepthRangef(zNear, zFar));
+    CONTEXT_EXEC_ASYNC(DepthRangef(zNear, zFar));
 }
 
 void GL_APIENTRY
 glDetachShader(GLuint program, GLuint shader)
 {
-    CONTEXT_EXEC(DetachShader(program, shader));
+    CONTEXT_EXEC_ASYNC(DetachShader(program, shader));
 }
 
 void GL_APIENTRY
 glDisable(GLenum cap)
 {
-    CONTEXT_EXEC(Disable(cap));
+    CONTEXT_EXEC_ASYNC(Disable(cap));
 }
 
 void GL_APIENTRY
 glDisableVertexAttribArray(GLuint index)
 {
-    CONTEXT_EXEC(DisableVertexAttribArray(index));
+    CONTEXT_TRACK(DisableVertexAttribArray(index));
+    CONTEXT_EXEC_ASYNC(DisableVertexAttribArray(index));
 }
 
 void GL_APIENTRY
 glDrawArrays(GLenum mode, GLint first, GLsizei count)
 {
-    CONTEXT_EXEC(DrawArrays(mode, first, count));
+    FUN_ENTRY(GL_LOG_INFO);
+
+    Context * context = GetCurrentContext();
+    if (!context) {
+        return;
+    }
+
+    // client-side arrays are read while the draw is translated
+    CommandStream *stream = context->GetCommandStream();
+    if (stream && !stream->ReadsClientArrays()) {
+        stream->Enqueue([=]() { context->DrawArrays(mode, first, count); });
+    } else if (stream) {
+        stream->Execute([&]() { context->DrawArrays(mode, first, count); });
+    } else {
+        context->DrawArrays(mode, first, count);
+    }
 }
 
 void GL_APIENTRY
 glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
 {
-    CONTEXT_EXEC(DrawElements(mode, count, type, indices));
+    FUN_ENTRY(GL_LOG_INFO);
+
+    Context * context = GetCurrentContext();
+    if (!context) {
+        return;
+    }
+
+    // client-side indices are copied into the queued draw, client-side arrays are read while the draw is translated
+    CommandStream *stream = context->GetCommandStream();
+    if (stream && !stream->ReadsClientArrays()) {
+        CommandStream::data_t streamData;
+        if(stream->ReadsClientIndices()) {
+            const size_t indexSize = type == GL_UNSIGNED_INT ? sizeof(GLuint) : type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLubyte);
+            streamData = CommandStream::CopyData(indices, count * indexSize);
+        }
+        stream->Enqueue([=]() { context->DrawElements(mode, count, type, streamData ? streamData->data() : indices); });
+    } else if (stream) {
+        stream->Execute([&]() { context->DrawElements(mode, count, type, indices); });
+    } else {
+        context->DrawElements(mode, count, type, indices);
+    }
 }
 
 void GL_APIENTRY
 glEnable(GLenum cap)
 {
-    CONTEXT_EXEC(Enable(cap));
+    CONTEXT_EXEC_ASYNC(Enable(cap));
 }
 
 void GL_APIENTRY
 glEnableVertexAttribArray(GLuint index)
 {
-    CONTEXT_EXEC(EnableVertexAttribArray(index));
+    CONTEXT_TRACK(EnableVertexAttribArray(index));
+    CONTEXT_EXEC_ASYNC(EnableVertexAttribArray(index));
 }
 
 void GL_APIENTRY
@@ -300,25 +404,25 @@ glFinish(void)
 void GL_APIENTRY
 glFlush(void)
 {
-    CONTEXT_EXEC(Flush());
+    CONTEXT_EXEC_ASYNC(Flush());
 }
 
 void GL_APIENTRY
 glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
-    CONTEXT_EXEC(FramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer));
+    CONTEXT_EXEC_ASYNC(FramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer));
 }
 
 void GL_APIENTRY
 glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
 {
-    CONTEXT_EXEC(FramebufferTexture2D(target, attachment, textarget, texture, level));
+    CONTEXT_EXEC_ASYNC(FramebufferTexture2D(target, attachment, textarget, texture, level));
 }
 
 void GL_APIENTRY
 glFrontFace(GLenum mode)
 {
-    CONTEXT_EXEC(FrontFace(mode));
+    CONTEXT_EXEC_ASYNC(FrontFace(mode));
 }
 
 void GL_APIENTRY
@@ -330,7 +434,7 @@ glGenBuffers(GLsizei n, GLuint* buffers)
 void GL_APIENTRY
 glGenerateMipmap(GLenum target)
 {
-    CONTEXT_EXEC(GenerateMipmap(target));
+    CONTEXT_EXEC_ASYNC(GenerateMipmap(target));
 }
 
 void GL_APIENTRY
@@ -348,7 +452,7 @@ glGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
 void GL_APIENTRY
 glBindTexture(GLenum target, GLuint texture)
 {
-    CONTEXT_EXEC(BindTexture(target, texture));
+    CONTEXT_EXEC_ASYNC(BindTexture(target, texture));
 }
 
 void GL_APIENTRY
@@ -516,7 +620,7 @@ glGetVertexAttribPointerv(GLuint index, GLenum pname, void** pointer)
 void GL_APIENTRY
 glHint(GLenum target, GLenum mode)
 {
-    CONTEXT_EXEC(Hint(target, mode));
+    CONTEXT_EXEC_ASYNC(Hint(target, mode));
 }
 
 GLboolean GL_APIENTRY
@@ -564,25 +668,25 @@ glIsTexture(GLuint texture)
 void GL_APIENTRY
 glLineWidth(GLfloat width)
 {
-    CONTEXT_EXEC(LineWidth(width));
+    CONTEXT_EXEC_ASYNC(LineWidth(width));
 }
 
 void GL_APIENTRY
 glLinkProgram(GLuint program)
 {
-    CONTEXT_EXEC(LinkProgram(program));
+    CONTEXT_EXEC_ASYNC(LinkProgram(program));
 }
 
 void GL_APIENTRY
 glPixelStorei(GLenum pname, GLint param)
 {
-    CONTEXT_EXEC(PixelStorei(pname, param));
+    CONTEXT_EXEC_ASYNC(PixelStorei(pname, param));
 }
 
 void GL_APIENTRY
 glPolygonOffset(GLfloat factor, GLfloat units)
 {
-    CONTEXT_EXEC(PolygonOffset(factor, units));
+    CONTEXT_EXEC_ASYNC(PolygonOffset(factor, units));
 }
 
 void GL_APIENTRY
@@ -594,25 +698,25 @@ glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLe
 void GL_APIENTRY
 glReleaseShaderCompiler(void)
 {
-    CONTEXT_EXEC(ReleaseShaderCompiler());
+    CONTEXT_EXEC_ASYNC(ReleaseShaderCompiler());
 }
 
 void GL_APIENTRY
 glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
 {
-    CONTEXT_EXEC(RenderbufferStorage(target, internalformat, width, height));
+    CONTEXT_EXEC_ASYNC(RenderbufferStorage(target, internalformat, width, height));
 }
 
 void GL_APIENTRY
 glSampleCoverage(GLclampf value, GLboolean invert)
 {
-    CONTEXT_EXEC(SampleCoverage(value, invert));
+    CONTEXT_EXEC_ASYNC(SampleCoverage(value, invert));
 }
 
 void GL_APIENTRY
 glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    CONTEXT_EXEC(Scissor(x, y, width, height));
+    CONTEXT_EXEC_ASYNC(Scissor(x, y, width, height));
 }
 
 void GL_APIENTRY
@@ -630,37 +734,37 @@ glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const
 void GL_APIENTRY
 glStencilFunc(GLenum func, GLint ref, GLuint mask)
 {
-    CONTEXT_EXEC(StencilFunc(func, ref, mask));
+    CONTEXT_EXEC_ASYNC(StencilFunc(func, ref, mask));
 }
 
 void GL_APIENTRY
 glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
 {
-    CONTEXT_EXEC(StencilFuncSeparate(face, func, ref, mask));
+    CONTEXT_EXEC_ASYNC(StencilFuncSeparate(face, func, ref, mask));
 }
 
 void GL_APIENTRY
 glStencilMask(GLuint mask)
 {
-    CONTEXT_EXEC(StencilMask(mask));
+    CONTEXT_EXEC_ASYNC(StencilMask(mask));
 }
 
 void GL_APIENTRY
 glStencilMaskSeparate(GLenum face, GLuint mask)
 {
-    CONTEXT_EXEC(StencilMaskSeparate(face, mask));
+    CONTEXT_EXEC_ASYNC(StencilMaskSeparate(face, mask));
 }
 
 void GL_APIENTRY
 glStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
 {
-    CONTEXT_EXEC(StencilOp(fail, zfail, zpass));
+    CONTEXT_EXEC_ASYNC(StencilOp(fail, zfail, zpass));
 }
 
 void GL_APIENTRY
 glStencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass)
 {
-    CONTEXT_EXEC(StencilOpSeparate(face, fail, zfail, zpass));
+    CONTEXT_EXEC_ASYNC(StencilOpSeparate(face, fail, zfail, zpass));
 }
 
 void GL_APIENTRY
@@ -672,7 +776,7 @@ glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GL
 void GL_APIENTRY
 glTexParameterf(GLenum target, GLenum pname, GLfloat param)
 {
-    CONTEXT_EXEC(TexParameterf(target, pname, param));
+    CONTEXT_EXEC_ASYNC(TexParameterf(target, pname, param));
 }
 
 void GL_APIENTRY
@@ -684,7 +788,7 @@ glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params)
 void GL_APIENTRY
 glTexParameteri(GLenum target, GLenum pname, GLint param)
 {
-    CONTEXT_EXEC(TexParameteri(target, pname, param));
+    CONTEXT_EXEC_ASYNC(TexParameteri(target, pname, param));
 }
 
 void GL_APIENTRY
@@ -702,187 +806,188 @@ glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsize
 void GL_APIENTRY
 glUniform1f(GLint location, GLfloat x)
 {
-    CONTEXT_EXEC(Uniform1f(location, x));
+    CONTEXT_EXEC_ASYNC(Uniform1f(location, x));
 }
 
 void GL_APIENTRY
 glUniform1fv(GLint location, GLsizei count, const GLfloat* v)
 {
-    CONTEXT_EXEC(Uniform1fv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform1fv(location, count, copied), v, count * 1 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUniform1i(GLint location, GLint x)
 {
-    CONTEXT_EXEC(Uniform1i(location, x));
+    CONTEXT_EXEC_ASYNC(Uniform1i(location, x));
 }
 
 void GL_APIENTRY
 glUniform1iv(GLint location, GLsizei count, const GLint* v)
 {
-    CONTEXT_EXEC(Uniform1iv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform1iv(location, count, copied), v, count * 1 * sizeof(GLint));
 }
 
 void GL_APIENTRY
 glUniform2f(GLint location, GLfloat x, GLfloat y)
 {
-    CONTEXT_EXEC(Uniform2f(location, x, y));
+    CONTEXT_EXEC_ASYNC(Uniform2f(location, x, y));
 }
 
 void GL_APIENTRY
 glUniform2fv(GLint location, GLsizei count, const GLfloat* v)
 {
-    CONTEXT_EXEC(Uniform2fv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform2fv(location, count, copied), v, count * 2 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUniform2i(GLint location, GLint x, GLint y)
 {
-    CONTEXT_EXEC(Uniform2i(location, x, y));
+    CONTEXT_EXEC_ASYNC(Uniform2i(location, x, y));
 }
 
 void GL_APIENTRY
 glUniform2iv(GLint location, GLsizei count, const GLint* v)
 {
-    CONTEXT_EXEC(Uniform2iv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform2iv(location, count, copied), v, count * 2 * sizeof(GLint));
 }
 
 void GL_APIENTRY
 glUniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
 {
-    CONTEXT_EXEC(Uniform3f(location, x, y, z));
+    CONTEXT_EXEC_ASYNC(Uniform3f(location, x, y, z));
 }
 
 void GL_APIENTRY
 glUniform3fv(GLint location, GLsizei count, const GLfloat* v)
 {
-    CONTEXT_EXEC(Uniform3fv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform3fv(location, count, copied), v, count * 3 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUniform3i(GLint location, GLint x, GLint y, GLint z)
 {
-    CONTEXT_EXEC(Uniform3i(location, x, y, z));
+    CONTEXT_EXEC_ASYNC(Uniform3i(location, x, y, z));
 }
 
 void GL_APIENTRY
 glUniform3iv(GLint location, GLsizei count, const GLint* v)
 {
-    CONTEXT_EXEC(Uniform3iv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform3iv(location, count, copied), v, count * 3 * sizeof(GLint));
 }
 
 void GL_APIENTRY
 glUniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 {
-    CONTEXT_EXEC(Uniform4f(location, x, y, z, w));
+    CONTEXT_EXEC_ASYNC(Uniform4f(location, x, y, z, w));
 }
 
 void GL_APIENTRY
 glUniform4fv(GLint location, GLsizei count, const GLfloat* v)
 {
-    CONTEXT_EXEC(Uniform4fv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform4fv(location, count, copied), v, count * 4 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUniform4i(GLint location, GLint x, GLint y, GLint z, GLint w)
 {
-    CONTEXT_EXEC(Uniform4i(location, x, y, z, w));
+    CONTEXT_EXEC_ASYNC(Uniform4i(location, x, y, z, w));
 }
 
 void GL_APIENTRY
 glUniform4iv(GLint location, GLsizei count, const GLint* v)
 {
-    CONTEXT_EXEC(Uniform4iv(location, count, v));
+    CONTEXT_EXEC_ASYNC_COPY(Uniform4iv(location, count, copied), v, count * 4 * sizeof(GLint));
 }
 
 void GL_APIENTRY
 glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
 {
-    CONTEXT_EXEC(UniformMatrix2fv(location, count, transpose, value));
+    CONTEXT_EXEC_ASYNC_COPY(UniformMatrix2fv(location, count, transpose, copied), value, count * 4 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
 {
-    CONTEXT_EXEC(UniformMatrix3fv(location, count, transpose, value));
+    CONTEXT_EXEC_ASYNC_COPY(UniformMatrix3fv(location, count, transpose, copied), value, count * 9 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
 {
-    CONTEXT_EXEC(UniformMatrix4fv(location, count, transpose, value));
+    CONTEXT_EXEC_ASYNC_COPY(UniformMatrix4fv(location, count, transpose, copied), value, count * 16 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glUseProgram(GLuint program)
 {
-    CONTEXT_EXEC(UseProgram(program));
+    CONTEXT_EXEC_ASYNC(UseProgram(program));
 }
 
 void GL_APIENTRY
 glValidateProgram(GLuint program)
 {
-    CONTEXT_EXEC(ValidateProgram(program));
+    CONTEXT_EXEC_ASYNC(ValidateProgram(program));
 }
 
 void GL_APIENTRY
 glVertexAttrib1f(GLuint indx, GLfloat x)
 {
-    CONTEXT_EXEC(VertexAttrib1f(indx, x));
+    CONTEXT_EXEC_ASYNC(VertexAttrib1f(indx, x));
 }
 
 void GL_APIENTRY
 glVertexAttrib1fv(GLuint indx, const GLfloat* values)
 {
-    CONTEXT_EXEC(VertexAttrib1fv(indx, values));
+    CONTEXT_EXEC_ASYNC_COPY(VertexAttrib1fv(indx, copied), values, 1 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glVertexAttrib2f(GLuint indx, GLfloat x, GLfloat y)
 {
-    CONTEXT_EXEC(VertexAttrib2f(indx, x, y));
+    CONTEXT_EXEC_ASYNC(VertexAttrib2f(indx, x, y));
 }
 
 void GL_APIENTRY
 glVertexAttrib2fv(GLuint indx, const GLfloat* values)
 {
-    CONTEXT_EXEC(VertexAttrib2fv(indx, values));
+    CONTEXT_EXEC_ASYNC_COPY(VertexAttrib2fv(indx, copied), values, 2 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glVertexAttrib3f(GLuint indx, GLfloat x, GLfloat y, GLfloat z)
 {
-    CONTEXT_EXEC(VertexAttrib3f(indx, x, y, z));
+    CONTEXT_EXEC_ASYNC(VertexAttrib3f(indx, x, y, z));
 }
 
 void GL_APIENTRY
 glVertexAttrib3fv(GLuint indx, const GLfloat* values)
 {
-    CONTEXT_EXEC(VertexAttrib3fv(indx, values));
+    CONTEXT_EXEC_ASYNC_COPY(VertexAttrib3fv(indx, copied), values, 3 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glVertexAttrib4f(GLuint indx, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 {
-    CONTEXT_EXEC(VertexAttrib4f(indx, x, y, z, w));
+    CONTEXT_EXEC_ASYNC(VertexAttrib4f(indx, x, y, z, w));
 }
 
 void GL_APIENTRY
 glVertexAttrib4fv(GLuint indx, const GLfloat* values)
 {
-    CONTEXT_EXEC(VertexAttrib4fv(indx, values));
+    CONTEXT_EXEC_ASYNC_COPY(VertexAttrib4fv(indx, copied), values, 4 * sizeof(GLfloat));
 }
 
 void GL_APIENTRY
 glVertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* ptr)
 {
-    CONTEXT_EXEC(VertexAttribPointer(indx, size, type, normalized, stride, ptr));
+    CONTEXT_TRACK(VertexAttribPointer(indx, size, type, normalized, stride, ptr));
+    CONTEXT_EXEC_ASYNC(VertexAttribPointer(indx, size, type, normalized, stride, ptr));
 }
 
 void GL_APIENTRY
 glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    CONTEXT_EXEC(Viewport(x, y, width, height));
+    CONTEXT_EXEC_ASYNC(Viewport(x, y, width, height));
 }
 
 void GL_APIENTRY
@@ -912,7 +1017,7 @@ glPushGroupMarkerEXT(GLsizei length, const GLchar *marker)
 void GL_APIENTRY
 glPopGroupMarkerEXT(void)
 {
-    CONTEXT_EXEC(PopGroupMarkerEXT());
+    CONTEXT_EXEC_ASYNC(PopGroupMarkerEXT());
 }
 
 void GL_APIENTRY glGetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary)
@@ -924,3 +1029,66 @@ void GL_APIENTRY glProgramBinaryOES(GLuint program, GLenum binaryFormat, const v
 {
     CONTEXT_EXEC(ProgramBinaryOES(program, binaryFormat, binary, length));
 }
+
+void GL_APIENTRY glRenderbufferStorageMultisampleEXT(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    CONTEXT_EXEC_ASYNC(RenderbufferStorageMultisampleEXT(target, samples, internalformat, width, height));
+}
+
+void GL_APIENTRY glFramebufferTexture2DMultisampleEXT(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples)
+{
+    CONTEXT_EXEC_ASYNC(FramebufferTexture2DMultisampleEXT(target, attachment, textarget, texture, level, samples));
+}
+
+void GL_APIENTRY glDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments)
+{
+    CONTEXT_EXEC_ASYNC_COPY(DiscardFramebufferEXT(target, numAttachments, copied), attachments, numAttachments * sizeof(GLenum));
+}
+
+void* GL_APIENTRY glMapBufferOES(GLenum target, GLenum access)
+{
+    CONTEXT_EXEC_RETURN(MapBufferOES(target, access));
+}
+
+GLboolean GL_APIENTRY glUnmapBufferOES(GLenum target)
+{
+    CONTEXT_EXEC_RETURN(UnmapBufferOES(target));
+}
+
+void GL_APIENTRY glGetBufferPointervOES(GLenum target, GLenum pname, void **params)
+{
+    CONTEXT_EXEC(GetBufferPointervOES(target, pname, params));
+}
+
+void* GL_APIENTRY glMapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    CONTEXT_EXEC_RETURN(MapBufferRangeEXT(target, offset, length, access));
+}
+
+void GL_APIENTRY glFlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    CONTEXT_EXEC(FlushMappedBufferRangeEXT(target, offset, length));
+}
+
+void GL_APIENTRY glBindVertexArrayOES(GLuint array)
+{
+    CONTEXT_TRACK(BindVertexArrayOES(array));
+    CONTEXT_EXEC_ASYNC(BindVertexArrayOES(array));
+}
+
+void GL_APIENTRY glDeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    CONTEXT_TRACK(DeleteVertexArraysOES(n, arrays));
+    CONTEXT_EXEC_ASYNC_COPY(DeleteVertexArraysOES(n, copied), arrays, n * sizeof(GLuint));
+}
+
+void GL_APIENTRY glGenVertexArraysOES(GLsizei n, GLuint *arrays)
+{
+    CONTEXT_EXEC(GenVertexArraysOES(n, arrays));
+    CONTEXT_TRACK(GenVertexArraysOES(n, arrays));
+}
+
+GLboolean GL_APIENTRY glIsVertexArrayOES(GLuint array)
+{
+    CONTEXT_EXEC_RETURN(IsVertexArrayOES(array));
+}
@@ -185,6 +185,28 @@ GL_FUNC_PTR(glPopGroupMarkerEXT)
 ,GL_FUNC_PTR(glGetProgramBinaryOES),
 GL_FUNC_PTR(glProgramBinaryOES)
 #endif /* GL_OES_get_program_binary */
+#ifdef GL_EXT_multisampled_render_to_texture
+,GL_FUNC_PTR(glRenderbufferStorageMultisampleEXT),
+GL_FUNC_PTR(glFramebufferTexture2DMultisampleEXT)
+#endif // GL_EXT_multisampled_render_to_texture
+#ifdef GL_EXT_discard_framebuffer
+,GL_FUNC_PTR(glDiscardFramebufferEXT)
+#endif // GL_EXT_discard_framebuffer
+#ifdef GL_OES_mapbuffer
+,GL_FUNC_PTR(glMapBufferOES),
+GL_FUNC_PTR(glUnmapBufferOES),
+GL_FUNC_PTR(glGetBufferPointervOES)
+#endif // GL_OES_mapbuffer
+#ifdef GL_EXT_map_buffer_range
+,GL_FUNC_PTR(glMapBufferRangeEXT),
+GL_FUNC_PTR(glFlushMappedBufferRangeEXT)
+#endif // GL_EXT_map_buffer_range
+#ifdef GL_OES_vertex_array_object
+,GL_FUNC_PTR(glBindVertexArrayOES),
+GL_FUNC_PTR(glDeleteVertexArraysOES),
+GL_FUNC_PTR(glGenVertexArraysOES),
+GL_FUNC_PTR(glIsVertexArrayOES)
+#endif // GL_OES_vertex_array_object
 };
 #undef GL_FUNC_PTR
 
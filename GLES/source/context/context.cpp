@@ -24,7 +24,8 @@
 #include "context.h"
 #include "utils/VkToGlConverter.h"
 
-static Context *currentContext = nullptr;
+// each thread may have its own context current, see eglMakeCurrent
+static thread_local Context *currentContext = nullptr;
 
 Context *GetCurrentContext()
 {
@@ -40,14 +41,20 @@ void SetCurrentContext(Context *ctx)
     currentContext = ctx;
 }
 
-Context::Context()
+Context::Context(Context *sharedContext)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
     mVkContext            = vulkanAPI::GetContext();
     mCommandBufferManager = new vulkanAPI::CommandBufferManager(mVkContext);
 
-    mResourceManager = new ResourceManager(mVkContext);
+    // contexts of the same share group share the resource manager
+    if(sharedContext != nullptr) {
+        mResourceManager = sharedContext->GetResourceManager();
+        mResourceManager->Share();
+    } else {
+        mResourceManager = new ResourceManager(mVkContext);
+    }
     mShaderCompiler  = new GlslangShaderCompiler();
     mPipeline        = new vulkanAPI::Pipeline(mVkContext);
     mCacheManager    = new CacheManager(mVkContext);
@@ -57,7 +64,12 @@ Context::Context()
     InitializeDefaultTextures();
 
     mPipeline->SetCacheManager(mCacheManager);
-    mResourceManager->SetCacheManager(mCacheManager);
+
+    // vertex array objects are container objects, so they are not shared
+    mDefaultVertexArray = new VertexArrayObject(mVkContext);
+    mDefaultVertexArray->SetCacheManager(mCacheManager);
+    mStateManager.GetActiveObjectsState()->SetActiveVertexArrayObject(mDefaultVertexArray);
+    mPipeline->SetVertexInputState(mDefaultVertexArray->GetVkPipelineVertexInput());
 
     mWriteSurface = nullptr;
     mReadSurface  = nullptr;
@@ -68,15 +80,41 @@ Context::Context()
     mIsYInverted        = !(vulkanAPI::GetContext()->mIsMaintenanceExtSupported);
     mIsModeLineLoop     = false;
 
+    mPendingDraw.secondaryCmdBuffer = nullptr;
+    mPendingDraw.fbo                = nullptr;
+
     mScreenSpacePass = new ScreenSpacePass(mVkContext);
     mScreenSpacePass->SetCacheManager(mCacheManager);
     mStateManager.InitVkPipelineStates(mScreenSpacePass->GetPipeline());
+
+    mClearPass = new vulkanAPI::ClearPass();
+
+    // the backend thread translates the GL calls of this context from now on
+    mCommandStream = nullptr;
+    if(GLOVE_ENABLE_DEFERRED_COMMAND_STREAM) {
+        mCommandStream = new CommandStream();
+        mCommandStream->Enqueue([this]() { SetCurrentContext(this); });
+    }
 }
 
 Context::~Context()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    // executes the commands still queued and stops the backend thread
+    if(mCommandStream != nullptr) {
+        delete mCommandStream;
+        mCommandStream = nullptr;
+    }
+
+    FlushPendingDraw();
+
+    for(auto &readback : mPendingReadbacks) {
+        mCommandBufferManager->WaitSubmitSerial(readback.submitSerial);
+        delete readback.stagingBuffer;
+    }
+    mPendingReadbacks.clear();
+
     ReleaseSystemFBO();
 
     if(mShaderCompiler != nullptr) {
@@ -84,7 +122,10 @@ Context::~Context()
         mShaderCompiler = nullptr;
     }
 
-    delete mResourceManager;
+    if(mResourceManager->Release()) {
+        delete mResourceManager;
+    }
+    delete mDefaultVertexArray;
     delete mCacheManager;
 
     if(mPipeline != nullptr) {
@@ -97,6 +138,11 @@ Context::~Context()
         mScreenSpacePass = nullptr;
     }
 
+    if(mClearPass != nullptr) {
+        delete mClearPass;
+        mClearPass = nullptr;
+    }
+
     delete mCommandBufferManager;
 }
 
@@ -105,6 +151,8 @@ Context::ReleaseSystemFBO(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    FlushPendingDraw();
+
     for(uint32_t i = 0; i < mSystemTextures.size(); ++i) {
         if(mSystemTextures[i] != nullptr) {
             delete mSystemTextures[i];
@@ -129,6 +177,32 @@ Context::ReleaseSystemFBO(void)
     mWriteFBO = nullptr;
 }
 
+uint64_t
+Context::CreateFenceSync(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the fence covers all commands issued so far, so they are submitted now and the
+    // fence maps onto the device-wide serial of that submission. It may be waited on
+    // from any thread, see CommandBufferManager::WaitDeviceSerial()
+    Flush();
+
+    return mCommandBufferManager->GetPendingDeviceSerial();
+}
+
+bool
+Context::ClientWaitFenceSync(uint64_t sync, uint64_t timeout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    bool signaled = false;
+    if(!mCommandBufferManager->WaitDeviceSerial(sync, timeout, &signaled)) {
+        return false;
+    }
+
+    return signaled;
+}
+
 void
 Context::InitializeDefaultTextures()
 {
@@ -196,6 +270,7 @@ Context::InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface)
     // depth/stencil images
     Texture *tex = CreateDepthStencil(eglSurfaceInterface);
     fbo->SetDepthStencilAttachmentTexture(tex);
+    fbo->SetSamples(FindSupportedSampleCount(mVkContext->vkGpus[0], eglSurfaceInterface->samples));
     fbo->SetTarget(GL_FRAMEBUFFER);
     fbo->SetIsSystem();
     fbo->SetEGLSurfaceInterface(eglSurfaceInterface);
@@ -220,6 +295,7 @@ Context::CreateDepthStencil(EGLSurfaceInterface *eglSurfaceInterface)
     tex->SetVkFormat(depthStencilFormat);
     tex->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
     tex->SetVkImageLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+    tex->SetVkImageSamples(FindSupportedSampleCount(mVkContext->vkGpus[0], eglSurfaceInterface->samples));
     tex->SetVkImageTiling();
     tex->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
 
@@ -275,6 +351,8 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
         return;
     }
 
+    FlushPendingDraw();
+
     FRAMEBUFFER_SURFACES_PAIR readWritePair = {eglReadSurfaceInterface, eglWriteSurfaceInterface};
 
     auto fboIter = mSystemFBOMap.find(readWritePair);
@@ -313,8 +391,7 @@ Context::SetSystemFramebuffer(Framebuffer *FBO)
 
     mStateManager.GetViewportTransformationState()->SetViewportRect(mSystemFBO->GetRect());
     mStateManager.GetFragmentOperationsState()->SetScissorRect(mSystemFBO->GetRect());
-    mPipeline->SetUpdatePipeline(true);
-    mPipeline->SetUpdateViewportState(true);
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_ALL);
 }
 
 void
@@ -27,9 +27,11 @@
 #include "utils/glUtils.h"
 #include "utils/glLogger.h"
 #include "utils/cacheManager.h"
+#include "utils/commandStream.h"
 #include "glslang/glslangShaderCompiler.h"
 #include "state/stateManager.h"
 #include "resources/resourceManager.h"
+#include "resources/vertexArrayObject.h"
 #include "vulkan/pipeline.h"
 #include "vulkan/clearPass.h"
 #include "resources/screenSpacePass.h"
@@ -37,6 +39,7 @@
 #include "rendering_api_interface.h"
 #include <utility>
 #include <map>
+#include <list>
 
 typedef enum {
     GLOVE_HOST_X86_BINARY = 1,
@@ -59,7 +62,12 @@ private:
     ShaderCompiler                             *mShaderCompiler;
     vulkanAPI::Pipeline                        *mPipeline;
     ScreenSpacePass                            *mScreenSpacePass;
+    vulkanAPI::ClearPass                       *mClearPass;
     vulkanAPI::CommandBufferManager            *mCommandBufferManager;
+    CommandStream                              *mCommandStream;
+// ------------
+    ObjectArray<VertexArrayObject>              mVertexArrays;
+    VertexArrayObject                          *mDefaultVertexArray;
 // ------------
     bool                                        mIsYInverted;
     bool                                        mIsModeLineLoop;
@@ -75,10 +83,42 @@ private:
     typedef std::pair<EGLSurfaceInterface*, EGLSurfaceInterface*> FRAMEBUFFER_SURFACES_PAIR;
     std::map<FRAMEBUFFER_SURFACES_PAIR, Framebuffer*> mSystemFBOMap;
 
+    typedef struct pendingReadback_t {
+        BufferObject                           *packBuffer;
+        size_t                                  packOffset;
+        BufferObject                           *stagingBuffer;
+        ImageRect                               srcRect;
+        ImageRect                               dstRect;
+        GLenum                                  srcFormat;
+        GLenum                                  dstFormat;
+        uint64_t                                submitSerial;
+    } pendingReadback_t;
+    std::list<pendingReadback_t>                mPendingReadbacks;
+
+    typedef struct drawRange_t {
+        uint32_t                                first;
+        uint32_t                                count;
+    } drawRange_t;
+
+    typedef struct pendingDraw_t {
+        VkCommandBuffer                        *secondaryCmdBuffer;
+        Framebuffer                            *fbo;
+        GLenum                                  mode;
+        bool                                    indexed;
+        GLenum                                  type;
+        uint32_t                                indexOffset;
+        bool                                    coalescable;
+        std::vector<drawRange_t>                ranges;
+    } pendingDraw_t;
+    pendingDraw_t                               mPendingDraw;
+
 // ------------
 
     Shader        *GetShaderPtr(GLuint shader);
     ShaderProgram *GetProgramPtr(GLuint program);
+    VertexArrayObject *GetVertexArray(GLuint array);
+    uint32_t       GetVertexArrayId(const VertexArrayObject *vao);
+    void           DetachElementArrayBuffer(BufferObject *bo);
 
     Framebuffer   *CreateFBOFromEGLSurface(EGLSurfaceInterface *eglSurfaceInterface);
     Framebuffer   *InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface);
@@ -87,7 +127,10 @@ private:
     void           PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
     void           CreateShaderCompiler(void);
     void           ClearSimple(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
-    void           ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
+    void           ClearWithMasks(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
+    void           ClearAttachments(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
+    bool           ClearRectCoversFramebuffer(void) const;
+    void           FramebufferTexture2DSamples(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples);
 
     void UpdateViewportState(vulkanAPI::Pipeline* pipeline);
     void BeginRendering(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
@@ -97,11 +140,18 @@ private:
     void BindUniformDescriptors(VkCommandBuffer *CmdBuffer);
     void BindVertexBuffers(VkCommandBuffer *CmdBuffer);
     void BindIndexBuffer(VkCommandBuffer *CmdBuffer, uint32_t offset, VkIndexType type);
-    void DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount);
+    void DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t first, uint32_t vertCount);
+    bool IsDrawCoalescable(bool indexed, GLenum type);
+    bool AppendPendingDraw(GLenum mode, uint32_t first, uint32_t count, bool indexed, GLenum type, const void *indices);
     void SetCapability(GLenum cap, GLboolean enable);
 
     void InitializeDefaultTextures(void);
 
+    void ReadPixelsToPackBuffer(Texture *texture, const ImageRect *srcRect, const ImageRect *dstRect, GLenum dstFormat, BufferObject *packBuffer, size_t packOffset);
+    void ResolvePendingReadbacks(const BufferObject *packBuffer, bool wait);
+    void DiscardPendingReadbacks(const BufferObject *packBuffer);
+    void *MapBufferObject(GLenum target, BufferObject *bo, size_t offset, size_t length, GLbitfield access);
+
     void SetClearRect(void);
     bool SetPipelineProgramShaderStages(ShaderProgram *progPtr);
     void SetSystemFramebuffer(Framebuffer *FBO);
@@ -112,19 +162,24 @@ private:
 
 // Is/Has Functions
     inline bool             IsDrawModeTriangle(GLenum mode)                const { FUN_ENTRY(GL_LOG_TRACE); return (mode == GL_TRIANGLE_STRIP || mode  == GL_TRIANGLE_FAN || mode == GL_TRIANGLES); }
+    inline bool             IsValidBufferTarget(GLenum target)             const { FUN_ENTRY(GL_LOG_TRACE); return (target == GL_ARRAY_BUFFER || target == GL_ELEMENT_ARRAY_BUFFER || target == GL_PIXEL_PACK_BUFFER_NV); }
 // Other Functions
     inline void             RecordError(GLenum error)                            { FUN_ENTRY(GL_LOG_TRACE); if (mStateManager.GetError() == GL_NO_ERROR) { mStateManager.SetError(error); } }
 
 public:
-    Context();
+    Context(Context *sharedContext = nullptr);
     ~Context();
 
     static void             DestroyAPISurfaceData(const vulkanAPI::vkContext_t *vkContext, EGLSurfaceInterface *eglSurfaceInterface);
 
     void                    ReleaseSystemFBO(void);
+    uint64_t                CreateFenceSync(void);
+    bool                    ClientWaitFenceSync(uint64_t sync, uint64_t timeout);
+    void                    FlushPendingDraw(void);
 
 // Get Functions
     inline  vulkanAPI::CommandBufferManager *GetVkCommandBufferManager(void)      { FUN_ENTRY(GL_LOG_TRACE); return mCommandBufferManager; }
+    inline  CommandStream   *GetCommandStream(void)                               { FUN_ENTRY(GL_LOG_TRACE); return mCommandStream; }
     inline  StateManager    *GetStateManager(void)                                { FUN_ENTRY(GL_LOG_TRACE); return &mStateManager; }
     inline  ResourceManager *GetResourceManager(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mResourceManager; }
     inline  bool            IsYInverted(void)                              const  { FUN_ENTRY(GL_LOG_TRACE); return mIsYInverted; }
@@ -175,6 +230,7 @@ public:
     void            DepthMask(GLboolean flag);
     void            DepthRangef(GLclampf zNear, GLclampf zFar);
     void            DetachShader(GLuint program, GLuint shader);
+    void            DiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments);
     void            Disable(GLenum cap);
     void            DisableVertexAttribArray(GLuint index);
     void            DrawArrays(GLenum mode, GLint first, GLsizei count);
@@ -182,9 +238,11 @@ public:
     void            Enable(GLenum cap);
     void            EnableVertexAttribArray(GLuint index);
     void            Finish(void);
+    void            FinishFrame(void);
     bool            Flush(void);
     void            FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
     void            FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+    void            FramebufferTexture2DMultisampleEXT(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples);
     void            FrontFace(GLenum mode);
     void            GenBuffers(GLsizei n, GLuint* buffers);
     void            GenerateMipmap(GLenum target);
@@ -232,6 +290,7 @@ public:
     void            ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
     void            ReleaseShaderCompiler(void);
     void            RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+    void            RenderbufferStorageMultisampleEXT(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height);
     void            SampleCoverage(GLclampf value, GLboolean invert);
     void            Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
     void            ShaderBinary(GLsizei n, const GLuint* shaders, GLenum binaryformat, const void* binary, GLsizei length);
@@ -288,6 +347,15 @@ public:
     void            PopGroupMarkerEXT(void);
     void            GetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
     void            ProgramBinaryOES(GLuint program, GLenum binaryFormat, const void *binary, GLint length);
+    void*           MapBufferOES(GLenum target, GLenum access);
+    GLboolean       UnmapBufferOES(GLenum target);
+    void            GetBufferPointervOES(GLenum target, GLenum pname, void **params);
+    void*           MapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    void            FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length);
+    void            BindVertexArrayOES(GLuint array);
+    void            DeleteVertexArraysOES(GLsizei n, const GLuint *arrays);
+    void            GenVertexArraysOES(GLsizei n, GLuint *arrays);
+    GLboolean       IsVertexArrayOES(GLuint array);
 
 };
 
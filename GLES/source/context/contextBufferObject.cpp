@@ -28,7 +28,7 @@ Context::BindBuffer(GLenum target, GLuint buffer)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(!IsValidBufferTarget(target)) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -36,6 +36,10 @@ Context::BindBuffer(GLenum target, GLuint buffer)
     BufferObject *bo = nullptr;
     if(buffer) {
         bo = mResourceManager->GetBuffer(buffer);
+        if(target != GL_PIXEL_PACK_BUFFER_NV) {
+            // the buffer is about to be sourced by draws, any readback into it must land first
+            ResolvePendingReadbacks(bo, true);
+        }
         bo->SetTarget(target);
         bo->SetVkContext(mVkContext);
         bo->Bind();
@@ -50,7 +54,7 @@ Context::BindBuffer(GLenum target, GLuint buffer)
     mStateManager.GetActiveObjectsState()->SetActiveBufferObject(target, bo);
 
     if(target == GL_ELEMENT_ARRAY_BUFFER || (bo && bo->IsIndexBuffer())) {
-        mPipeline->SetUpdateIndexBuffer(true);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
     }
 }
 
@@ -59,7 +63,7 @@ Context::BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usa
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(!IsValidBufferTarget(target)) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -80,6 +84,9 @@ Context::BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usa
         return;
     }
 
+    // the previous contents are replaced, drop any readback still targeting them
+    DiscardPendingReadbacks(bo);
+
     bo->SetUsage(usage);
     if((data && bo->HasData()) || (data == nullptr && bo->GetSize() && (size_t)size != bo->GetSize())) {
         bo->Release();
@@ -91,7 +98,7 @@ Context::BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usa
     }
 
     if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
-        mPipeline->SetUpdateIndexBuffer(true);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
     }
 }
 
@@ -100,7 +107,7 @@ Context::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const vo
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(!IsValidBufferTarget(target)) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -116,10 +123,11 @@ Context::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const vo
         return;
     }
 
+    ResolvePendingReadbacks(bo, true);
     bo->UpdateData(size, offset, data);
 
     if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
-        mPipeline->SetUpdateIndexBuffer(true);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
     }
 }
 
@@ -148,10 +156,18 @@ Context::DeleteBuffers(GLsizei n, const GLuint* buffers)
 
             BufferObject *buf = mResourceManager->GetBuffer(buffer);
 
+            DiscardPendingReadbacks(buf);
+
             if(mStateManager.GetActiveObjectsState()->EqualsActiveBufferObject(buf)) {
                 buf->Unbind();
                 mStateManager.GetActiveObjectsState()->ResetActiveBufferObject(buf->GetTarget());
             }
+            if(buf->GetTarget() != GL_PIXEL_PACK_BUFFER_NV &&
+               mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) == buf) {
+                buf->Unbind();
+                mStateManager.GetActiveObjectsState()->ResetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV);
+            }
+            DetachElementArrayBuffer(buf);
             mResourceManager->AddToPurgeList(buf);
             mResourceManager->RemoveFromListBuffer(buffer);
         }
@@ -164,12 +180,12 @@ Context::GetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(!IsValidBufferTarget(target)) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
 
-    if(pname != GL_BUFFER_SIZE && pname != GL_BUFFER_USAGE) {
+    if(pname != GL_BUFFER_SIZE && pname != GL_BUFFER_USAGE && pname != GL_BUFFER_ACCESS_OES && pname != GL_BUFFER_MAPPED_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -183,6 +199,8 @@ Context::GetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
     switch(pname) {
     case GL_BUFFER_SIZE:  *params = static_cast<GLint>(bo->GetSize());  break;
     case GL_BUFFER_USAGE: *params = static_cast<GLint>(bo->GetUsage()); break;
+    case GL_BUFFER_ACCESS_OES: *params = GL_WRITE_ONLY_OES; break;
+    case GL_BUFFER_MAPPED_OES: *params = bo->IsMapped() ? GL_TRUE : GL_FALSE; break;
     }
 }
 
@@ -213,3 +231,178 @@ Context::IsBuffer(GLuint buffer)
 
     return (buffer != 0 && mResourceManager->BufferExists(buffer)) ? GL_TRUE : GL_FALSE;
 }
+
+void *
+Context::MapBufferObject(GLenum target, BufferObject *bo, size_t offset, size_t length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    bool invalidate = (access & GL_MAP_INVALIDATE_BUFFER_BIT_EXT) ||
+                      ((access & GL_MAP_INVALIDATE_RANGE_BIT_EXT) && offset == 0 && length == bo->GetSize());
+
+    if(invalidate && !(access & GL_MAP_UNSYNCHRONIZED_BIT_EXT)) {
+        // the previous contents are not needed, so instead of waiting for the GPU
+        // to stop reading them, the buffer continues with fresh storage
+        DiscardPendingReadbacks(bo);
+        bo->ReleaseRetiredStorage();
+
+        if(!bo->Orphan(mCommandBufferManager->GetPendingDeviceSerial())) {
+            RecordError(GL_OUT_OF_MEMORY);
+            return nullptr;
+        }
+    } else if(access & GL_MAP_UNSYNCHRONIZED_BIT_EXT) {
+        // nothing is waited for, the application orders its writes against pending
+        // GPU work itself. Invalidated contents drop their pending readbacks, which
+        // does not block
+        if(invalidate) {
+            DiscardPendingReadbacks(bo);
+        }
+    } else {
+        // a readback landing later would overwrite the application's writes
+        ResolvePendingReadbacks(bo, true);
+
+        if(mWriteFBO->IsInDrawState()) {
+            Finish();
+        } else {
+            mCommandBufferManager->WaitLastSubmition();
+        }
+    }
+
+    void *ptr = bo->Map(offset, length, access);
+    if(ptr == nullptr) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return nullptr;
+    }
+
+    if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
+    }
+
+    return ptr;
+}
+
+void *
+Context::MapBufferOES(GLenum target, GLenum access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!IsValidBufferTarget(target) || access != GL_WRITE_ONLY_OES) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->HasData() || bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    return MapBufferObject(target, bo, 0, bo->GetSize(), GL_MAP_WRITE_BIT_EXT);
+}
+
+GLboolean
+Context::UnmapBufferOES(GLenum target)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!IsValidBufferTarget(target)) {
+        RecordError(GL_INVALID_ENUM);
+        return GL_FALSE;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return GL_FALSE;
+    }
+
+    if(!bo->Unmap()) {
+        return GL_FALSE;
+    }
+
+    if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
+    }
+
+    return GL_TRUE;
+}
+
+void
+Context::GetBufferPointervOES(GLenum target, GLenum pname, void **params)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!IsValidBufferTarget(target) || pname != GL_BUFFER_MAP_POINTER_OES) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    *params = bo->GetMapPointer();
+}
+
+void *
+Context::MapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!IsValidBufferTarget(target)) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    const GLbitfield validAccess = GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT |
+                                   GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT |
+                                   GL_MAP_FLUSH_EXPLICIT_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT;
+
+    if(offset < 0 || length < 0 || (size_t)offset + (size_t)length > bo->GetSize() || (access & ~validAccess)) {
+        RecordError(GL_INVALID_VALUE);
+        return nullptr;
+    }
+
+    if(!(access & (GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT)) ||
+       ((access & GL_MAP_READ_BIT_EXT) && (access & (GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT))) ||
+       ((access & GL_MAP_FLUSH_EXPLICIT_BIT_EXT) && !(access & GL_MAP_WRITE_BIT_EXT)) ||
+       length == 0 || !bo->HasData() || bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    return MapBufferObject(target, bo, offset, length, access);
+}
+
+void
+Context::FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!IsValidBufferTarget(target)) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->IsMapped() || !(bo->GetMapAccess() & GL_MAP_FLUSH_EXPLICIT_BIT_EXT)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    // the range is relative to the mapped range
+    if(offset < 0 || length < 0 || (size_t)offset + (size_t)length > bo->GetMapLength()) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    bo->FlushMappedRange(static_cast<size_t>(offset), static_cast<size_t>(length));
+}
@@ -55,8 +55,7 @@ Context::BindFramebuffer(GLenum target, GLuint framebuffer)
     mWriteFBO->SetStateIdle();
 
     mStateManager.GetActiveObjectsState()->SetActiveFramebufferObjectID(framebuffer);
-    mPipeline->SetUpdatePipeline(true);
-    mPipeline->SetUpdateViewportState(true);
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_RENDER_PASS | vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR | vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
 }
 
 GLenum
@@ -109,8 +108,7 @@ Context::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
                 mWriteFBO->SetStateIdle();
 
                 mStateManager.GetActiveObjectsState()->SetActiveFramebufferObjectID(0);
-                mPipeline->SetUpdatePipeline(true);
-                mPipeline->SetUpdateViewportState(true);
+                mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_RENDER_PASS | vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR | vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
             }
 
             mResourceManager->DeallocateFramebuffer(fboindex);
@@ -119,6 +117,46 @@ Context::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
     mResourceManager->CleanPurgeList();
 }
 
+void
+Context::DiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_FRAMEBUFFER) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    if(numAttachments < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(attachments == nullptr) {
+        return;
+    }
+
+    bool isSystem = (mWriteFBO == mSystemFBO);
+    bool color    = false;
+    bool depth    = false;
+    bool stencil  = false;
+    for(GLsizei i = 0; i < numAttachments; ++i) {
+        switch(attachments[i]) {
+        case GL_COLOR_EXT:              if(!isSystem) { RecordError(GL_INVALID_ENUM); return; } color   = true; break;
+        case GL_DEPTH_EXT:              if(!isSystem) { RecordError(GL_INVALID_ENUM); return; } depth   = true; break;
+        case GL_STENCIL_EXT:            if(!isSystem) { RecordError(GL_INVALID_ENUM); return; } stencil = true; break;
+        case GL_COLOR_ATTACHMENT0:      if( isSystem) { RecordError(GL_INVALID_ENUM); return; } color   = true; break;
+        case GL_DEPTH_ATTACHMENT:       if( isSystem) { RecordError(GL_INVALID_ENUM); return; } depth   = true; break;
+        case GL_STENCIL_ATTACHMENT:     if( isSystem) { RecordError(GL_INVALID_ENUM); return; } stencil = true; break;
+        default:                        RecordError(GL_INVALID_ENUM); return;
+        }
+    }
+
+    // the hint is applied to the store operations of the current render pass
+    // instance and to the load operations of the next one
+    mWriteFBO->DiscardAttachments(color, depth, stencil);
+}
+
 void
 Context::FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
@@ -161,7 +199,7 @@ Context::FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum render
         mWriteFBO->SetColorAttachment(width, height);
         mWriteFBO->SetColorAttachmentType(renderbuffer ? GL_RENDERBUFFER : GL_NONE);
         mWriteFBO->SetColorAttachmentName(renderbuffer);
-        mPipeline->SetUpdateViewportState(true);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR);
         break; }
     case GL_DEPTH_ATTACHMENT:
         mWriteFBO->SetDepthAttachmentType(renderbuffer ? GL_RENDERBUFFER : GL_NONE);
@@ -180,6 +218,34 @@ Context::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    FramebufferTexture2DSamples(target, attachment, textarget, texture, level, 0);
+}
+
+void
+Context::FramebufferTexture2DMultisampleEXT(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(attachment != GL_COLOR_ATTACHMENT0) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    if(samples < 0 || samples > static_cast<GLsizei>(GetMaxSupportedSampleCount(mVkContext->vkGpus[0]))) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    // the texture may be rendered with more samples than requested, as reported by GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_SAMPLES_EXT
+    FramebufferTexture2DSamples(target, attachment, textarget, texture, level,
+                                samples ? static_cast<GLsizei>(FindSupportedSampleCount(mVkContext->vkGpus[0], samples)) : 0);
+}
+
+void
+Context::FramebufferTexture2DSamples(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLsizei samples)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
     if(target != GL_FRAMEBUFFER) {
         RecordError(GL_INVALID_ENUM);
         return;
@@ -217,7 +283,7 @@ Context::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget
         return;
     }
 
-    if(texture && texture != mWriteFBO->GetAttachmentName(attachment) && mWriteFBO->IsInDrawState()) {
+    if(texture && (texture != mWriteFBO->GetAttachmentName(attachment) || samples != mWriteFBO->GetAttachmentSamples(attachment)) && mWriteFBO->IsInDrawState()) {
         Finish();
     }
 
@@ -226,6 +292,9 @@ Context::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget
     mWriteFBO->CleanCachedAttachment(attachment);
     mResourceManager->CleanPurgeList();
 
+    // a sampled texture that becomes a render target has to be revalidated at the next draw
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
+
     switch(attachment) {
     case GL_COLOR_ATTACHMENT0: {
         int width  = texture ? mResourceManager->GetTexture(texture)->GetWidth()  : -1;
@@ -235,7 +304,8 @@ Context::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget
         mWriteFBO->SetColorAttachmentName(texture);
         mWriteFBO->SetColorAttachmentLayer(texture && mResourceManager->GetTexture(texture)->IsCubeMap() ? textarget : 0);
         mWriteFBO->SetColorAttachmentLevel(0);
-        mPipeline->SetUpdateViewportState(true);
+        mWriteFBO->SetColorAttachmentSamples(texture ? samples : 0);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR);
         break; }
     case GL_DEPTH_ATTACHMENT:
         mWriteFBO->SetDepthAttachmentType(texture ? GL_TEXTURE : GL_NONE);
@@ -296,13 +366,16 @@ Context::GetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, G
     GLint  level = 0;
     GLenum layer = GL_TEXTURE_CUBE_MAP_POSITIVE_X;
 
+    GLsizei samples = 0;
+
     switch(attachment) {
     case GL_COLOR_ATTACHMENT0:
         type  = fbo->GetColorAttachmentType();
         name  = fbo->GetColorAttachmentName();
         if(type == GL_TEXTURE) {
-            level = fbo->GetColorAttachmentLevel();
-            layer = fbo->GetColorAttachmentLayer();
+            level   = fbo->GetColorAttachmentLevel();
+            layer   = fbo->GetColorAttachmentLayer();
+            samples = fbo->GetAttachmentSamples(attachment);
         }
         break;
     case GL_DEPTH_ATTACHMENT:
@@ -339,7 +412,8 @@ Context::GetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, G
 
     if(type == GL_TEXTURE &&
       (pname != GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE   && pname != GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME        &&
-       pname != GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL && pname != GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE)
+       pname != GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL && pname != GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE &&
+       pname != GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_SAMPLES_EXT)
       ) {
         RecordError(GL_INVALID_ENUM);
         return;
@@ -350,6 +424,7 @@ Context::GetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, G
     case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME:             *params = static_cast<GLint>(name);   break;
     case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL:           *params = level;                      break;
     case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE:   *params = static_cast<GLint>(layer);  break;
+    case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_SAMPLES_EXT:     *params = samples;                    break;
     }
 }
 
@@ -175,6 +175,7 @@ Context::GetRenderbufferParameteriv(GLenum target, GLenum pname, GLint* params)
     case GL_RENDERBUFFER_ALPHA_SIZE:        GlFormatToStorageBits(activeRenderbuffer->GetInternalFormat(), nullptr, nullptr, nullptr, params, nullptr, nullptr); break;
     case GL_RENDERBUFFER_DEPTH_SIZE:        GlFormatToStorageBits(activeRenderbuffer->GetInternalFormat(), nullptr, nullptr, nullptr, nullptr, params, nullptr); break;
     case GL_RENDERBUFFER_STENCIL_SIZE:      GlFormatToStorageBits(activeRenderbuffer->GetInternalFormat(), nullptr, nullptr, nullptr, nullptr, nullptr, params); break;
+    case GL_RENDERBUFFER_SAMPLES_EXT:       *params = activeRenderbuffer->GetSamples(); break;
     default:                                RecordError(GL_INVALID_ENUM); break;
     }
 }
@@ -192,6 +193,14 @@ Context::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    RenderbufferStorageMultisampleEXT(target, 0, internalformat, width, height);
+}
+
+void
+Context::RenderbufferStorageMultisampleEXT(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
     if(target != GL_RENDERBUFFER) {
         RecordError(GL_INVALID_ENUM);
         return;
@@ -202,6 +211,11 @@ Context::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width
         return;
     }
 
+    if(samples < 0 || samples > static_cast<GLsizei>(GetMaxSupportedSampleCount(mVkContext->vkGpus[0]))) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
     if(internalformat != GL_RGB8_OES          && internalformat != GL_RGBA8_OES &&
        internalformat != GL_RGBA4             && internalformat != GL_RGB565 && internalformat != GL_RGB5_A1 &&
        internalformat != GL_DEPTH_COMPONENT16 && internalformat != GL_DEPTH_COMPONENT24_OES && internalformat != GL_DEPTH_COMPONENT32_OES &&
@@ -227,9 +241,18 @@ Context::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width
         Finish();
     }
 
+    // the storage may use more samples than requested, as reported by GL_RENDERBUFFER_SAMPLES_EXT
+    GLsizei allocatedSamples = samples ? static_cast<GLsizei>(FindSupportedSampleCount(mVkContext->vkGpus[0], samples)) : 0;
+
     Renderbuffer* activeRenderbuffer = mResourceManager->GetRenderbuffer(activeRenderbufferId);
-    if(!activeRenderbuffer->Allocate(width, height, internalformat)) {
+    if(!activeRenderbuffer->Allocate(width, height, internalformat, allocatedSamples)) {
         RecordError(GL_OUT_OF_MEMORY);
         return;
     }
+
+    if((activeRenderbufferId == mWriteFBO->GetColorAttachmentName()   && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType())    ||
+       (activeRenderbufferId == mWriteFBO->GetDepthAttachmentName()   && GL_RENDERBUFFER == mWriteFBO->GetDepthAttachmentType())    ||
+       (activeRenderbufferId == mWriteFBO->GetStencilAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetStencilAttachmentType())) {
+        mWriteFBO->SetUpdated();
+    }
 }
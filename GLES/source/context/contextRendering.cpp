@@ -41,12 +41,9 @@ Context::PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool
     GLfloat clearDepthValue    = clearDepthEnabled   ? stateFramebufferOperations->GetClearDepth() : 0.0f;
     uint32_t clearStencilValue = clearStencilEnabled ? stateFramebufferOperations->GetClearStencilMasked() : 0u;
 
-    // Update stencil buffer with mask
-    if(clearStencilEnabled && stateFramebufferOperations->StencilMaskActive()) {
-        mWriteFBO->UpdateClearDepthStencilTexture(clearStencilValue, stateFramebufferOperations->GetStencilMaskFront(), mClearRect);
-        clearStencilValue = 0;
-        clearStencilEnabled = false;
-    }
+    // the render area spans the whole framebuffer so that later draws and
+    // scissored clears recorded in the same render pass instance stay inside it
+    const Rect renderArea(0, 0, mWriteFBO->GetWidth(), mWriteFBO->GetHeight());
 
     // perform a screen-space pass
     mWriteFBO->CreateRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
@@ -54,9 +51,7 @@ Context::PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool
                                 stateFramebufferOperations->IsDepthWriteEnabled(),
                                 stateFramebufferOperations->IsStencilWriteEnabled(),
                                  clearColorValue, clearDepthValue, clearStencilValue,
-                                 &mClearRect);
-    mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-    mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+                                 &renderArea);
 }
 
 void
@@ -85,12 +80,19 @@ Context::Clear(GLbitfield mask)
 
     SetClearRect();
 
-    // color masks are executed implicitly through a screen-space pass (i.e., need an explicit VkPipeline object)
-    bool performCustomClear = (mStateManager.GetFramebufferOperationsState()->ColorMaskActive() && clearColorEnabled);
+    // an empty scissor intersection clears nothing, and Vulkan rejects zero-sized clear rects and viewports
+    if(mClearRect.width <= 0 || mClearRect.height <= 0) {
+        return;
+    }
+
+    // color and stencil masks are executed implicitly through a screen-space pass (i.e., need an explicit VkPipeline object)
+    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
+    bool performCustomClear = (stateFramebufferOperations->ColorMaskActive()   && clearColorEnabled) ||
+                              (stateFramebufferOperations->StencilMaskActive() && clearStencilEnabled);
     if(!performCustomClear) {
         ClearSimple(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
     } else {
-        ClearWithColorMask(false, clearDepthEnabled, clearStencilEnabled);
+        ClearWithMasks(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
     }
 }
 
@@ -99,16 +101,83 @@ Context::ClearSimple(bool clearColorEnabled, bool clearDepthEnabled, bool clearS
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mWriteFBO->IsInDrawState()) {
-        Finish();
+    // a render pass instance is already recording, clear its attachments in place
+    if(!mWriteFBO->IsInIdleState()) {
+        ClearAttachments(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+        return;
     }
     mWriteFBO->SetStateClear();
 
-    BeginRendering(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+    // a clear of the whole framebuffer folds into the load operations of the render pass
+    if(ClearRectCoversFramebuffer()) {
+        BeginRendering(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+    } else {
+        BeginRendering(false, false, false);
+        ClearAttachments(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+    }
+}
+
+void
+Context::ClearAttachments(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
+
+    // vkCmdClearAttachments ignores the write masks, skip the aspects the render pass load operations would skip
+    const VkFormat depthStencilFormat = mWriteFBO->GetDepthStencilAttachmentTexture() ?
+                                        mWriteFBO->GetDepthStencilAttachmentTexture()->GetVkFormat() : VK_FORMAT_UNDEFINED;
+    clearColorEnabled   = clearColorEnabled   && mWriteFBO->GetColorAttachmentTexture() && stateFramebufferOperations->IsColorWriteEnabled();
+    clearDepthEnabled   = clearDepthEnabled   && VkFormatIsDepth(depthStencilFormat)    && stateFramebufferOperations->IsDepthWriteEnabled();
+    clearStencilEnabled = clearStencilEnabled && VkFormatIsStencil(depthStencilFormat)  && stateFramebufferOperations->IsStencilWriteEnabled();
+
+    if(!clearColorEnabled && !clearDepthEnabled && !clearStencilEnabled) {
+        return;
+    }
+
+    uint32_t attachmentsCount = 0;
+    if(clearColorEnabled) {
+        GLfloat clearColorValue[4];
+        stateFramebufferOperations->GetClearColor(clearColorValue);
+        if(mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
+            clearColorValue[3] = 1.0f;
+        }
+        mClearPass->SetColorAttachment(attachmentsCount++, clearColorValue);
+    }
+
+    if(clearDepthEnabled && clearStencilEnabled) {
+        mClearPass->SetDepthStencilAttachment(attachmentsCount++, stateFramebufferOperations->GetClearDepth(),
+                                              stateFramebufferOperations->GetClearStencilMasked());
+    } else if(clearDepthEnabled) {
+        mClearPass->SetDepthAttachment(attachmentsCount++, stateFramebufferOperations->GetClearDepth());
+    } else if(clearStencilEnabled) {
+        mClearPass->SetStencilAttachment(attachmentsCount++, stateFramebufferOperations->GetClearStencilMasked());
+    }
+
+    mClearPass->SetAttachmentsCount(attachmentsCount);
+    mClearPass->SetRect(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
+
+    VkCommandBuffer *secondaryCmdBuffer = mCommandBufferManager->AllocateVkSecondaryCmdBuffers(1);
+    mCommandBufferManager->BeginVkSecondaryCommandBuffer(secondaryCmdBuffer, *mWriteFBO->GetVkRenderPass(), *mWriteFBO->GetActiveVkFramebuffer());
+
+    vkCmdClearAttachments(*secondaryCmdBuffer, mClearPass->GetAttachmentsCount(), mClearPass->GetAttachments(),
+                                                mClearPass->GetRectCount(),        mClearPass->GetRect());
+    mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
+
+    mWriteFBO->ExecuteVkSecondaryCommandBuffer(secondaryCmdBuffer);
+}
+
+bool
+Context::ClearRectCoversFramebuffer(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return mClearRect.x == 0 && mClearRect.width  == mWriteFBO->GetWidth() &&
+           mClearRect.y == 0 && mClearRect.height == mWriteFBO->GetHeight();
 }
 
 void
-Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
+Context::ClearWithMasks(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -122,14 +191,13 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
         return;
     }
 
-    if(mWriteFBO->IsInClearState()) {
-        Finish();
-    }
-
-    PrepareRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
-
     StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
 
+    // unmasked buffers are cleared like any other clear, which also begins the render pass if needed
+    const bool maskedColor   = clearColorEnabled   && stateFramebufferOperations->ColorMaskActive();
+    const bool maskedStencil = clearStencilEnabled && stateFramebufferOperations->StencilMaskActive();
+    ClearSimple(clearColorEnabled && !maskedColor, clearDepthEnabled, clearStencilEnabled && !maskedStencil);
+
     // clearColor is passed as a uniform and masked through VkPipelineColorBlendAttachmentState
     GLfloat clearColorValue[4] = {0.0f,0.0f,0.0f,0.0f};
     stateFramebufferOperations->GetClearColor(clearColorValue);
@@ -137,13 +205,13 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
         clearColorValue[3] = 1.0f;
     }
 
-    mStateManager.GetFramebufferOperationsState()->GetClearColor(clearColorValue);
-
     mScreenSpacePass->UpdateUniformBufferColor(clearColorValue[0], clearColorValue[1], clearColorValue[2], clearColorValue[3]);
 
     vulkanAPI::Pipeline* pipeline = mScreenSpacePass->GetPipeline();
 
-    if(mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
+    if(!maskedColor) {
+        pipeline->SetColorBlendAttachmentWriteMask(0);
+    } else if(mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
         GLboolean colormask[4];
         mStateManager.GetFramebufferOperationsState()->GetColorMask(colormask);
         GLubyte colorMaskPackRGB = GlColorMaskPack(colormask[0], colormask[1], colormask[2], GL_FALSE);
@@ -152,7 +220,28 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
         pipeline->SetColorBlendAttachmentWriteMask(GLColorMaskToVkColorComponentFlags(stateFramebufferOperations->GetColorMask()));
     }
 
-    pipeline->SetUpdatePipeline(true);
+    // the clear value is written by the stencil test, the stencil write mask preserves the masked bits
+    pipeline->SetStencilTestEnable(maskedStencil);
+    if(maskedStencil) {
+        const uint32_t clearStencilValue = stateFramebufferOperations->GetClearStencilMasked();
+        const uint32_t stencilMask       = stateFramebufferOperations->GetStencilMaskFront();
+
+        pipeline->SetStencilFrontCompareOp(VK_COMPARE_OP_ALWAYS);
+        pipeline->SetStencilFrontFailOp(VK_STENCIL_OP_KEEP);
+        pipeline->SetStencilFrontZFailOp(VK_STENCIL_OP_REPLACE);
+        pipeline->SetStencilFrontPassOp(VK_STENCIL_OP_REPLACE);
+        pipeline->SetStencilFrontReference(clearStencilValue);
+        pipeline->SetStencilFrontWriteMask(stencilMask);
+        pipeline->SetStencilBackCompareOp(VK_COMPARE_OP_ALWAYS);
+        pipeline->SetStencilBackFailOp(VK_STENCIL_OP_KEEP);
+        pipeline->SetStencilBackZFailOp(VK_STENCIL_OP_REPLACE);
+        pipeline->SetStencilBackPassOp(VK_STENCIL_OP_REPLACE);
+        pipeline->SetStencilBackReference(clearStencilValue);
+        pipeline->SetStencilBackWriteMask(stencilMask);
+    }
+
+    pipeline->SetMultisampleRasterizationSamples(mWriteFBO->GetSamples());
+    pipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_RENDER_PASS);
     pipeline->SetViewport(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
     pipeline->SetScissor(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
 
@@ -161,9 +250,6 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
         return;
     }
 
-    mCommandBufferManager->BeginVkDrawCommandBuffer();
-    mWriteFBO->BeginVkRenderPass();
-
     const VkCommandBuffer *secondaryCmdBuffer = mCommandBufferManager->AllocateVkSecondaryCmdBuffers(1);
     mCommandBufferManager->BeginVkSecondaryCommandBuffer(secondaryCmdBuffer, *mWriteFBO->GetVkRenderPass(), *mWriteFBO->GetActiveVkFramebuffer());
 
@@ -176,9 +262,7 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
     mScreenSpacePass->Draw(secondaryCmdBuffer);
     mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
 
-    VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
-    vkCmdExecuteCommands(activeCmdBuffer, 1, secondaryCmdBuffer);
-    Finish();
+    mWriteFBO->ExecuteVkSecondaryCommandBuffer(secondaryCmdBuffer);
 }
 
 void
@@ -189,7 +273,7 @@ Context::UpdateViewportState(vulkanAPI::Pipeline* pipeline)
     StateFragmentOperations* stateFragmentOperations = mStateManager.GetFragmentOperationsState();
     StateViewportTransformation* stateViewportTransformation = mStateManager.GetViewportTransformationState();
 
-    if(pipeline->GetUpdateViewportState()) {
+    if(pipeline->IsDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR)) {
         Rect viewportRect = stateViewportTransformation->GetViewportRect();
 
         pipeline->ComputeViewport(mWriteFBO->GetWidth(), mWriteFBO->GetHeight(),
@@ -203,7 +287,7 @@ Context::UpdateViewportState(vulkanAPI::Pipeline* pipeline)
         pipeline->ComputeScissor(mWriteFBO->GetWidth(), mWriteFBO->GetHeight(),
                                  scissorRect.x, scissorRect.y,
                                  scissorRect.width, scissorRect.height);
-       pipeline->SetUpdateViewportState(false);
+        pipeline->ClearDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR);
     }
 }
 
@@ -234,6 +318,10 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
         mIsModeLineLoop = false;
     }
 
+    // the active program may be shared with other contexts, its buffers and
+    // descriptors are kept locked until they are recorded into the command buffer
+    std::lock_guard<std::recursive_mutex> programLock(mStateManager.GetActiveShaderProgram()->GetMutex());
+
     uint32_t indexOffset = 0;
     uint32_t maxIndex = 0;
     if(indexed) {
@@ -242,24 +330,30 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
 
     UpdateVertexAttributes(indexed ? maxIndex + 1 : vertCount, firstVertex);
 
+    // the alpha channel of GL_RGB targets is never written. The setter only marks
+    // the blend state dirty when the effective mask actually changes
     if(mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
         GLboolean colormask[4];
         mStateManager.GetFramebufferOperationsState()->GetColorMask(colormask);
         GLubyte colorMaskPackRGB = GlColorMaskPack(colormask[0], colormask[1], colormask[2], GL_FALSE);
         mPipeline->SetColorBlendAttachmentWriteMask(GLColorMaskToVkColorComponentFlags(colorMaskPackRGB));
+    } else {
+        mPipeline->SetColorBlendAttachmentWriteMask(GLColorMaskToVkColorComponentFlags(mStateManager.GetFramebufferOperationsState()->GetColorMask()));
     }
 
-    if(SetPipelineProgramShaderStages(mStateManager.GetActiveShaderProgram())) {
+    // the pipeline has to match the sample count of the render pass it is used in
+    mPipeline->SetMultisampleRasterizationSamples(mWriteFBO->GetSamples());
+
+    // the shader stages are only re-derived when the program changed. The program
+    // stays dirty until a pipeline has been created successfully with them
+    if(!mPipeline->IsDirty(vulkanAPI::Pipeline::DIRTY_PROGRAM) ||
+       SetPipelineProgramShaderStages(mStateManager.GetActiveShaderProgram())) {
         if(!mPipeline->Create(mWriteFBO->GetVkRenderPass())) {
             Finish();
             return;
         }
     }
 
-    if(mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
-        mPipeline->SetColorBlendAttachmentWriteMask(GLColorMaskToVkColorComponentFlags(mStateManager.GetFramebufferOperationsState()->GetColorMask()));
-    }
-
     VkCommandBuffer *secondaryCmdBuffer = mCommandBufferManager->AllocateVkSecondaryCmdBuffers(1);
     mCommandBufferManager->BeginVkSecondaryCommandBuffer(secondaryCmdBuffer, *mWriteFBO->GetVkRenderPass(), *mWriteFBO->GetActiveVkFramebuffer());
 
@@ -273,11 +367,105 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
 
     mPipeline->UpdateDynamicState(secondaryCmdBuffer, mStateManager.GetRasterizationState()->GetLineWidth());
 
-    DrawGeometry(secondaryCmdBuffer, indexed, firstVertex, vertCount);
-    mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
+    // the draw itself is recorded when the run of draws sharing this state ends
+    mPendingDraw.secondaryCmdBuffer = secondaryCmdBuffer;
+    mPendingDraw.fbo                = mWriteFBO;
+    mPendingDraw.mode               = mStateManager.GetInputAssemblyState()->GetPrimitiveMode();
+    mPendingDraw.indexed            = indexed;
+    mPendingDraw.type               = type;
+    mPendingDraw.indexOffset        = indexOffset;
+    mPendingDraw.coalescable        = IsDrawCoalescable(indexed, type);
+    mPendingDraw.ranges.push_back({firstVertex, vertCount});
+
+    if(!mPendingDraw.coalescable) {
+        FlushPendingDraw();
+    }
+}
+
+bool
+Context::IsDrawCoalescable(bool indexed, GLenum type)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!GLOVE_ENABLE_DRAW_COALESCING || mIsModeLineLoop) {
+        return false;
+    }
+
+    // client-side indices are captured per draw call and GL_UNSIGNED_BYTE
+    // indices are converted into an index buffer of their own
+    if(indexed && (!mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) || type == GL_UNSIGNED_BYTE)) {
+        return false;
+    }
+
+    // sampling a texture that is also rendered to revalidates the descriptors on every draw
+    if(*mStateManager.GetActiveShaderProgram()->GetVkDescSet() && mPipeline->IsDirty(vulkanAPI::Pipeline::DIRTY_DESCRIPTORS)) {
+        return false;
+    }
+
+    return mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->IsSourcedFromBufferObjects(mStateManager.GetActiveShaderProgram()->GetVertexInputLocations());
+}
+
+bool
+Context::AppendPendingDraw(GLenum mode, uint32_t first, uint32_t count, bool indexed, GLenum type, const void *indices)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// No other GL call has been issued since the pending draw was set up (see CONTEXT_EXEC),
+    /// so a draw with the same mode and index type would be recorded with the very same state
+    if(!mPendingDraw.secondaryCmdBuffer || !mPendingDraw.coalescable || mPendingDraw.mode != mode ||
+       mPendingDraw.indexed != indexed || (indexed && mPendingDraw.type != type)) {
+        return false;
+    }
+
+    // the index buffer is bound at the offset of the first draw, later draws index relative to it
+    if(indexed) {
+        const uintptr_t offset      = reinterpret_cast<uintptr_t>(indices);
+        const size_t    elementSize = type == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+        if(offset < mPendingDraw.indexOffset || (offset - mPendingDraw.indexOffset) % elementSize) {
+            return false;
+        }
+        first = static_cast<uint32_t>((offset - mPendingDraw.indexOffset) / elementSize);
+    }
+
+    // contiguous ranges of independent primitives form a single draw, as long as
+    // the previous range does not end with the vertices of an incomplete primitive
+    uint32_t primitiveVertices = 0;
+    switch(mode) {
+    case GL_POINTS:    primitiveVertices = 1; break;
+    case GL_LINES:     primitiveVertices = 2; break;
+    case GL_TRIANGLES: primitiveVertices = 3; break;
+    default:           break;
+    }
+
+    drawRange_t &last = mPendingDraw.ranges.back();
+    if(primitiveVertices && last.first + last.count == first && !(last.count % primitiveVertices)) {
+        last.count += count;
+    } else {
+        mPendingDraw.ranges.push_back({first, count});
+    }
+
+    return true;
+}
+
+void
+Context::FlushPendingDraw(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
-    vkCmdExecuteCommands(activeCmdBuffer, 1, secondaryCmdBuffer);
+    if(!mPendingDraw.secondaryCmdBuffer) {
+        return;
+    }
+
+    for(const auto &range : mPendingDraw.ranges) {
+        DrawGeometry(mPendingDraw.secondaryCmdBuffer, mPendingDraw.indexed, range.first, range.count);
+    }
+    mCommandBufferManager->EndVkSecondaryCommandBuffer(mPendingDraw.secondaryCmdBuffer);
+
+    mPendingDraw.fbo->ExecuteVkSecondaryCommandBuffer(mPendingDraw.secondaryCmdBuffer);
+
+    mPendingDraw.secondaryCmdBuffer = nullptr;
+    mPendingDraw.fbo                = nullptr;
+    mPendingDraw.ranges.clear();
 }
 
 void
@@ -285,9 +473,9 @@ Context::UpdateIndices(uint32_t* offset, uint32_t* maxIndex, uint32_t indexCount
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mPipeline->GetUpdateIndexBuffer() || indices) {
-        mStateManager.GetActiveShaderProgram()->PrepareIndexBufferObject(offset, maxIndex, indexCount, type, indices, ibo);
-        mPipeline->SetUpdateIndexBuffer(false);
+    if(mPipeline->IsDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER) || indices) {
+        mStateManager.GetActiveShaderProgram()->PrepareIndexBufferObject(offset, maxIndex, indexCount, type, indices, ibo, mCacheManager);
+        mPipeline->ClearDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
     }
 }
 
@@ -296,14 +484,13 @@ Context::UpdateVertexAttributes(uint32_t vertCount, uint32_t firstVertex)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    /// A glVertexAttrib related function has been called. Check to see if mVkPipelineVertexInput needs to be updated.
+    /// The vertex input state of the bound vao is regenerated only if its attribute arrays have been respecified.
     /// If this is true then VkPipeline needs to be updated too.
-    /// Otherwise only the buffer that will be bound with vkCmdBindVertexBuffers need to be updated
+    /// Otherwise only the buffers that will be bound with vkCmdBindVertexBuffers need to be updated
     if(mStateManager.GetActiveShaderProgram()->PrepareVertexAttribBufferObjects(vertCount, firstVertex,
-                                                                                mResourceManager->GetGenericVertexAttributes(),
-                                                                                mPipeline->GetUpdateVertexAttribVBOs())) {
-        mPipeline->SetUpdatePipeline(true);
-        mPipeline->SetUpdateVertexAttribVBOs(false);
+                                                                                mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject(),
+                                                                                mCacheManager)) {
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VERTEX_INPUT);
     }
 }
 
@@ -313,9 +500,15 @@ Context::BindUniformDescriptors(VkCommandBuffer *CmdBuffer)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     if(*mStateManager.GetActiveShaderProgram()->GetVkDescSet()) {
-        mStateManager.GetActiveShaderProgram()->UpdateBuiltInUniformData(mStateManager.GetViewportTransformationState()->GetMinDepthRange(),
-                                                                         mStateManager.GetViewportTransformationState()->GetMaxDepthRange());
-        mStateManager.GetActiveShaderProgram()->UpdateDescriptorSet();
+        /// Descriptor contents are revalidated only when the context state they depend on or the uniforms of the program changed.
+        /// Sampling a texture that is attached to a framebuffer keeps them dirty, since its contents may be rendered to at any draw
+        if(mPipeline->IsDirty(vulkanAPI::Pipeline::DIRTY_DESCRIPTORS) || mStateManager.GetActiveShaderProgram()->HasDirtyDescriptors()) {
+            mStateManager.GetActiveShaderProgram()->UpdateBuiltInUniformData(mStateManager.GetViewportTransformationState()->GetMinDepthRange(),
+                                                                             mStateManager.GetViewportTransformationState()->GetMaxDepthRange());
+            if(!mStateManager.GetActiveShaderProgram()->UpdateDescriptorSet(mCacheManager)) {
+                mPipeline->ClearDirty(vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
+            }
+        }
         vkCmdBindDescriptorSets(*CmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mStateManager.GetActiveShaderProgram()->GetVkPipelineLayout(), 0, 1, mStateManager.GetActiveShaderProgram()->GetVkDescSet(), 0, nullptr);
     }
 }
@@ -344,14 +537,14 @@ Context::BindIndexBuffer(VkCommandBuffer *CmdBuffer, uint32_t offset, VkIndexTyp
 }
 
 void
-Context::DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount)
+Context::DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t first, uint32_t vertCount)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     if(indexed == false) {
-        vkCmdDraw(*CmdBuffer, vertCount, 1, firstVertex, 0);
+        vkCmdDraw(*CmdBuffer, vertCount, 1, first, 0);
     } else {
-        vkCmdDrawIndexed(*CmdBuffer, vertCount, 1, 0, 0, 0);
+        vkCmdDrawIndexed(*CmdBuffer, vertCount, 1, first, 0, 0);
     }
 }
 
@@ -383,6 +576,11 @@ Context::DrawArrays(GLenum mode, GLint first, GLsizei count)
         return;
     }
 
+    if(AppendPendingDraw(mode, first, count, false, GL_INVALID_ENUM, nullptr)) {
+        return;
+    }
+    FlushPendingDraw();
+
     if(mStateManager.GetInputAssemblyState()->UpdatePrimitiveMode(mode)) {
         mPipeline->SetInputAssemblyTopology(GlPrimitiveTopologyToVkPrimitiveTopology(mStateManager.GetInputAssemblyState()->GetPrimitiveMode()));
     }
@@ -395,7 +593,7 @@ Context::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indic
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if( (mode > GL_TRIANGLE_FAN)  || !(type == GL_UNSIGNED_BYTE || type == GL_UNSIGNED_SHORT) ) {
+    if( (mode > GL_TRIANGLE_FAN)  || !(type == GL_UNSIGNED_BYTE || type == GL_UNSIGNED_SHORT || type == GL_UNSIGNED_INT) ) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -418,6 +616,11 @@ Context::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indic
         return;
     }
 
+    if(AppendPendingDraw(mode, 0, count, true, type, indices)) {
+        return;
+    }
+    FlushPendingDraw();
+
     if(mStateManager.GetInputAssemblyState()->UpdatePrimitiveMode(mode)) {
         mPipeline->SetInputAssemblyTopology(GlPrimitiveTopologyToVkPrimitiveTopology(mStateManager.GetInputAssemblyState()->GetPrimitiveMode()));
     }
@@ -439,6 +642,7 @@ Context::Finish(void)
     }
 
     mResourceManager->CleanPurgeList();
+    ResolvePendingReadbacks(nullptr, false);
 
     if(!mWriteFBO->IsInDeleteState()) {
         if(mWriteFBO == mSystemFBO) {
@@ -459,6 +663,22 @@ Context::Finish(void)
     mResourceManager->CleanPurgeList();
 }
 
+void
+Context::FinishFrame(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the multisampled and depth/stencil contents of the window surface are
+    // undefined after the swap, so the last render pass of the frame does
+    // not store them and the first one of the next frame does not load them
+    if(mWriteFBO != nullptr && mWriteFBO == mSystemFBO) {
+        mWriteFBO->DiscardAttachments(false, true, true);
+        mWriteFBO->DiscardMultisampleAttachment();
+    }
+
+    Finish();
+}
+
 bool
 Context::Flush(void)
 {
@@ -468,6 +688,8 @@ Context::Flush(void)
         return false;
     }
 
+    FlushPendingDraw();
+
     if(mWriteFBO->EndVkRenderPass()) {
         mCommandBufferManager->EndVkDrawCommandBuffer();
         mCommandBufferManager->SubmitVkDrawCommandBuffer();
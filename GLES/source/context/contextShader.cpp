@@ -39,7 +39,7 @@ Context::CompileShader(GLuint shader)
 
     CreateShaderCompiler();
 
-    shaderPtr->CompileShader();
+    shaderPtr->CompileShader(mShaderCompiler);
 }
 
 GLuint
@@ -56,7 +56,6 @@ Context::CreateShader(GLenum type)
     Shader *shader = mResourceManager->GetShader(res);
     shader->SetShaderType(type == GL_VERTEX_SHADER ? SHADER_TYPE_VERTEX : SHADER_TYPE_FRAGMENT);
     shader->SetVkContext(mVkContext);
-    shader->SetShaderCompiler(mShaderCompiler);
 
     return mResourceManager->PushShadingObject({SHADER_ID, res});
 }
@@ -123,7 +122,7 @@ Context::GetShaderiv(GLuint shader, GLenum pname, GLint *params)
     switch(pname) {
     case GL_COMPILE_STATUS:         *params = shaderPtr->IsCompiled()           ? GL_TRUE : GL_FALSE; break;
     case GL_DELETE_STATUS:          *params = shaderPtr->GetMarkForDeletion()   ? GL_TRUE : GL_FALSE; break;
-    case GL_INFO_LOG_LENGTH:        *params = shaderPtr->GetInfoLogLength();      break;
+    case GL_INFO_LOG_LENGTH:        *params = shaderPtr->GetInfoLogLength(mShaderCompiler); break;
     case GL_SHADER_SOURCE_LENGTH:   *params = shaderPtr->GetShaderSourceLength(); break;
     case GL_SHADER_TYPE:            *params = shaderPtr->GetShaderType() == SHADER_TYPE_FRAGMENT ? GL_FRAGMENT_SHADER : GL_VERTEX_SHADER; break;
     default:                        RecordError(GL_INVALID_ENUM); break;
@@ -149,10 +148,10 @@ Context::GetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* length, char*
         return;
     }
 
-    char *log = shaderPtr->GetInfoLog();
+    char *log = shaderPtr->GetInfoLog(mShaderCompiler);
 
     if(log) {
-        GLint len         = shaderPtr->GetInfoLogLength();
+        GLint len         = shaderPtr->GetInfoLogLength(mShaderCompiler);
         GLint returnedLen = static_cast<GLint>(std::max(std::min(bufsize, len) - 1, 0));
 
         if(length) {
@@ -341,17 +340,5 @@ Context::CreateShaderCompiler(void)
 
     if(mShaderCompiler == nullptr) {
         mShaderCompiler = new GlslangShaderCompiler();
-
-        ObjectArray<Shader> *shaderArray = mResourceManager->GetShaderArray();
-        for(typename map<uint32_t, Shader *>::const_iterator it =
-        shaderArray->GetObjects()->begin(); it != shaderArray->GetObjects()->end(); it++) {
-            it->second->SetShaderCompiler(mShaderCompiler);
-        }
-
-        ObjectArray<ShaderProgram> *shaderProgramArray = mResourceManager->GetShaderProgramArray();
-        for(typename map<uint32_t, ShaderProgram *>::const_iterator it =
-        shaderProgramArray->GetObjects()->begin(); it != shaderProgramArray->GetObjects()->end(); it++) {
-            it->second->SetShaderCompiler(mShaderCompiler);
-        }
     }
 }
@@ -49,6 +49,7 @@ Context::AttachShader(GLuint program, GLuint shader)
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
     progPtr->AttachShader(shaderPtr);
     progPtr->SetStagesIDs(shaderPtr->GetShaderType() == SHADER_TYPE_VERTEX ? 0 : 1, shader);
 }
@@ -73,6 +74,7 @@ Context::BindAttribLocation(GLuint program, GLuint index, const char *name)
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
     progPtr->SetCustomAttribsLayout(name, index);
 }
 
@@ -84,8 +86,6 @@ Context::CreateProgram(void)
     GLuint         res     = mResourceManager->AllocateShaderProgram();
     ShaderProgram *progPtr = mResourceManager->GetShaderProgram(res);
     progPtr->SetVkContext(mVkContext);
-    progPtr->SetShaderCompiler(mShaderCompiler);
-    progPtr->SetCacheManager(mCacheManager);
 
     return mResourceManager->PushShadingObject({SHADER_PROGRAM_ID, res});
 }
@@ -141,6 +141,7 @@ Context::DetachShader(GLuint program, GLuint shader)
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
     progPtr->DetachShader(shaderPtr);
 
     if(shaderPtr->GetMarkForDeletion() && shaderPtr->FreeForDeletion()) {
@@ -303,7 +304,10 @@ Context::GetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei *length, G
         return;
     }
 
-    progPtr->GetBinaryData(binary, length);
+    CreateShaderCompiler();
+
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
+    progPtr->GetBinaryData(binary, length, mShaderCompiler);
 
     if(bufSize < *length) {
         *length = 0;
@@ -329,9 +333,9 @@ Context::GetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* length, cha
         return;
     }
 
-    char *log = progPtr->GetInfoLog();
+    char *log = progPtr->GetInfoLog(mShaderCompiler);
     if(log) {
-        int len = progPtr->GetInfoLogLength();
+        int len = progPtr->GetInfoLogLength(mShaderCompiler);
         int returnedLen = std::max(std::min(bufsize, len) - 1, 0);
 
         if(length) {
@@ -398,7 +402,7 @@ Context::GetProgramiv(GLuint program, GLenum pname, GLint* params)
     case GL_DELETE_STATUS:               *params = progPtr->GetMarkForDeletion() ? GL_TRUE : GL_FALSE; break;
     case GL_LINK_STATUS:                 *params = progPtr->IsLinked() ? GL_TRUE : GL_FALSE; break;
     case GL_VALIDATE_STATUS:             *params = progPtr->IsValidated() ? GL_TRUE : GL_FALSE; break;
-    case GL_INFO_LOG_LENGTH:             *params = progPtr->GetInfoLogLength(); break;
+    case GL_INFO_LOG_LENGTH:             *params = progPtr->GetInfoLogLength(mShaderCompiler); break;
     case GL_ATTACHED_SHADERS:            *params = (bool)progPtr->GetVertexShader() + (bool)progPtr->GetFragmentShader(); break;
     case GL_ACTIVE_ATTRIBUTES:           *params = progPtr->GetNumberOfActiveAttributes(); break;
     case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH: *params = static_cast<GLint>(progPtr->GetActiveAttribMaxLen()); break;
@@ -602,7 +606,6 @@ Context::SetPipelineProgramShaderStages(ShaderProgram *progPtr)
 
     mPipeline->SetCache(progPtr->GetVkPipelineCache());
     mPipeline->SetLayout(progPtr->GetVkPipelineLayout());
-    mPipeline->SetVertexInputState(progPtr->GetVkPipelineVertexInput());
 
     return true;
 }
@@ -621,16 +624,24 @@ Context::LinkProgram(GLuint program)
         Finish();
     }
 
-    progPtr->LinkProgram();
+    CreateShaderCompiler();
+
+    // programs may be shared, they are linked with the compiler and caches of the calling context
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
+    progPtr->LinkProgram(mShaderCompiler, mCacheManager);
     progPtr->SetShaderModules();
 
-    mPipeline->SetUpdatePipeline(progPtr->IsLinked());
-    if(SetPipelineProgramShaderStages(progPtr)) {
-        progPtr->PrepareVertexAttribBufferObjects(0, 0, mResourceManager->GetGenericVertexAttributes(), true);
+    // the pipeline is prebuilt only once the system framebuffer has a render pass to build it against
+    if(progPtr->IsLinked() && SetPipelineProgramShaderStages(progPtr) && mSystemFBO->GetVkRenderPass() != nullptr) {
+        progPtr->PrepareVertexAttribBufferObjects(0, 0, mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject(), mCacheManager);
+        mPipeline->SetMultisampleRasterizationSamples(mSystemFBO->GetSamples());
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_PIPELINE);
         mPipeline->Create(mSystemFBO->GetVkRenderPass());
-        // rebuild the pipeline next time
-        mPipeline->SetUpdatePipeline(true);
     }
+    // rebuild the pipeline with the active program next time, against the
+    // render pass of the framebuffer that is drawn to rather than the system one
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_PROGRAM | vulkanAPI::Pipeline::DIRTY_DESCRIPTORS |
+                        vulkanAPI::Pipeline::DIRTY_RENDER_PASS);
 }
 
 void
@@ -1399,7 +1410,7 @@ Context::UseProgram(GLuint program)
         curProgPtr->Unbind();
     }
     mStateManager.GetActiveObjectsState()->SetActiveShaderProgram(progPtr);
-    mPipeline->SetUpdatePipeline(true);
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_PROGRAM | vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
     if(progPtr) {
         progPtr->Bind();
         progPtr->EnableUpdateOfDescriptorSets();
@@ -1422,6 +1433,7 @@ Context::ValidateProgram(GLuint program)
         }
     }
 
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
     progPtr->Validate();
 
     if(!progPtr->IsValidated()){
@@ -1457,6 +1469,10 @@ Context::ProgramBinaryOES(GLuint program, GLenum binaryFormat, const void *binar
     AttachShader(program, vs);
     AttachShader(program, fs);
 
-    progPtr->UsePrecompiledBinary(binary, length);
+    CreateShaderCompiler();
+
+    std::lock_guard<std::recursive_mutex> programLock(progPtr->GetMutex());
+    progPtr->UsePrecompiledBinary(binary, length, mShaderCompiler, mCacheManager);
     progPtr->SetShaderModules();
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_PROGRAM | vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
 }
@@ -166,7 +166,7 @@ Context::Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
     }
 
     if(mStateManager.GetFragmentOperationsState()->UpdateScissorRect(x, y, width, height)) {
-        mPipeline->SetUpdateViewportState(true);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR);
     }
 }
 
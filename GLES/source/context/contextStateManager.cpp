@@ -47,7 +47,7 @@ Context::SetCapability(GLenum cap, GLboolean enable)
     switch(cap) {
     case GL_SCISSOR_TEST:
         if(mStateManager.GetFragmentOperationsState()->UpdateScissorTestEnabled(enable)) {
-            mPipeline->SetUpdateViewportState(true);
+            mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR);
         }
         break;
     case GL_DEPTH_TEST:
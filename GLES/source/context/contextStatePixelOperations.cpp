@@ -79,7 +79,11 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    // with a pack buffer bound, pixels is an offset into the buffer's data store
+    BufferObject *packBuffer = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV);
+    const size_t  packOffset = reinterpret_cast<size_t>(pixels);
+
+    if(packBuffer == nullptr && mWriteFBO->IsInDrawState()) {
         Finish();
     }
 
@@ -101,6 +105,17 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
                       mStateManager.GetPixelStorageState()->GetPixelStorePack());
 
     srcRect.y = activeTexture->GetInvertedYOrigin(&srcRect);
+
+    if(packBuffer) {
+        if(!packBuffer->HasData() || packOffset + dstRect.GetRectBufferSize() > packBuffer->GetSize()) {
+            RecordError(GL_INVALID_OPERATION);
+            return;
+        }
+
+        ReadPixelsToPackBuffer(activeTexture, &srcRect, &dstRect, dstInternalFormat, packBuffer, packOffset);
+        return;
+    }
+
     activeTexture->CopyPixelsToHost(&srcRect, &dstRect, 0, 0, dstInternalFormat, pixels);
 
 #if GLOVE_SAVE_READPIXELS_TO_FILE == true
@@ -114,3 +129,101 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
     }
 #endif
 }
+
+void
+Context::ReadPixelsToPackBuffer(Texture *texture, const ImageRect *srcRect, const ImageRect *dstRect, GLenum dstFormat, BufferObject *packBuffer, size_t packOffset)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // record the copy right after the rendering commands of the frame and submit
+    // without waiting; the data reaches the pack buffer once the fence has signaled
+    if(mWriteFBO->IsInDrawState()) {
+        mWriteFBO->EndVkRenderPass();
+    }
+
+    mCommandBufferManager->BeginVkDrawCommandBuffer();
+    VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
+
+    BufferObject *stagingBuffer = texture->CopyPixelsToBuffer(&activeCmdBuffer, srcRect, 0, 0);
+
+    mCommandBufferManager->EndVkDrawCommandBuffer();
+    mCommandBufferManager->SubmitVkDrawCommandBuffer();
+    mWriteFBO->SetStateIdle();
+
+    if(stagingBuffer == nullptr) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
+    pendingReadback_t readback;
+    readback.packBuffer     = packBuffer;
+    readback.packOffset     = packOffset;
+    readback.stagingBuffer  = stagingBuffer;
+    readback.srcRect        = *srcRect;
+    readback.dstRect        = *dstRect;
+    readback.srcFormat      = texture->GetExplicitInternalFormat();
+    readback.dstFormat      = dstFormat;
+    readback.submitSerial   = mCommandBufferManager->GetLastSubmitSerial();
+    mPendingReadbacks.push_back(readback);
+}
+
+void
+Context::ResolvePendingReadbacks(const BufferObject *packBuffer, bool wait)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    auto it = mPendingReadbacks.begin();
+    while(it != mPendingReadbacks.end()) {
+        // a null packBuffer resolves all readbacks, including the discarded ones
+        if(packBuffer && it->packBuffer != packBuffer) {
+            ++it;
+            continue;
+        }
+
+        if(!mCommandBufferManager->IsSubmitSerialCompleted(it->submitSerial)) {
+            // submissions complete in order, so neither will any later readback
+            if(!wait || !mCommandBufferManager->WaitSubmitSerial(it->submitSerial)) {
+                break;
+            }
+        }
+
+        if(it->packBuffer) {
+            const size_t srcSize = it->srcRect.GetRectBufferSize();
+            const size_t dstSize = it->dstRect.GetRectBufferSize();
+            uint8_t *srcData = new uint8_t[srcSize];
+            uint8_t *dstData = new uint8_t[dstSize];
+            it->stagingBuffer->GetData(srcSize, 0, srcData);
+
+            ImageRect srcRect = it->srcRect;
+            ImageRect dstRect = it->dstRect;
+            srcRect.x = 0; srcRect.y = 0;
+            dstRect.x = 0; dstRect.y = 0;
+            ConvertPixels(it->srcFormat, it->dstFormat,
+                          &srcRect, srcData,
+                          &dstRect, dstData);
+            InvertImageYAxis(dstData, &dstRect);
+
+            it->packBuffer->UpdateData(dstSize, it->packOffset, dstData);
+
+            delete[] srcData;
+            delete[] dstData;
+        }
+
+        delete it->stagingBuffer;
+        it = mPendingReadbacks.erase(it);
+    }
+}
+
+void
+Context::DiscardPendingReadbacks(const BufferObject *packBuffer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the staging buffers may still be in use by the GPU, they are released
+    // when the next resolve finds their submission completed
+    for(auto &readback : mPendingReadbacks) {
+        if(readback.packBuffer == packBuffer) {
+            readback.packBuffer = nullptr;
+        }
+    }
+}
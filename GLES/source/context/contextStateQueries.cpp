@@ -45,9 +45,12 @@ Context::GetBooleanv(GLenum pname, GLboolean* params)
     case GL_CURRENT_PROGRAM:                    *params = GetProgramId(mStateManager.GetActiveShaderProgram()) == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_ARRAY_BUFFER_BINDING:               *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)         ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)        ) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER)) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
+    case GL_VERTEX_ARRAY_BINDING_OES:           *params = GetVertexArrayId(mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()) == 0 ? GL_FALSE : GL_TRUE; break;
+    case GL_PIXEL_PACK_BUFFER_BINDING_NV:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV)) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
     case GL_NUM_SHADER_BINARY_FORMATS:          *params = GLOVE_NUM_SHADER_BINARY_FORMATS == 0 ? GL_FALSE : GL_TRUE; break;
-    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = GL_FALSE; break;
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = GL_FALSE; break;
+    case GL_COMPRESSED_TEXTURE_FORMATS:         { GLint count; const GLenum *formats = GetEtcCompressedFormats(&count);
+                                                  for(GLint i = 0; i < count; ++i) { params[i] = formats[i] ? GL_TRUE : GL_FALSE; } } break;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     { GLint count; GetEtcCompressedFormats(&count); *params = count ? GL_TRUE : GL_FALSE; } break;
     case GL_BLEND_COLOR:                        mStateManager.GetFragmentOperationsState()->GetBlendingColor(params); break;
     case GL_BLEND_DST_ALPHA:                    *params = mStateManager.GetFragmentOperationsState()->GetBlendingFactorDestinationAlpha() == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_BLEND_DST_RGB:                      *params = mStateManager.GetFragmentOperationsState()->GetBlendingFactorDestinationRGB() == 0 ? GL_FALSE : GL_TRUE; break;
@@ -97,8 +100,8 @@ Context::GetBooleanv(GLenum pname, GLboolean* params)
     case GL_SAMPLE_COVERAGE:                    *params = mStateManager.GetFragmentOperationsState()->GetSampleCoverageEnabled(); break;
     case GL_SCISSOR_TEST:                       *params = mStateManager.GetFragmentOperationsState()->GetScissorTestEnabled(); break;
     case GL_STENCIL_TEST:                       *params = mStateManager.GetFragmentOperationsState()->GetStencilTestEnabled(); break;
-    case GL_SAMPLES:                            *params = mStateManager.GetFragmentOperationsState()->GetSampleCoverageBits() == 0 ? GL_FALSE : GL_TRUE; break;
-    case GL_SAMPLE_BUFFERS:                     *params = mStateManager.GetFragmentOperationsState()->GetMultiSamplingEnabled(); break;
+    case GL_SAMPLES:                            *params = mWriteFBO->GetAttachmentsVkSampleCount() != VK_SAMPLE_COUNT_1_BIT ? GL_TRUE : GL_FALSE; break;
+    case GL_SAMPLE_BUFFERS:                     *params = mWriteFBO->GetAttachmentsVkSampleCount() != VK_SAMPLE_COUNT_1_BIT ? GL_TRUE : GL_FALSE; break;
     case GL_SCISSOR_BOX:                        mStateManager.GetFragmentOperationsState()->GetScissorRect(params); break;
     case GL_VIEWPORT:                           mStateManager.GetViewportTransformationState()->GetViewportRect(params); break;
     case GL_MAX_VIEWPORT_DIMS:                  params[0] = GL_TRUE;
@@ -122,6 +125,7 @@ Context::GetBooleanv(GLenum pname, GLboolean* params)
     case GL_MAX_TEXTURE_IMAGE_UNITS:
     case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
     case GL_MAX_RENDERBUFFER_SIZE:
+    case GL_MAX_SAMPLES_EXT:
     case GL_MAX_TEXTURE_SIZE:
     case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
     case GL_SHADER_COMPILER:
@@ -146,6 +150,7 @@ Context::GetIntegerv(GLenum pname, GLint* params)
     case GL_MAX_TEXTURE_IMAGE_UNITS:            *params = GLOVE_MAX_TEXTURE_IMAGE_UNITS; break;
     case GL_MAX_FRAGMENT_UNIFORM_VECTORS:       *params = GLOVE_MAX_FRAGMENT_UNIFORM_VECTORS; break;
     case GL_MAX_RENDERBUFFER_SIZE:              *params = GLOVE_MAX_RENDERBUFFER_SIZE; break;
+    case GL_MAX_SAMPLES_EXT:                    *params = static_cast<GLint>(GetMaxSupportedSampleCount(mVkContext->vkGpus[0])); break;
     case GL_MAX_TEXTURE_SIZE:                   *params = GLOVE_MAX_TEXTURE_SIZE; break;
     case GL_MAX_CUBE_MAP_TEXTURE_SIZE:          *params = GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE; break;
     case GL_MAX_VIEWPORT_DIMS:                  params[0] = GLOVE_MAX_TEXTURE_SIZE;
@@ -157,6 +162,8 @@ Context::GetIntegerv(GLenum pname, GLint* params)
     case GL_IMPLEMENTATION_COLOR_READ_TYPE:     *params = GL_UNSIGNED_BYTE; break;
     case GL_ARRAY_BUFFER_BINDING:               *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)         ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER))   : 0; break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER)) : 0; break;
+    case GL_VERTEX_ARRAY_BINDING_OES:           *params = GetVertexArrayId(mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()); break;
+    case GL_PIXEL_PACK_BUFFER_BINDING_NV:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV)) : 0; break;
     case GL_RED_BITS:                           GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), params, NULL, NULL, NULL, NULL, NULL); break;
     case GL_BLUE_BITS:                          GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, params, NULL, NULL, NULL, NULL); break;
     case GL_GREEN_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, NULL, params, NULL, NULL, NULL); break;
@@ -194,10 +201,11 @@ Context::GetIntegerv(GLenum pname, GLint* params)
                                                 params[1] = 1; break;
     case GL_ALIASED_POINT_SIZE_RANGE:           params[0] = 1;
                                                 params[1] = 1; break;
-    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = 0; break;
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = 0; break;
-    case GL_SAMPLES:                            *params = static_cast<GLint>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageBits()); break;
-    case GL_SAMPLE_BUFFERS:                     *params = mStateManager.GetFragmentOperationsState()->GetMultiSamplingEnabled(); break;
+    case GL_COMPRESSED_TEXTURE_FORMATS:         { GLint count; const GLenum *formats = GetEtcCompressedFormats(&count);
+                                                  for(GLint i = 0; i < count; ++i) { params[i] = static_cast<GLint>(formats[i]); } } break;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     GetEtcCompressedFormats(params); break;
+    case GL_SAMPLES:                            *params = mWriteFBO->GetAttachmentsVkSampleCount() != VK_SAMPLE_COUNT_1_BIT ? static_cast<GLint>(mWriteFBO->GetAttachmentsVkSampleCount()) : 0; break;
+    case GL_SAMPLE_BUFFERS:                     *params = mWriteFBO->GetAttachmentsVkSampleCount() != VK_SAMPLE_COUNT_1_BIT ? 1 : 0; break;
     case GL_SAMPLE_COVERAGE:                    *params = mStateManager.GetFragmentOperationsState()->GetSampleCoverageEnabled(); break;
     case GL_SAMPLE_COVERAGE_INVERT:             *params = static_cast<GLint>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageInvert()); break;
     case GL_SAMPLE_COVERAGE_VALUE:              *params = static_cast<GLint>(roundf(mStateManager.GetFragmentOperationsState()->GetSampleCoverageValue())); break;
@@ -262,6 +270,8 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
     case GL_DEPTH_WRITEMASK:                    *params = static_cast<GLfloat>(mStateManager.GetFramebufferOperationsState()->GetDepthMask()); break;
     case GL_DITHER:                             *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetDitheringEnabled()); break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? static_cast<GLfloat>(mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER))) : 0; break;
+    case GL_VERTEX_ARRAY_BINDING_OES:           *params = static_cast<GLfloat>(GetVertexArrayId(mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject())); break;
+    case GL_PIXEL_PACK_BUFFER_BINDING_NV:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) ? static_cast<GLfloat>(mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV))) : 0; break;
     case GL_FRAMEBUFFER_BINDING:                *params = static_cast<GLfloat>(mStateManager.GetActiveObjectsState()->GetActiveFramebufferObjectID()); break;
     case GL_FRONT_FACE:                         *params = static_cast<GLfloat>(mStateManager.GetRasterizationState()->GetFrontFace()); break;
     case GL_IMPLEMENTATION_COLOR_READ_FORMAT:   *params = GL_RGBA; break;
@@ -271,6 +281,7 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
     case GL_MAX_CUBE_MAP_TEXTURE_SIZE:          *params = GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE; break;
     case GL_MAX_FRAGMENT_UNIFORM_VECTORS:       *params = GLOVE_MAX_FRAGMENT_UNIFORM_VECTORS; break;
     case GL_MAX_RENDERBUFFER_SIZE:              *params = GLOVE_MAX_RENDERBUFFER_SIZE; break;
+    case GL_MAX_SAMPLES_EXT:                    *params = static_cast<GLfloat>(GetMaxSupportedSampleCount(mVkContext->vkGpus[0])); break;
     case GL_MAX_TEXTURE_IMAGE_UNITS:            *params = GLOVE_MAX_TEXTURE_IMAGE_UNITS; break;
     case GL_MAX_TEXTURE_SIZE:                   *params = GLOVE_MAX_TEXTURE_SIZE; break;
     case GL_MAX_VARYING_VECTORS:                *params = GLOVE_MAX_VARYING_VECTORS; break;
@@ -303,13 +314,14 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
                                                 params[1] = 1.0f; break;
     case GL_ALIASED_POINT_SIZE_RANGE:           params[0] = 1.0f;
                                                 params[1] = 1.0f; break;
-    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = 0.0f; break;
+    case GL_COMPRESSED_TEXTURE_FORMATS:         { GLint count; const GLenum *formats = GetEtcCompressedFormats(&count);
+                                                  for(GLint i = 0; i < count; ++i) { params[i] = static_cast<GLfloat>(formats[i]); } } break;
     case GL_DEPTH_RANGE:                        params[0] = mStateManager.GetViewportTransformationState()->GetMinDepthRange();
                                                 params[1] = mStateManager.GetViewportTransformationState()->GetMaxDepthRange(); break;
     case GL_GENERATE_MIPMAP_HINT:               *params = static_cast<GLfloat>(mStateManager.GetHintAspectsState()->GetMode(GL_GENERATE_MIPMAP_HINT)); break;
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = 0.0f; break;
-    case GL_SAMPLES:                            *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageBits()); break;
-    case GL_SAMPLE_BUFFERS:                     *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetMultiSamplingEnabled()); break;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     { GLint count; GetEtcCompressedFormats(&count); *params = static_cast<GLfloat>(count); } break;
+    case GL_SAMPLES:                            *params = mWriteFBO->GetAttachmentsVkSampleCount() != VK_SAMPLE_COUNT_1_BIT ? static_cast<GLfloat>(mWriteFBO->GetAttachmentsVkSampleCount()) : 0.0f; break;
+    case GL_SAMPLE_BUFFERS:                     *params = mWriteFBO->GetAttachmentsVkSampleCount() != VK_SAMPLE_COUNT_1_BIT ? 1.0f : 0.0f; break;
     case GL_SAMPLE_COVERAGE_INVERT:             *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageInvert()); break;
     case GL_SAMPLE_COVERAGE_VALUE:              *params = mStateManager.GetFragmentOperationsState()->GetSampleCoverageValue(); break;
     case GL_SHADER_COMPILER:                    *params = 1.0f; break;
@@ -29,7 +29,8 @@ Context::DepthRangef(GLclampf zNear, GLclampf zFar)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     if(mStateManager.GetViewportTransformationState()->UpdateDepthRange(zNear, zFar)) {
-        mPipeline->SetUpdateViewportState(true);
+        // gl_DepthRange is passed to the shaders through a built-in uniform
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR | vulkanAPI::Pipeline::DIRTY_DESCRIPTORS);
     }
 }
 
@@ -44,6 +45,6 @@ Context::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
     }
 
     if(mStateManager.GetViewportTransformationState()->UpdateViewportRect(x, y, width, height)) {
-        mPipeline->SetUpdateViewportState(true);
+        mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_VIEWPORT_SCISSOR);
     }
 }
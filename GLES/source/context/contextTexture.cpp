@@ -462,6 +462,11 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
         return;
     }
 
+    if(activeTexture->IsCompressed()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
     // TODO:: We could pass a default subtexture instead
     if(pixels == nullptr) {
         return;
@@ -623,6 +628,11 @@ Context::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoff
         return;
     }
 
+    if(activeTexture->IsCompressed()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
     if(mWriteFBO->IsInDrawState()) {
         Finish();
     }
@@ -685,12 +695,16 @@ Context::CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat,
         return;
     }
 
-    if(internalformat != GL_ALPHA     && internalformat != GL_RGB && internalformat != GL_RGBA &&
-       internalformat != GL_LUMINANCE && internalformat != GL_LUMINANCE_ALPHA) {
+    if(!IsEtcCompressedFormat(internalformat)) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
 
+    if((target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) && (width != height)) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
     if(level < 0 || border || (width < 0 || height < 0) ||
        ((width > GLOVE_MAX_TEXTURE_SIZE || height > GLOVE_MAX_TEXTURE_SIZE) && target == GL_TEXTURE_2D) ||
        ((width > GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE || height > GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE) && target != GL_TEXTURE_2D)) {
@@ -704,15 +718,30 @@ Context::CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat,
         return;
      }
 
+    if(imageSize < 0 || static_cast<size_t>(imageSize) != GetEtcCompressedImageSize(internalformat, width, height)) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
     if(width == 0 || height == 0) {
         return;
     }
 
-    // TODO:
-    //GL_INVALID_VALUE is generated if imageSize is not consistent with the format, dimensions, and contents of the specified compressed image data.
-    //GL_INVALID_OPERATION is generated if parameter combinations are not supported by the specific compressed internal format as specified in the specific texture compression extension.
+    if(mWriteFBO->IsInDrawState()) {
+        Finish();
+    }
 
-    NOT_IMPLEMENTED();
+    // keep the blocks as they are, they are decoded only if the device cannot sample them
+    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
+    GLint layer = (target == GL_TEXTURE_2D) ? 0 : target - GL_TEXTURE_CUBE_MAP_POSITIVE_X;
+    activeTexture->SetCompressedState(width, height, level, layer, internalformat, data);
+
+    if(activeTexture->IsCompleted()) {
+        // pass contents to the driver
+        VkFormat vkformat = activeTexture->FindSupportedVkCompressedFormat(GlCompressedFormatToVkFormat(internalformat));
+        activeTexture->SetVkFormat(vkformat);
+        activeTexture->Allocate();
+    }
 }
 
 void
@@ -725,34 +754,53 @@ Context::CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLin
         return;
     }
 
-    if(format != GL_ALPHA     && format != GL_RGB && format != GL_RGBA &&
-       format != GL_LUMINANCE && format != GL_LUMINANCE_ALPHA) {
+    if(!IsEtcCompressedFormat(format)) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
 
-    if(level < 0 || width < 0 || height < 0 ||
+    if(level < 0 || width < 0 || height < 0 || xoffset < 0 || yoffset < 0 ||
        ((width > GLOVE_MAX_TEXTURE_SIZE || height > GLOVE_MAX_TEXTURE_SIZE) && target == GL_TEXTURE_2D) ||
        ((width > GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE || height > GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE) && target != GL_TEXTURE_2D)) {
         RecordError(GL_INVALID_VALUE);
         return;
     }
 
-    Texture *tex = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
-    if(tex->GetWidth()  < (xoffset + width ) ||
-       tex->GetHeight() < (yoffset + height)) {
+    if(imageSize < 0 || static_cast<size_t>(imageSize) != GetEtcCompressedImageSize(format, width, height)) {
         RecordError(GL_INVALID_VALUE);
         return;
     }
 
-    if(tex->GetFormat() != format) {
+    // the region is checked against the level being updated, which must hold a compressed image
+    Texture *tex = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
+    GLint layer = (target == GL_TEXTURE_2D) ? 0 : target - GL_TEXTURE_CUBE_MAP_POSITIVE_X;
+    GLint levelWidth, levelHeight;
+    GLenum levelFormat;
+    if(!tex->GetCompressedLevelSize(level, layer, &levelWidth, &levelHeight, &levelFormat) || levelFormat != format) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
 
-    // TODO:
-    //GL_INVALID_VALUE is generated if imageSize is not consistent with the format, dimensions, and contents of the specified compressed image data.
-    //GL_INVALID_OPERATION is generated if parameter combinations are not supported by the specific compressed internal format as specified in the specific texture compression extension.
+    GLenum err = ValidateEtcSubImage(levelWidth, levelHeight, xoffset, yoffset, width, height);
+    if(err != GL_NO_ERROR) {
+        RecordError(err);
+        return;
+    }
+
+    if(!width || !height || data == nullptr) {
+        return;
+    }
+
+    if(mWriteFBO->IsInDrawState()) {
+        Finish();
+    }
 
-    NOT_IMPLEMENTED();
+    tex->SetCompressedSubState(xoffset, yoffset, width, height, level, layer, data);
+
+    if(tex->IsCompleted()) {
+        // pass contents to the driver
+        VkFormat vkformat = tex->FindSupportedVkCompressedFormat(GlCompressedFormatToVkFormat(format));
+        tex->SetVkFormat(vkformat);
+        tex->Allocate();
+    }
 }
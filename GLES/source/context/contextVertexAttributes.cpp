@@ -33,7 +33,7 @@ Context::GetVertexAttribfv(GLuint index, GLenum pname, GLfloat* params)
         return;
     }
 
-    const GenericVertexAttribute* gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    const GenericVertexAttribute* gVertexAttrib = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index);
 
     switch(pname) {
     case GL_VERTEX_ATTRIB_ARRAY_ENABLED:        *params = static_cast<GLfloat>(gVertexAttrib->IsEnabled());     break;
@@ -60,7 +60,7 @@ Context::GetVertexAttribiv(GLuint index, GLenum pname, GLint* params)
         return;
     }
 
-    const GenericVertexAttribute* gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    const GenericVertexAttribute* gVertexAttrib = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index);
 
     switch(pname) {
     case GL_VERTEX_ATTRIB_ARRAY_ENABLED:        *params = static_cast<GLint>(gVertexAttrib->IsEnabled());          break;
@@ -92,7 +92,7 @@ Context::GetVertexAttribPointerv(GLuint index, GLenum pname, void **pointer)
         return;
     }
 
-    *pointer = reinterpret_cast<void *>(mResourceManager->GetGenericVertexAttribute(index)->GetPointer());
+    *pointer = reinterpret_cast<void *>(mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->GetPointer());
 }
 
 void
@@ -106,8 +106,7 @@ Context::VertexAttrib1f(GLuint index, GLfloat x)
     }
 
     GLfloat vals[4] = {x, 0.0f, 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -121,8 +120,7 @@ Context::VertexAttrib1fv(GLuint index, const GLfloat* values)
     }
 
     GLfloat vals[4] = {values[0], 0.0f, 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -136,8 +134,7 @@ Context::VertexAttrib2f(GLuint index, GLfloat x, GLfloat y)
     }
 
     GLfloat vals[4] = {x, y, 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -151,8 +148,7 @@ Context::VertexAttrib2fv(GLuint index, const GLfloat* values)
     }
 
     GLfloat vals[4] = {values[0], values[1], 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -166,8 +162,7 @@ Context::VertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z)
     }
 
     GLfloat vals[4] = {x, y, z, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -181,8 +176,7 @@ Context::VertexAttrib3fv(GLuint index, const GLfloat* values)
     }
 
     GLfloat vals[4] = {values[0], values[1], values[2], 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -196,8 +190,7 @@ Context::VertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w
     }
 
     GLfloat vals[4] = {x, y, z, w};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(vals);
 }
 
 void
@@ -210,8 +203,7 @@ Context::VertexAttrib4fv(GLuint index, const GLfloat* values)
         return;
     }
 
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(values);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject()->GetGenericVertexAttribute(index)->SetGenericValue(values);
 }
 
 void
@@ -224,11 +216,12 @@ Context::EnableVertexAttribArray(GLuint index)
         return;
     }
 
-    GenericVertexAttribute *gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    VertexArrayObject *vao = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject();
+    GenericVertexAttribute *gVertexAttrib = vao->GetGenericVertexAttribute(index);
 
     if(!gVertexAttrib->IsEnabled()) {
         gVertexAttrib->SetEnabled(true);
-        mPipeline->SetUpdateVertexAttribVBOs(true);
+        vao->SetUpdateVertexInput(true);
     }
 }
 
@@ -242,11 +235,12 @@ Context::DisableVertexAttribArray(GLuint index)
         return;
     }
 
-    GenericVertexAttribute *gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    VertexArrayObject *vao = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject();
+    GenericVertexAttribute *gVertexAttrib = vao->GetGenericVertexAttribute(index);
 
     if(gVertexAttrib->IsEnabled()) {
         gVertexAttrib->SetEnabled(false);
-        mPipeline->SetUpdateVertexAttribVBOs(true);
+        vao->SetUpdateVertexInput(true);
     }
 }
 
@@ -267,6 +261,151 @@ Context::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean no
 
     BufferObject* attachedVBO = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER);
     bool requiresInternalVBO = attachedVBO == nullptr;
-    mResourceManager->GetGenericVertexAttribute(index)->Set(size, type, normalized, stride, ptr, attachedVBO, requiresInternalVBO);
-    mPipeline->SetUpdateVertexAttribVBOs(true);
+    VertexArrayObject *vao = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject();
+    vao->GetGenericVertexAttribute(index)->Set(size, type, normalized, stride, ptr, attachedVBO, requiresInternalVBO);
+    vao->SetUpdateVertexInput(true);
+}
+
+void
+Context::BindVertexArrayOES(GLuint array)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // only names returned by GenVertexArraysOES and not deleted since can be bound
+    if(array != 0 && !mVertexArrays.ObjectExists(array)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    VertexArrayObject *activeVao = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject();
+    VertexArrayObject *vao       = GetVertexArray(array);
+    if(vao == activeVao) {
+        return;
+    }
+
+    // the element array buffer binding is part of the vao state,
+    // while the current generic values remain context state
+    activeVao->SetElementArrayBuffer(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER));
+    vao->SetGenericValues(activeVao);
+
+    mStateManager.GetActiveObjectsState()->SetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER, vao->GetElementArrayBuffer());
+    mStateManager.GetActiveObjectsState()->SetActiveVertexArrayObject(vao);
+
+    mPipeline->SetVertexInputState(vao->GetVkPipelineVertexInput());
+    mPipeline->SetDirty(vulkanAPI::Pipeline::DIRTY_INDEX_BUFFER);
+}
+
+void
+Context::DeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(n < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(arrays == nullptr) {
+        return;
+    }
+
+    if(mWriteFBO->IsInDrawState()) {
+        Finish();
+    }
+
+    while(n-- != 0) {
+        uint32_t array = *arrays++;
+
+        if(array && mVertexArrays.ObjectExists(array)) {
+
+            VertexArrayObject *vao = GetVertexArray(array);
+            if(mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject() == vao) {
+                BindVertexArrayOES(0);
+            }
+
+            BufferObject *ibo = vao->GetElementArrayBuffer();
+            if(ibo && mResourceManager->GetBufferID(ibo)) {
+                ibo->Unbind();
+            }
+            mVertexArrays.Deallocate(array);
+        }
+    }
+    mResourceManager->CleanPurgeList();
+}
+
+void
+Context::GenVertexArraysOES(GLsizei n, GLuint *arrays)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(n < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(arrays == nullptr) {
+        return;
+    }
+
+    while(n != 0) {
+        uint32_t array = mVertexArrays.Allocate();
+        VertexArrayObject *vao = mVertexArrays.GetObject(array);
+        vao->SetVkContext(mVkContext);
+        vao->SetCacheManager(mCacheManager);
+
+        *arrays++ = array;
+        --n;
+    }
+}
+
+GLboolean
+Context::IsVertexArrayOES(GLuint array)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    return (array != 0 && mVertexArrays.ObjectExists(array)) ? GL_TRUE : GL_FALSE;
+}
+
+VertexArrayObject *
+Context::GetVertexArray(GLuint array)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(!array) {
+        return mDefaultVertexArray;
+    }
+
+    // vertex array objects are created by GenVertexArraysOES, callers check that the name exists
+    return mVertexArrays.GetObject(array);
+}
+
+uint32_t
+Context::GetVertexArrayId(const VertexArrayObject *vao)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return vao == mDefaultVertexArray ? 0 : mVertexArrays.GetObjectId(vao);
+}
+
+void
+Context::DetachElementArrayBuffer(BufferObject *bo)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the element array binding of the active vao is held by the active objects state
+    const VertexArrayObject *activeVao = mStateManager.GetActiveObjectsState()->GetActiveVertexArrayObject();
+
+    std::vector<VertexArrayObject *> vaos = {mDefaultVertexArray};
+    for(auto vao : mVertexArrays.GetObjectList()) {
+        if(vao != nullptr) {
+            vaos.push_back(vao);
+        }
+    }
+
+    for(auto vao : vaos) {
+        if(vao != activeVao && vao->GetElementArrayBuffer() == bo) {
+            bo->Unbind();
+            vao->SetElementArrayBuffer(nullptr);
+        }
+    }
 }
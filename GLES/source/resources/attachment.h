@@ -33,6 +33,7 @@ private:
     uint32_t                mName;
     GLint                   mLevel;
     GLenum                  mLayer;
+    GLsizei                 mSamples;
     Texture *               mTexture;
 
 public:
@@ -44,6 +45,7 @@ public:
     inline uint32_t         GetName(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mName;     }
     inline GLint            GetLevel(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mLevel;    }
     inline GLenum           GetLayer(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mLayer;    }
+    inline GLsizei          GetSamples(void)                            const   { FUN_ENTRY(GL_LOG_TRACE); return mSamples; }
     inline Texture *        GetTexture(void)                            const   { FUN_ENTRY(GL_LOG_TRACE); return mTexture;  }
 
 // Set Functions
@@ -51,6 +53,7 @@ public:
     inline void             SetName(uint32_t name)                              { FUN_ENTRY(GL_LOG_TRACE); mName    = name;  }
     inline void             SetLevel(GLint level)                               { FUN_ENTRY(GL_LOG_TRACE); mLevel   = level; }
     inline void             SetLayer(GLenum layer)                              { FUN_ENTRY(GL_LOG_TRACE); mLayer   = layer; }
+    inline void             SetSamples(GLsizei samples)                         { FUN_ENTRY(GL_LOG_TRACE); mSamples = samples; }
     inline void             SetTexture(Texture *tex)                            { FUN_ENTRY(GL_LOG_TRACE); mTexture = tex;   }
 };
 
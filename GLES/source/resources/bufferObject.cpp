@@ -28,9 +28,11 @@
  */
 
 #include "bufferObject.h"
+#include "context/context.h"
 
 BufferObject::BufferObject(const vulkanAPI::vkContext_t *vkContext, const VkBufferUsageFlags vkBufferUsageFlags, const VkSharingMode vkSharingMode, const VkFlags vkFlags)
-: mVkContext(vkContext), mUsage(GL_STATIC_DRAW), mTarget(GL_INVALID_VALUE), mAllocated(false)
+: mVkContext(vkContext), mUsage(GL_STATIC_DRAW), mTarget(GL_INVALID_VALUE), mAllocated(false),
+mMapAccess(0), mMapOffset(0), mMapLength(0), mMapPointer(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -44,6 +46,13 @@ BufferObject::~BufferObject()
 
     delete mBuffer;
     delete mMemory;
+
+    // buffers are only deleted once the GPU is idle
+    for(auto &storage : mRetiredStorage) {
+        delete storage.buffer;
+        delete storage.memory;
+    }
+    mRetiredStorage.clear();
 }
 
 void
@@ -53,7 +62,11 @@ BufferObject::Release()
 
     mBuffer->Release();
     mMemory->Release();
-    mAllocated = false;
+    mAllocated  = false;
+    mMapAccess  = 0;
+    mMapOffset  = 0;
+    mMapLength  = 0;
+    mMapPointer = nullptr;
 }
 
 bool
@@ -87,6 +100,100 @@ BufferObject::UpdateData(size_t size, size_t offset, const void *data)
     mMemory->UpdateData(size, offset, data);
 }
 
+void *
+BufferObject::Map(size_t offset, size_t length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the memory is host visible, hand out a pointer into its persistent mapping
+    uint8_t *data = static_cast<uint8_t *>(mMemory->Map());
+    if(data == nullptr) {
+        return nullptr;
+    }
+
+    if(access & GL_MAP_READ_BIT_EXT) {
+        mMemory->InvalidateMappedData();
+    }
+
+    mMapAccess  = access;
+    mMapOffset  = offset;
+    mMapLength  = length;
+    mMapPointer = data + offset;
+
+    return mMapPointer;
+}
+
+bool
+BufferObject::Unmap(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // with GL_MAP_FLUSH_EXPLICIT_BIT_EXT the application has flushed the modified ranges itself
+    bool res = true;
+    if((mMapAccess & GL_MAP_WRITE_BIT_EXT) && !(mMapAccess & GL_MAP_FLUSH_EXPLICIT_BIT_EXT)) {
+        res = mMemory->FlushMappedData(mMapOffset, mMapLength);
+    }
+
+    // the memory itself stays mapped for the next Map()
+    mMapAccess  = 0;
+    mMapOffset  = 0;
+    mMapLength  = 0;
+    mMapPointer = nullptr;
+
+    return res;
+}
+
+bool
+BufferObject::FlushMappedRange(size_t offset, size_t length)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the range is relative to the mapped range
+    return mMemory->FlushMappedData(mMapOffset + offset, length);
+}
+
+bool
+BufferObject::Orphan(uint64_t deviceSerial)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // keep the current storage alive until the submission that may still
+    // read it has completed, and continue with fresh storage of the same size.
+    // The buffer may be shared, so the submission is identified by its device-wide serial
+    retiredStorage_t storage;
+    storage.buffer       = mBuffer;
+    storage.memory       = mMemory;
+    storage.deviceSerial = deviceSerial;
+    mRetiredStorage.push_back(storage);
+
+    size_t size = mBuffer->GetSize();
+    mBuffer = new vulkanAPI::Buffer(mVkContext, storage.buffer->GetFlags(), storage.buffer->GetSharingMode());
+    mMemory = new vulkanAPI::Memory(mVkContext, storage.memory->GetFlags());
+    mAllocated = false;
+
+    return Allocate(size, nullptr);
+}
+
+void
+BufferObject::ReleaseRetiredStorage(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(GetCurrentContext());
+    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
+
+    auto it = mRetiredStorage.begin();
+    while(it != mRetiredStorage.end()) {
+        if(commandBufferManager->IsDeviceSerialCompleted(it->deviceSerial)) {
+            delete it->buffer;
+            delete it->memory;
+            it = mRetiredStorage.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void
 BufferObject::SetTarget(GLenum target)
 {
@@ -110,6 +217,10 @@ BufferObject::SetTarget(GLenum target)
         mBuffer->SetFlags(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
     } else if(target == GL_ELEMENT_ARRAY_BUFFER) {
         mBuffer->SetFlags(VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    } else if(target == GL_PIXEL_PACK_BUFFER_NV) {
+        // pack buffers are written by the host once a readback completes, so they
+        // only need the flags for being sourced later as vertex or index data
+        mBuffer->SetFlags(static_cast<VkBufferUsageFlags>(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT));
     }
     mTarget = target;
 }
@@ -29,6 +29,7 @@
 #include "vulkan/buffer.h"
 #include "vulkan/memory.h"
 #include "refObject.h"
+#include <vector>
 
 class BufferObject : public refObject {
 private:
@@ -41,6 +42,20 @@ private:
 
     vulkanAPI::Memory*      mMemory;
 
+    // GL_OES_mapbuffer/GL_EXT_map_buffer_range state
+    GLbitfield              mMapAccess;
+    size_t                  mMapOffset;
+    size_t                  mMapLength;
+    void*                   mMapPointer;
+
+    // storage replaced by Orphan() while it may still be in use by the GPU
+    typedef struct retiredStorage_t {
+        vulkanAPI::Buffer*  buffer;
+        vulkanAPI::Memory*  memory;
+        uint64_t            deviceSerial;
+    } retiredStorage_t;
+    std::vector<retiredStorage_t> mRetiredStorage;
+
 protected:
     vulkanAPI::Buffer*      mBuffer;
 
@@ -60,6 +75,13 @@ public:
 // Update Functions
     void                    UpdateData(size_t size, size_t offset, const void *data);
 
+// Map Functions
+    void *                  Map(size_t offset, size_t length, GLbitfield access);
+    bool                    Unmap(void);
+    bool                    FlushMappedRange(size_t offset, size_t length);
+    bool                    Orphan(uint64_t deviceSerial);
+    void                    ReleaseRetiredStorage(void);
+
 // Get Functions
     bool                    GetData(size_t size,
                                     size_t offset, void *data)          const;
@@ -67,6 +89,10 @@ public:
     inline GLenum           GetTarget(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mTarget; }
     inline size_t           GetSize(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetSize(); }
     inline VkBuffer         GetVkBuffer(void)                                   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetVkBuffer(); }
+    inline GLbitfield       GetMapAccess(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapAccess;  }
+    inline size_t           GetMapOffset(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapOffset;  }
+    inline size_t           GetMapLength(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapLength;  }
+    inline void *           GetMapPointer(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mMapPointer; }
 
 // Set Functions
     void                    SetTarget(GLenum target);
@@ -77,6 +103,7 @@ public:
 // Has/Is Functions
     inline bool             HasData(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetVkBuffer() != VK_NULL_HANDLE; }
     inline bool             IsIndexBuffer(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetFlags() & VK_BUFFER_USAGE_INDEX_BUFFER_BIT; }
+    inline bool             IsMapped(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mMapPointer != nullptr; }
 };
 
 class IndexBufferObject : public BufferObject
@@ -34,7 +34,11 @@
 Framebuffer::Framebuffer(const vulkanAPI::vkContext_t *vkContext)
 : mVkContext(vkContext),
 mTarget(GL_INVALID_VALUE), mState(IDLE),
-mUpdated(true), mSizeUpdated(false), mDepthStencilTexture(nullptr),
+mUpdated(true), mSizeUpdated(false),
+mRenderPass(nullptr), mStartedRenderPass(nullptr), mStartedFramebuffer(VK_NULL_HANDLE), mFramebuffers(nullptr),
+mDepthStencilTexture(nullptr),
+mSamples(VK_SAMPLE_COUNT_1_BIT), mMultisampleColorTexture(nullptr),
+mColorDiscarded(false), mDepthDiscarded(false), mStencilDiscarded(false), mMultisampleDiscarded(false),
 mBindToTexture(false), mSurfaceType(GLOVE_SURFACE_INVALID),
 mIsSystem(false), mEGLSurfaceInterface(nullptr),
 mCacheColorTexture(nullptr), mCacheDepthTexture(nullptr), mCacheStencilTexture(nullptr),
@@ -42,7 +46,6 @@ mCacheColorRenderbuffer(nullptr), mCacheDepthRenderbuffer(nullptr), mCacheStenci
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    mRenderPass           = new vulkanAPI::RenderPass(vkContext);
     mAttachmentDepth      = new Attachment();
     mAttachmentStencil    = new Attachment();
 }
@@ -51,7 +54,6 @@ Framebuffer::~Framebuffer()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    delete mRenderPass;
     delete mAttachmentDepth;
     delete mAttachmentStencil;
 
@@ -64,6 +66,11 @@ Framebuffer::~Framebuffer()
         mDepthStencilTexture = nullptr;
     }
 
+    if(mMultisampleColorTexture != nullptr) {
+        delete mMultisampleColorTexture;
+        mMultisampleColorTexture = nullptr;
+    }
+
     for(auto color : mAttachmentColors) {
         if(color) {
             delete color;
@@ -73,6 +80,7 @@ Framebuffer::~Framebuffer()
     mAttachmentColors.clear();
 
     Release();
+    ReleaseRenderPasses();
 }
 
 void
@@ -80,11 +88,29 @@ Framebuffer::Release(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(auto fb : mFramebuffers) {
-        delete fb;
-        fb = nullptr;
+    // framebuffers of all cached render passes refer to the current attachments
+    for(auto &entry : mRenderPassCache) {
+        for(auto fb : entry.second.framebuffers) {
+            delete fb;
+            fb = nullptr;
+        }
+        entry.second.framebuffers.clear();
     }
-    mFramebuffers.clear();
+}
+
+void
+Framebuffer::ReleaseRenderPasses(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto &entry : mRenderPassCache) {
+        delete entry.second.renderPass;
+    }
+    mRenderPassCache.clear();
+
+    mRenderPass        = nullptr;
+    mStartedRenderPass = nullptr;
+    mFramebuffers      = nullptr;
 }
 
 size_t
@@ -190,6 +216,54 @@ Framebuffer::GetStencilAttachmentTexture(void) const
     return tex;
 }
 
+GLsizei
+Framebuffer::GetAttachmentSamples(GLenum attachment) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(mIsSystem) {
+        return mSamples != VK_SAMPLE_COUNT_1_BIT ? static_cast<GLsizei>(mSamples) : 0;
+    }
+
+    Attachment   *att    = nullptr;
+    Renderbuffer *cached = nullptr;
+    switch(attachment) {
+    case GL_COLOR_ATTACHMENT0:  att = mAttachmentColors.size() ? mAttachmentColors[0] : nullptr; cached = mCacheColorRenderbuffer;   break;
+    case GL_DEPTH_ATTACHMENT:   att = mAttachmentDepth;                                           cached = mCacheDepthRenderbuffer;   break;
+    case GL_STENCIL_ATTACHMENT: att = mAttachmentStencil;                                         cached = mCacheStencilRenderbuffer; break;
+    default:                    return 0;
+    }
+
+    if(att == nullptr || !att->GetName()) {
+        return 0;
+    }
+
+    if(att->GetType() == GL_TEXTURE) {
+        return att->GetSamples();
+    } else if(att->GetType() == GL_RENDERBUFFER) {
+        return cached ? cached->GetSamples() : mRenderbufferArray->GetObject(att->GetName())->GetSamples();
+    }
+
+    return 0;
+}
+
+VkSampleCountFlagBits
+Framebuffer::GetAttachmentsVkSampleCount(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // a complete framebuffer has the same number of samples in all its attachments
+    GLsizei samples = GetAttachmentSamples(GL_COLOR_ATTACHMENT0);
+    if(!samples) {
+        samples = GetAttachmentSamples(GL_DEPTH_ATTACHMENT);
+    }
+    if(!samples) {
+        samples = GetAttachmentSamples(GL_STENCIL_ATTACHMENT);
+    }
+
+    return samples > 1 ? static_cast<VkSampleCountFlagBits>(samples) : VK_SAMPLE_COUNT_1_BIT;
+}
+
 void
 Framebuffer::AddColorAttachment(Texture *texture)
 {
@@ -272,27 +346,89 @@ Framebuffer::CheckStatus(void)
         }
     }
 
+    const GLenum attachments[] = {GL_COLOR_ATTACHMENT0, GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT};
+    GLsizei samples = -1;
+    for(GLenum attachment : attachments) {
+        if(GetAttachmentName(attachment)) {
+            GLsizei attachmentSamples = GetAttachmentSamples(attachment);
+            if(samples != -1 && samples != attachmentSamples) {
+                return GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE_EXT;
+            }
+            samples = attachmentSamples;
+        }
+    }
+
     return GL_FRAMEBUFFER_COMPLETE;
 }
 
+Framebuffer::renderPassCache_t::iterator
+Framebuffer::FindRenderPass(const renderPassKey_t &key)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    renderPassCache_t::iterator it = mRenderPassCache.find(key);
+    if(it != mRenderPassCache.end()) {
+        return it;
+    }
+
+    vulkanAPI::RenderPass *renderPass = new vulkanAPI::RenderPass(mVkContext);
+
+    renderPass->SetColorClearEnabled(key.flags & (1 << 0));
+    renderPass->SetDepthClearEnabled(key.flags & (1 << 1));
+    renderPass->SetStencilClearEnabled(key.flags & (1 << 2));
+
+    renderPass->SetColorWriteEnabled(key.flags & (1 << 3));
+    renderPass->SetDepthWriteEnabled(key.flags & (1 << 4));
+    renderPass->SetStencilWriteEnabled(key.flags & (1 << 5));
+
+    renderPass->SetColorLoadDiscardEnabled(key.flags & (1 << 6));
+    renderPass->SetDepthLoadDiscardEnabled(key.flags & (1 << 7));
+    renderPass->SetStencilLoadDiscardEnabled(key.flags & (1 << 8));
+
+    renderPass->SetColorStoreDiscardEnabled(key.flags & (1 << 9));
+    renderPass->SetDepthStoreDiscardEnabled(key.flags & (1 << 10));
+    renderPass->SetStencilStoreDiscardEnabled(key.flags & (1 << 11));
+
+    renderPass->SetMultisampleLoadDiscardEnabled(key.flags & (1 << 12));
+    renderPass->SetMultisampleStoreDiscardEnabled(key.flags & (1 << 13));
+
+    renderPass->SetSampleCount(key.samples);
+
+    if(!renderPass->Create(key.colorFormat, key.depthStencilFormat)) {
+        delete renderPass;
+        return mRenderPassCache.end();
+    }
+
+    renderPassEntry_t entry;
+    entry.renderPass = renderPass;
+    return mRenderPassCache.insert(std::make_pair(key, entry)).first;
+}
+
 bool
 Framebuffer::CreateVkRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
                                 bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mRenderPass->SetColorClearEnabled(clearColorEnabled);
-    mRenderPass->SetDepthClearEnabled(clearDepthEnabled);
-    mRenderPass->SetStencilClearEnabled(clearStencilEnabled);
+    renderPassKey_t key;
+    key.colorFormat        = GetColorAttachmentTexture() ? GetColorAttachmentTexture()->GetVkFormat() : VK_FORMAT_UNDEFINED;
+    key.depthStencilFormat = mDepthStencilTexture        ? mDepthStencilTexture->GetVkFormat()        : VK_FORMAT_UNDEFINED;
+    key.samples            = mSamples;
+    key.flags              = (clearColorEnabled   << 0) | (clearDepthEnabled << 1) | (clearStencilEnabled << 2) |
+                             (writeColorEnabled   << 3) | (writeDepthEnabled << 4) | (writeStencilEnabled << 5) |
+                             (mColorDiscarded     << 6) | (mDepthDiscarded   << 7) | (mStencilDiscarded   << 8) |
+                             (mMultisampleDiscarded << 12);
+
+    renderPassCache_t::iterator it = FindRenderPass(key);
+    if(it == mRenderPassCache.end()) {
+        return false;
+    }
 
-    mRenderPass->SetColorWriteEnabled(writeColorEnabled);
-    mRenderPass->SetDepthWriteEnabled(writeDepthEnabled);
-    mRenderPass->SetStencilWriteEnabled(writeStencilEnabled);
+    mRenderPass           = it->second.renderPass;
+    mFramebuffers         = &it->second.framebuffers;
+    mStartedRenderPassKey = key;
 
-    return mRenderPass->Create(GetColorAttachmentTexture() ?
-                               GetColorAttachmentTexture()->GetVkFormat() : VK_FORMAT_UNDEFINED,
-                               mDepthStencilTexture ?
-                               mDepthStencilTexture->GetVkFormat() : VK_FORMAT_UNDEFINED);
+    return true;
 }
 
 void
@@ -302,7 +438,8 @@ Framebuffer::CreateDepthStencilTexture(void)
 
     if(GetDepthAttachmentTexture() || GetStencilAttachmentTexture()) {
        
-        if(!mIsSystem && GetDepthAttachmentTexture() && GetDepthAttachmentTexture()->GetDepthStencilTexture()) {
+        if(!mIsSystem && GetDepthAttachmentTexture() && GetDepthAttachmentTexture()->GetDepthStencilTexture() &&
+           GetDepthAttachmentTexture()->GetDepthStencilTexture()->GetVkImageSamples() == mSamples) {
            mDepthStencilTexture = GetDepthAttachmentTexture()->GetDepthStencilTexture();
            mDepthStencilTexture->IncreaseDepthStencilTextureRefCount();
            return;
@@ -325,6 +462,7 @@ Framebuffer::CreateDepthStencilTexture(void)
         mDepthStencilTexture->SetVkFormat(vkformat);
         mDepthStencilTexture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
         mDepthStencilTexture->SetVkImageLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        mDepthStencilTexture->SetVkImageSamples(mSamples);
         mDepthStencilTexture->SetVkImageTiling();
         GLenum glformat = VkFormatToGlInternalformat(mDepthStencilTexture->GetVkFormat());
         mDepthStencilTexture->InitState();
@@ -339,56 +477,48 @@ Framebuffer::CreateDepthStencilTexture(void)
     }
 }
 
-void
-Framebuffer::UpdateClearDepthStencilTexture(uint32_t clearStencil, uint32_t stencilMaskFront, const Rect& clearRect)
+bool
+Framebuffer::CreateMultisampleColorTexture(void)
 {
-    GLenum glFormat = VkFormatToGlInternalformat(mDepthStencilTexture->GetVkFormat());
-    size_t numElements = GlInternalFormatTypeToNumElements(glFormat, mDepthStencilTexture->GetExplicitType());
-    ImageRect srcRect(clearRect, numElements, 1, Texture::GetDefaultInternalAlignment());
-
-    ImageRect dstRect = srcRect;
-    dstRect.x = 0;
-    dstRect.y = 0;
-    size_t dstByteSize = dstRect.GetRectBufferSize();
-    uint8_t* dstData = new uint8_t[dstByteSize];
-
-    //retrieve the stored stencil data
-    mDepthStencilTexture->SetDataNoInvertion(true);
-    mDepthStencilTexture->SetImageBufferCopyStencil(true);
-    mDepthStencilTexture->CopyPixelsToHost(&srcRect, &dstRect, 0, 0, glFormat, dstData);
-
-    // size of an entire row in bytes
-    uint32_t dataRowStride = dstRect.GetRectAlignedRowInBytes();
-
-    // rectangle offset in the memory block
-    uint32_t dataCurrentRowIndex = dstRect.GetStartRowIndex(dataRowStride);
+    FUN_ENTRY(GL_LOG_DEBUG);
 
-    // obtain ptr locations with the byte offset
-    uint8_t* dataPtr = static_cast<uint8_t*>(dstData) + dataCurrentRowIndex;
+    Texture *colorTexture = GetColorAttachmentTexture();
 
-    GLint depthBits = 0;
-    GLint stencilBits = 0;
-    GlFormatToStorageBits(glFormat, nullptr, nullptr, nullptr, nullptr, &depthBits, &stencilBits);
-    assert(stencilBits > 0);
+    if(mSamples == VK_SAMPLE_COUNT_1_BIT || colorTexture == nullptr) {
+        if(mMultisampleColorTexture != nullptr) {
+            delete mMultisampleColorTexture;
+            mMultisampleColorTexture = nullptr;
+        }
+        return true;
+    }
 
-    // perform the conversion
-    for(int row = 0; row < srcRect.height; ++row) {
-        for(int col = 0; col < srcRect.width; ++col) {
-            uint32_t dataIndex = col * srcRect.GetPixelByteOffset();
-            uint8_t oldStencilValue = dataPtr[dataIndex];
-            uint8_t newStencilValue = (clearStencil & 0xFF) | ((oldStencilValue & 0xFF) & (~(stencilMaskFront & 0xFF)));
+    if(mMultisampleColorTexture                                                      &&
+       mMultisampleColorTexture->GetVkFormat()       == colorTexture->GetVkFormat() &&
+       mMultisampleColorTexture->GetVkImageSamples() == mSamples                    &&
+       mMultisampleColorTexture->GetWidth()          == GetWidth()                  &&
+       mMultisampleColorTexture->GetHeight()         == GetHeight()) {
+        return true;
+    }
 
-            dataPtr[dataIndex] = newStencilValue;
-        }
-        // offset by the number of bytes per row
-        dataPtr = dataPtr + dataRowStride;
+    if(mMultisampleColorTexture != nullptr) {
+        delete mMultisampleColorTexture;
     }
 
-    //update the stencil data
-    mDepthStencilTexture->CopyPixelsFromHost(&dstRect, &srcRect, 0, 0, glFormat, dstData);
-    mDepthStencilTexture->SetImageBufferCopyStencil(false);
+    // rendering happens in this image, the color attachment texture only
+    // receives the resolved contents at the end of the render pass
+    mMultisampleColorTexture = new Texture(mVkContext);
+    mMultisampleColorTexture->SetTarget(GL_TEXTURE_2D);
+    mMultisampleColorTexture->SetVkFormat(colorTexture->GetVkFormat());
+    mMultisampleColorTexture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                                                                 VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT));
+    mMultisampleColorTexture->SetVkImageSamples(mSamples);
+    mMultisampleColorTexture->SetVkImageTiling();
+    GLenum glformat = VkFormatToGlInternalformat(colorTexture->GetVkFormat());
+    mMultisampleColorTexture->InitState();
+    mMultisampleColorTexture->SetState(GetWidth(), GetHeight(), 0, 0, GlInternalFormatToGlFormat(glformat),
+                                       GlInternalFormatToGlType(glformat), Texture::GetDefaultInternalAlignment(), nullptr);
 
-    delete[] dstData;
+    return mMultisampleColorTexture->Allocate();
 }
 
 void
@@ -611,7 +741,16 @@ Framebuffer::GetActiveVkFramebuffer() const
     FUN_ENTRY(GL_LOG_TRACE);
 
     size_t bufferIndex = mIsSystem ? mEGLSurfaceInterface->nextImageIndex : 0;
-    return mFramebuffers[bufferIndex]->GetFramebuffer();
+    return (*mFramebuffers)[bufferIndex]->GetFramebuffer();
+}
+
+VkRenderPass *
+Framebuffer::GetVkRenderPass(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // no render pass is selected from the cache before the first one begins
+    return mRenderPass ? mRenderPass->GetRenderPass() : nullptr;
 }
 
 void
@@ -622,25 +761,41 @@ Framebuffer::CreateRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bo
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mUpdated || mSizeUpdated ||
-       static_cast<bool>(mRenderPass->GetColorClearEnabled())   != clearColorEnabled    ||
-       static_cast<bool>(mRenderPass->GetDepthClearEnabled())   != clearDepthEnabled    ||
-       static_cast<bool>(mRenderPass->GetStencilClearEnabled()) != clearStencilEnabled  ||
-       static_cast<bool>(mRenderPass->GetColorWriteEnabled())   != writeColorEnabled    ||
-       static_cast<bool>(mRenderPass->GetDepthWriteEnabled())   != writeDepthEnabled    ||
-       static_cast<bool>(mRenderPass->GetStencilWriteEnabled()) != writeStencilEnabled) {
+    if(mUpdated || mSizeUpdated) {
+        if(!mIsSystem) {
+            VkSampleCountFlagBits samples = GetAttachmentsVkSampleCount();
+            if(samples != mSamples) {
+                mSamples     = samples;
+                mSizeUpdated = true;
+            }
+        }
 
         if(!mIsSystem && mSizeUpdated) {
             CreateDepthStencilTexture();
             mSizeUpdated = false;
         }
-        CreateVkRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
-                           writeColorEnabled, writeDepthEnabled, writeStencilEnabled);
-        Create();
 
+        // the attachments have changed, framebuffers of all cached render passes are stale
+        Release();
         mUpdated = false;
     }
 
+    // switching load/store operations is a lookup, framebuffers are only
+    // created the first time a render pass is used with the current attachments
+    if(!CreateVkRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
+                           writeColorEnabled, writeDepthEnabled, writeStencilEnabled)) {
+        return;
+    }
+    // discarded contents are not loaded, anything rendered from now on is defined again
+    mColorDiscarded       = false;
+    mDepthDiscarded       = false;
+    mStencilDiscarded     = false;
+    mMultisampleDiscarded = false;
+
+    if(mFramebuffers->empty()) {
+        Create();
+    }
+
 
     const VkRect2D clearRect2D = { {clearRect->x, clearRect->y},
                                    {(uint32_t)clearRect->width, (uint32_t)clearRect->height}};
@@ -659,7 +814,17 @@ Framebuffer::BeginVkRenderPass()
     vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
     VkCommandBuffer activeCmdBuffer = commandBufferManager->GetActiveCommandBuffer();
     size_t bufferIndex = GetCurrentBufferIndex();
-    mRenderPass->Begin(&activeCmdBuffer, mFramebuffers[bufferIndex]->GetFramebuffer(), true);
+
+    // attachment layout transitions are recorded in the frame's command buffer
+    // right before the render pass instance instead of a separate submission
+    PrepareVkImage(&activeCmdBuffer, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+    PrepareVkImage(&activeCmdBuffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+    // the render pass instance is recorded when it ends, so that attachments
+    // discarded in the meantime can still skip their store operations
+    mStartedRenderPass  = mRenderPass;
+    mStartedFramebuffer = *(*mFramebuffers)[bufferIndex]->GetFramebuffer();
+    mSecondaryCmdBuffers.clear();
 }
 
 bool
@@ -670,7 +835,73 @@ Framebuffer::EndVkRenderPass(void)
     assert(GetCurrentContext());
     vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
     VkCommandBuffer activeCmdBuffer = commandBufferManager->GetActiveCommandBuffer();
-    return mRenderPass->End(&activeCmdBuffer);
+
+    // the render pass that was begun may differ from the one selected afterwards
+    if(mStartedRenderPass == nullptr) {
+        return false;
+    }
+
+    vulkanAPI::RenderPass *renderPass = mStartedRenderPass;
+    if(mColorDiscarded || mDepthDiscarded || mStencilDiscarded || mMultisampleDiscarded) {
+        renderPassKey_t key = mStartedRenderPassKey;
+        key.flags |= (mColorDiscarded << 9) | (mDepthDiscarded << 10) | (mStencilDiscarded << 11) |
+                     (mMultisampleDiscarded << 13);
+
+        // store operations do not affect render pass compatibility, so the
+        // framebuffer and the recorded secondary command buffers remain valid
+        renderPassCache_t::iterator it = FindRenderPass(key);
+        if(it != mRenderPassCache.end()) {
+            renderPass = it->second.renderPass;
+            renderPass->SetClearArea(mStartedRenderPass->GetClearArea());
+            renderPass->SetClearColorValue(mStartedRenderPass->GetClearValues()[0].color.float32);
+            renderPass->SetClearDepthStencilValue(mStartedRenderPass->GetClearValues()[1].depthStencil.depth,
+                                                  mStartedRenderPass->GetClearValues()[1].depthStencil.stencil);
+        }
+    }
+
+    renderPass->Begin(&activeCmdBuffer, &mStartedFramebuffer, true);
+    if(!mSecondaryCmdBuffers.empty()) {
+        vkCmdExecuteCommands(activeCmdBuffer, static_cast<uint32_t>(mSecondaryCmdBuffers.size()), mSecondaryCmdBuffers.data());
+    }
+    bool ended = renderPass->End(&activeCmdBuffer);
+
+    mSecondaryCmdBuffers.clear();
+    mStartedRenderPass  = nullptr;
+    mStartedFramebuffer = VK_NULL_HANDLE;
+    return ended;
+}
+
+void
+Framebuffer::ExecuteVkSecondaryCommandBuffer(const VkCommandBuffer *cmdBuffer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // anything rendered after a discard has to be stored
+    mColorDiscarded       = false;
+    mDepthDiscarded       = false;
+    mStencilDiscarded     = false;
+    mMultisampleDiscarded = false;
+
+    mSecondaryCmdBuffers.push_back(*cmdBuffer);
+}
+
+void
+Framebuffer::DiscardAttachments(bool color, bool depth, bool stencil)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    mColorDiscarded   |= color;
+    mDepthDiscarded   |= depth;
+    mStencilDiscarded |= stencil;
+}
+
+void
+Framebuffer::DiscardMultisampleAttachment(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the resolved single sampled color attachment is still stored
+    mMultisampleDiscarded = mMultisampleColorTexture != nullptr;
 }
 
 void
@@ -685,30 +916,63 @@ Framebuffer::PrepareVkImage(VkImageLayout newImageLayout)
     }
 }
 
+void
+Framebuffer::PrepareVkImage(VkCommandBuffer *cmdBuffer, VkImageLayout newImageLayout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(GetColorAttachmentTexture() && newImageLayout != VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
+        GetColorAttachmentTexture()->PrepareVkImageLayout(cmdBuffer, newImageLayout);
+        if(mMultisampleColorTexture && newImageLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
+            mMultisampleColorTexture->PrepareVkImageLayout(cmdBuffer, newImageLayout);
+        }
+    } else if(GetDepthStencilAttachmentTexture() && newImageLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
+        GetDepthStencilAttachmentTexture()->PrepareVkImageLayout(cmdBuffer, newImageLayout);
+    }
+}
+
 bool
 Framebuffer::Create(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    Release();
+    if(mFramebuffers == nullptr) {
+        return false;
+    }
+
+    // (re)create the framebuffers of the active render pass only
+    for(auto fb : *mFramebuffers) {
+        delete fb;
+    }
+    mFramebuffers->clear();
+
+    if(!CreateMultisampleColorTexture()) {
+        return false;
+    }
 
     for(uint32_t i = 0; i < mAttachmentColors.size(); ++i) {
         vulkanAPI::Framebuffer *frameBuffer = new vulkanAPI::Framebuffer(mVkContext);
 
+        // attachment order follows the render pass: color, depth/stencil, resolve
         vector<VkImageView> imageViews;
-        if(GetColorAttachmentTexture(i)) {
+        if(mMultisampleColorTexture) {
+            imageViews.push_back(mMultisampleColorTexture->GetVkImageView());
+        } else if(GetColorAttachmentTexture(i)) {
             imageViews.push_back(GetColorAttachmentTexture(i)->GetVkImageView());
         }
         if(mDepthStencilTexture) {
             imageViews.push_back(mDepthStencilTexture->GetVkImageView());
         }
+        if(mMultisampleColorTexture && GetColorAttachmentTexture(i)) {
+            imageViews.push_back(GetColorAttachmentTexture(i)->GetVkImageView());
+        }
 
         if(!frameBuffer->Create(&imageViews, GetVkRenderPass(), GetWidth(), GetHeight())) {
             delete frameBuffer;
             return false;
         }
 
-        mFramebuffers.push_back(frameBuffer);
+        mFramebuffers->push_back(frameBuffer);
     }
 
     return true;
@@ -38,6 +38,27 @@ typedef enum {
 
 class Framebuffer {
 private:
+    // render passes only differ in their attachment formats, sample count and load/store operations
+    typedef struct renderPassKey_t {
+        VkFormat                    colorFormat;
+        VkFormat                    depthStencilFormat;
+        VkSampleCountFlagBits       samples;
+        uint32_t                    flags;
+
+        bool operator<(const renderPassKey_t &other) const { FUN_ENTRY(GL_LOG_TRACE);
+                                                             if(colorFormat        != other.colorFormat)        return colorFormat        < other.colorFormat;
+                                                             if(depthStencilFormat != other.depthStencilFormat) return depthStencilFormat < other.depthStencilFormat;
+                                                             if(samples            != other.samples)            return samples            < other.samples;
+                                                             return flags < other.flags; }
+    } renderPassKey_t;
+
+    typedef struct renderPassEntry_t {
+        vulkanAPI::RenderPass          *renderPass;
+        vector<vulkanAPI::Framebuffer*> framebuffers;
+    } renderPassEntry_t;
+
+    typedef map<renderPassKey_t, renderPassEntry_t> renderPassCache_t;
+
     enum State {
         IDLE,
         CLEAR,
@@ -57,13 +78,27 @@ private:
     bool                            mUpdated;
     bool                            mSizeUpdated;
 
+    renderPassCache_t               mRenderPassCache;
     vulkanAPI::RenderPass*          mRenderPass;
-    vector<vulkanAPI::Framebuffer*> mFramebuffers;
+    vulkanAPI::RenderPass*          mStartedRenderPass;
+    renderPassKey_t                 mStartedRenderPassKey;
+    VkFramebuffer                   mStartedFramebuffer;
+    vector<VkCommandBuffer>         mSecondaryCmdBuffers;
+    vector<vulkanAPI::Framebuffer*> *mFramebuffers;
 
     vector<Attachment*>             mAttachmentColors;
     Attachment*                     mAttachmentDepth;
     Attachment*                     mAttachmentStencil;
     Texture*                        mDepthStencilTexture;
+    VkSampleCountFlagBits           mSamples;
+    Texture*                        mMultisampleColorTexture;
+
+    // attachments whose contents are undefined after glDiscardFramebufferEXT
+    bool                            mColorDiscarded;
+    bool                            mDepthDiscarded;
+    bool                            mStencilDiscarded;
+    // multisampled color contents that are undefined after the frame has been swapped
+    bool                            mMultisampleDiscarded;
     bool                            mBindToTexture;
     GLenum                          mSurfaceType;
 
@@ -79,6 +114,9 @@ private:
     Renderbuffer*                   mCacheStencilRenderbuffer;
 
     void                            Release(void);
+    void                            ReleaseRenderPasses(void);
+    bool                            CreateMultisampleColorTexture(void);
+    renderPassCache_t::iterator     FindRenderPass(const renderPassKey_t &key);
     size_t                          GetCurrentBufferIndex(void) const;
 
 public:
@@ -88,7 +126,6 @@ public:
 // Create Functions
     bool                    Create(void);
     void                    CreateDepthStencilTexture(void);
-    void                    UpdateClearDepthStencilTexture(uint32_t clearStencil, uint32_t stencilMaskFront, const Rect& clearRect);
 
 // RenderPass Functions
     bool                    CreateVkRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
@@ -98,7 +135,11 @@ public:
                                                const float *colorValue, float depthValue, uint32_t stencilValue, const Rect *clearRect);
     void                    BeginVkRenderPass(void);
     bool                    EndVkRenderPass(void);
+    void                    ExecuteVkSecondaryCommandBuffer(const VkCommandBuffer *cmdBuffer);
+    void                    DiscardAttachments(bool color, bool depth, bool stencil);
+    void                    DiscardMultisampleAttachment(void);
     void                    PrepareVkImage(VkImageLayout newImageLayout);
+    void                    PrepareVkImage(VkCommandBuffer *cmdBuffer, VkImageLayout newImageLayout);
 
 // Add Functions
     void                    AddColorAttachment(Texture *texture);
@@ -126,7 +167,7 @@ public:
     inline int              GetHeight(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mDims.height; }
     inline GLenum           GetTarget(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mTarget; }
     inline vulkanAPI::RenderPass *     GetRenderPass(void)              const   { FUN_ENTRY(GL_LOG_TRACE); return mRenderPass; }
-    inline VkRenderPass *   GetVkRenderPass(void)                       const   { FUN_ENTRY(GL_LOG_TRACE); return mRenderPass->GetRenderPass(); }
+           VkRenderPass *   GetVkRenderPass(void)                       const;
 
     inline uint32_t         GetAttachmentName(GLenum type)              const   { FUN_ENTRY(GL_LOG_TRACE); switch(type) {
                                                                                                            case GL_COLOR_ATTACHMENT0:   return GetColorAttachmentName();
@@ -153,13 +194,16 @@ public:
     inline GLint            GetStencilAttachmentLevel(void)             const   { FUN_ENTRY(GL_LOG_TRACE); return mAttachmentStencil->GetLevel();  }
     inline GLenum           GetStencilAttachmentLayer(void)             const   { FUN_ENTRY(GL_LOG_TRACE); return mAttachmentStencil->GetLayer();  }
            Texture *        GetStencilAttachmentTexture(void)           const;
+           GLsizei          GetAttachmentSamples(GLenum attachment)     const;
+           VkSampleCountFlagBits GetAttachmentsVkSampleCount(void)      const;
+    inline VkSampleCountFlagBits GetSamples(void)                       const   { FUN_ENTRY(GL_LOG_TRACE); return mSamples;                        }
     inline GLint            GetBindToTexture(void)                      const   { FUN_ENTRY(GL_LOG_TRACE); return mBindToTexture;                  }
     inline GLint            GetSurfaceType(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mSurfaceType;                    }
 
 // Set Functions
     inline void             SetEGLSurfaceInterface(const EGLSurfaceInterface_t* eglSurfaceInterface) { FUN_ENTRY(GL_LOG_TRACE); mEGLSurfaceInterface = eglSurfaceInterface; }
     inline void             SetVkContext(const
-                                         vulkanAPI::vkContext_t *vkContext)     { FUN_ENTRY(GL_LOG_TRACE); mVkContext   = vkContext; mRenderPass->SetVkContext(vkContext); }
+                                         vulkanAPI::vkContext_t *vkContext)     { FUN_ENTRY(GL_LOG_TRACE); mVkContext   = vkContext; }
     inline void             SetResources(
                             ObjectArray<Texture>            *texArray,
                             ObjectArray<Renderbuffer>       *rbArray)           { FUN_ENTRY(GL_LOG_TRACE); mTextureArray = texArray; mRenderbufferArray = rbArray; }
@@ -180,6 +224,7 @@ public:
     inline void             SetColorAttachmentName(uint32_t name)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetName(name);   }
     inline void             SetColorAttachmentLevel(GLint level)                { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetLevel(level); }
     inline void             SetColorAttachmentLayer(GLenum layer)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetLayer(layer); }
+    inline void             SetColorAttachmentSamples(GLsizei samples)          { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetSamples(samples); }
 
     inline void             SetDepthAttachmentName(uint32_t name)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetName(name);   mUpdated = true;}
     inline void             SetDepthAttachmentType(GLenum type)                 { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetType(type);   }
@@ -194,6 +239,7 @@ public:
     inline void             SetDepthStencilAttachmentTexture(Texture *texture)  { FUN_ENTRY(GL_LOG_TRACE); mDepthStencilTexture = texture; }
     inline void             SetBindToTexture(GLint bindToTexture)               { FUN_ENTRY(GL_LOG_TRACE); mBindToTexture = bindToTexture;      }
     inline void             SetSurfaceType(GLint surfacetype)                   { FUN_ENTRY(GL_LOG_TRACE); mSurfaceType = surfacetype;          }
+    inline void             SetSamples(VkSampleCountFlagBits samples)           { FUN_ENTRY(GL_LOG_TRACE); mSamples     = samples;              }
 
     inline bool             IsSizeUpdated(void)                           const { FUN_ENTRY(GL_LOG_TRACE); return mSizeUpdated; }
 
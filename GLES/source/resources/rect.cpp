@@ -155,6 +155,41 @@ CopyPixelsConvert(
     }
 }
 
+// converts and copies pixels to an RGBA8 buffer a whole row at a time,
+// using the vectorized converter selected for the running CPU
+void
+CopyPixelsConvertRows(
+            const ImageRect* srcRect,
+            const void* srcData,
+            const ImageRect* dstRect,
+            void* dstData,
+            rowConverter_e rowConverterType)
+{
+    assert(dstRect->GetPixelByteOffset() == 4);
+
+    const RowConverterFunPtr RowConverter = GetRowConverter(rowConverterType);
+
+    // size of an entire row in bytes
+    const uint32_t srcRowStride = srcRect->GetRectAlignedRowInBytes();
+    const uint32_t dstRowStride = dstRect->GetRectAlignedRowInBytes();
+
+    // rectangle offset in the memory block
+    const uint32_t srcCurrentRowIndex = srcRect->GetStartRowIndex(srcRowStride);
+    const uint32_t dstCurrentRowIndex = dstRect->GetStartRowIndex(dstRowStride);
+
+    // obtain ptr locations with the byte offset
+    const uint8_t* srcPtr = static_cast<const uint8_t*>(srcData) + srcCurrentRowIndex;
+    uint8_t* dstPtr = static_cast<uint8_t*>(dstData) + dstCurrentRowIndex;
+
+    // perform the conversion
+    for(int row = 0; row < srcRect->height; ++row) {
+        RowConverter(srcPtr, dstPtr, static_cast<uint32_t>(srcRect->width));
+        // offset by the number of bytes per row
+        dstPtr = dstPtr + dstRowStride;
+        srcPtr = srcPtr + srcRowStride;
+    }
+}
+
 // copies pixels between two buffers
 // buffers must have the same format but may have different alignment
 void
@@ -211,7 +246,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_BGRA_TO_RGBA);
             break;
         case GL_LUMINANCE_ALPHA:
             CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToLuminanceAlpha);
@@ -257,7 +292,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
             break;
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGB, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_RGB_TO_RGBA);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -273,7 +308,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminanceAlpha, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_LUMINANCE_ALPHA_TO_RGBA);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -289,7 +324,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminance, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_LUMINANCE_TO_RGBA);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -302,7 +337,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromAlpha, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_ALPHA_TO_RGBA);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -315,7 +350,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From4444, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_4444_TO_RGBA);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -328,7 +363,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From5551, &Color::ConvertToRGBA);
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_5551_TO_RGBA);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -340,8 +375,10 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
             CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
             break;
         case GL_RGBA:
-        case GL_RGB8_OES:
         case GL_RGBA8_OES:
+            CopyPixelsConvertRows(srcRect, srcData, dstRect, dstData, ROW_CONVERTER_565_TO_RGBA);
+            break;
+        case GL_RGB8_OES:
             CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From565, &Color::ConvertToRGBA);
             break;
         case GL_LUMINANCE:
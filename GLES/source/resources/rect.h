@@ -29,6 +29,7 @@
 #include <cmath>
 #include <algorithm>
 #include "utils/color.hpp"
+#include "utils/pixelConverters.h"
 
 class Rect {
 
@@ -85,6 +86,12 @@ void                    CopyPixelsConvert(
                         void* dstData,
                         Color (*SrcColorFunPtr)(const uint8_t*),
                                           void (*DstColorFunPtr)(struct Color&, uint8_t*));
+void                    CopyPixelsConvertRows(
+                        const ImageRect* srcRect,
+                        const void* srcData,
+                        const ImageRect* dstRect,
+                        void* dstData,
+                        rowConverter_e rowConverterType);
 void                    ConvertPixels(GLenum srcFormat , GLenum dstFormat,
                         ImageRect* srcRect,
                         const void* srcData,
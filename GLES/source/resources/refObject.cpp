@@ -39,7 +39,7 @@ refObject::Bind()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //TODO: mutex lock
+    // objects of a share group may be bound by contexts of different threads
     refCount++;
     return 0;
 }
@@ -49,7 +49,6 @@ refObject::Unbind()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //TODO: mutex lock
     refCount--;
     assert(refCount >= 0);
     return 0;
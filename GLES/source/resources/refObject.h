@@ -25,10 +25,11 @@
 #define __REFOBJECT_H_
 
 #include "utils/glLogger.h"
+#include <atomic>
 
 class refObject {
 private:
-    int   refCount;
+    std::atomic<int> refCount;
     int   markForDeletion;
 
 public:
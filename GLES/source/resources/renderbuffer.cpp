@@ -32,7 +32,7 @@
 
 Renderbuffer::Renderbuffer(const vulkanAPI::vkContext_t *vkContext)
 : mVkContext(vkContext),
-mInternalFormat(GL_RGBA4), mTarget(GL_INVALID_VALUE), mTexture(nullptr)
+mInternalFormat(GL_RGBA4), mTarget(GL_INVALID_VALUE), mSamples(0), mTexture(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -66,13 +66,16 @@ Renderbuffer::InitTexture(void)
 }
 
 bool
-Renderbuffer::Allocate(GLint width, GLint height, GLenum internalformat)
+Renderbuffer::Allocate(GLint width, GLint height, GLenum internalformat, GLsizei samples)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     mDims.width     = width;
     mDims.height    = height;
     mInternalFormat = internalformat;
+    // the multisampled storage is owned by the framebuffer the renderbuffer is
+    // attached to, the texture holds the resolved single sampled contents
+    mSamples        = samples;
 
     mTexture->SetTarget(GL_TEXTURE_2D);
 
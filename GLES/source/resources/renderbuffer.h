@@ -35,6 +35,7 @@ private:
     Rect                             mDims;
     GLenum                           mInternalFormat;
     GLenum                           mTarget;
+    GLsizei                          mSamples;
     Texture *                        mTexture;
 
 public:
@@ -42,7 +43,7 @@ public:
     ~Renderbuffer();
 
 // Allocate Functions
-           bool        Allocate(GLint width, GLint height, GLenum internalformat);
+           bool        Allocate(GLint width, GLint height, GLenum internalformat, GLsizei samples = 0);
 
 // Release Functions
            void        Release(void);
@@ -52,6 +53,7 @@ public:
     inline int32_t     GetHeight(void)                                    const { FUN_ENTRY(GL_LOG_TRACE); return mDims.height;    }
     inline GLenum      GetTarget(void)                                    const { FUN_ENTRY(GL_LOG_TRACE); return mTarget;         }
     inline GLenum      GetInternalFormat(void)                            const { FUN_ENTRY(GL_LOG_TRACE); return mInternalFormat; }
+    inline GLsizei     GetSamples(void)                                   const { FUN_ENTRY(GL_LOG_TRACE); return mSamples;        }
     inline Texture *   GetTexture(void)                                   const { FUN_ENTRY(GL_LOG_TRACE); return mTexture;        }
 
 // Set Functions
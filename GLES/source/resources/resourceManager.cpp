@@ -22,8 +22,13 @@
  *  @section
  *
  *  OpenGL ES allows developers to allocate, edit and delete a variety of
- *  resources. These include Generic Vertex Attributes, Buffers, Renderbuffers,
- *  Framebuffers, Textures, Shaders, and Shader Programs.
+ *  resources. These include Buffers, Renderbuffers, Framebuffers, Textures,
+ *  Shaders, and Shader Programs.
+ *
+ *  The resource manager holds the objects of an EGL share group. It is
+ *  reference counted by the contexts that share it and it may be accessed
+ *  concurrently from their threads, so every object array, the shading
+ *  object namespace and the purge lists are guarded by a lock of their own.
  */
 
 #include "resourceManager.h"
@@ -31,15 +36,11 @@
 ResourceManager::ResourceManager(const vulkanAPI::vkContext_t *vkContext):
     mVkContext(vkContext),
     mShadingObjectCount(1),
-    mGenericVertexAttributes(GLOVE_MAX_VERTEX_ATTRIBS)
+    mShareCount(1)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
     CreateDefaultTextures();
-
-    for(auto& gva : mGenericVertexAttributes) {
-        gva.SetVkContext(vkContext);
-    }
 }
 
 ResourceManager::~ResourceManager()
@@ -48,19 +49,6 @@ ResourceManager::~ResourceManager()
 
     delete mDefaultTexture2D;
     delete mDefaultTextureCubeMap;
-
-    for(auto& gva : mGenericVertexAttributes) {
-        gva.Release();
-    }
-    mGenericVertexAttributes.clear();
-}
-
-void
-ResourceManager::SetCacheManager(CacheManager *cacheManager)
-{
-    for(auto& gva : mGenericVertexAttributes) {
-        gva.SetCacheManager(cacheManager);
-    }
 }
 
 void
@@ -86,10 +74,38 @@ ResourceManager::CreateDefaultTextures()
 }
 
 
+uint32_t
+ResourceManager::GetShadingObjectCount(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
+    return mShadingObjectCount;
+}
+
+ShadingNamespace_t
+ResourceManager::GetShadingObject(GLuint index)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
+    return mShadingObjectPool[index];
+}
+
+bool
+ResourceManager::ShadingObjectExists(GLuint index) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
+    return mShadingObjectPool.find(index) != mShadingObjectPool.end();
+}
+
 uint32_t
 ResourceManager::PushShadingObject(const ShadingNamespace_t& obj)
 {
     FUN_ENTRY(GL_LOG_TRACE);
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
     mShadingObjectPool[mShadingObjectCount] = obj;
     return mShadingObjectCount++;
 }
@@ -98,6 +114,7 @@ void
 ResourceManager::EraseShadingObject(uint32_t id)
 {
     FUN_ENTRY(GL_LOG_TRACE);
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
     mShadingObjectPool.erase(id);
 }
 
@@ -106,11 +123,13 @@ ResourceManager::IsShadingObject(GLuint index, shadingNamespaceType_t type) cons
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(!index || index >= mShadingObjectCount || !ShadingObjectExists(index)) {
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
+    shadingPoolIDs_t::const_iterator it = mShadingObjectPool.find(index);
+    if(!index || index >= mShadingObjectCount || it == mShadingObjectPool.end()) {
         return GL_FALSE;
     }
 
-    ShadingNamespace_t shadId = mShadingObjectPool.find(index)->second;
+    ShadingNamespace_t shadId = it->second;
     return (shadId.arrayIndex && shadId.type == type) ? GL_TRUE : GL_FALSE;
 }
 
@@ -119,8 +138,10 @@ ResourceManager::FindShaderID(const Shader *shader)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    const uint32_t shaderID = GetShaderID(shader);
+    std::lock_guard<std::mutex> lock(mShadingObjectMutex);
     for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
-        if(it->second.type == SHADER_ID && GetShaderID(shader) == it->second.arrayIndex) {
+        if(it->second.type == SHADER_ID && shaderID == it->second.arrayIndex) {
             return it->first;
         }
     }
@@ -132,8 +153,10 @@ ResourceManager::FindShaderProgramID(const ShaderProgram *program)
 {
    FUN_ENTRY(GL_LOG_DEBUG);
 
+   const uint32_t programID = GetShaderProgramID(program);
+   std::lock_guard<std::mutex> lock(mShadingObjectMutex);
    for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
-        if(it->second.type == SHADER_PROGRAM_ID && GetShaderProgramID(program) == it->second.arrayIndex) {
+        if(it->second.type == SHADER_PROGRAM_ID && programID == it->second.arrayIndex) {
             return it->first;
         }
     }
@@ -146,10 +169,13 @@ ResourceManager::UpdateFramebufferObjects(GLuint index, GLenum target)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
+    std::lock_guard<std::mutex> lock(mFramebuffers.GetMutex());
+    for(auto fb : mFramebuffers.GetObjectList()) {
+
+        if(fb == nullptr) {
+            continue;
+        }
 
-        Framebuffer *fb = it->second;
         if((fb->GetColorAttachmentType()   == target && index == fb->GetColorAttachmentName()) ||
            (fb->GetDepthAttachmentType()   == target && index == fb->GetDepthAttachmentName()) ||
            (fb->GetStencilAttachmentType() == target && index == fb->GetStencilAttachmentName())) {
@@ -163,10 +189,10 @@ ResourceManager::IsTextureAttachedToFBO(const Texture *texture)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
+    std::lock_guard<std::mutex> lock(mFramebuffers.GetMutex());
+    for(auto fb : mFramebuffers.GetObjectList()) {
 
-        if(it->second->GetColorAttachmentType() == GL_TEXTURE && texture == it->second->GetColorAttachmentTexture()) {
+        if(fb != nullptr && fb->GetColorAttachmentType() == GL_TEXTURE && texture == fb->GetColorAttachmentTexture()) {
             return true;
         }
     }
@@ -179,6 +205,8 @@ ResourceManager::CleanPurgeList()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    std::lock_guard<std::mutex> lock(mPurgeListMutex);
+
     //Buffers
     for (auto it = mPurgeListBufferObject.begin(); it != mPurgeListBufferObject.end(); ) {
         if ((*it)->GetRefCount() == 0) {
@@ -238,10 +266,12 @@ ResourceManager::FramebufferCacheAttachement(Texture *texture, GLuint index)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
+    std::lock_guard<std::mutex> lock(mFramebuffers.GetMutex());
+    for(auto fb : mFramebuffers.GetObjectList()) {
 
-        it->second->CacheAttachement(texture, index);
+        if(fb != nullptr) {
+            fb->CacheAttachement(texture, index);
+        }
     }
 }
 
@@ -250,9 +280,11 @@ ResourceManager::FramebufferCacheAttachement(Renderbuffer *renderbuffer, GLuint
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
+    std::lock_guard<std::mutex> lock(mFramebuffers.GetMutex());
+    for(auto fb : mFramebuffers.GetObjectList()) {
 
-        it->second->CacheAttachement(renderbuffer, index);
+        if(fb != nullptr) {
+            fb->CacheAttachement(renderbuffer, index);
+        }
     }
 }
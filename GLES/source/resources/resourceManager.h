@@ -31,6 +31,8 @@
 #include "resources/shader.h"
 #include "resources/texture.h"
 #include "utils/cacheManager.h"
+#include <atomic>
+#include <mutex>
 
 typedef enum {
     NO_ID,
@@ -62,12 +64,14 @@ private:
 
     uint32_t                                   mShadingObjectCount;
     shadingPoolIDs_t                           mShadingObjectPool;
+    mutable std::mutex                         mShadingObjectMutex;
     ShaderArray                                mShaders;
     ShaderProgramArray                         mShaderPrograms;
 
     Texture                                   *mDefaultTexture2D;
     Texture                                   *mDefaultTextureCubeMap;
-    std::vector<GenericVertexAttribute>        mGenericVertexAttributes;
+    std::atomic<uint32_t>                      mShareCount;
+    std::mutex                                 mPurgeListMutex;
     std::vector<BufferObject*>                 mPurgeListBufferObject;
     std::vector<Texture*>                      mPurgeListTexture;
     std::vector<Shader*>                       mPurgeListShaders;
@@ -96,9 +100,6 @@ public:
     inline void                RemoveFromListRenderbuffer(uint32_t index)       { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers.RemoveFromList(index); }
 
 // Get Functions
-    inline std::vector<GenericVertexAttribute>& GetGenericVertexAttributes(void) { FUN_ENTRY(GL_LOG_TRACE); return mGenericVertexAttributes; }
-    inline GenericVertexAttribute* GetGenericVertexAttribute(size_t index)      { FUN_ENTRY(GL_LOG_TRACE); return &mGenericVertexAttributes[index]; }
-
     inline TextureArray       *GetTextureArray(void)                            { FUN_ENTRY(GL_LOG_TRACE); return &mTextures; }
     inline ShaderArray        *GetShaderArray(void)                             { FUN_ENTRY(GL_LOG_TRACE); return &mShaders;  }
     inline ShaderProgramArray *GetShaderProgramArray(void)                      { FUN_ENTRY(GL_LOG_TRACE); return &mShaderPrograms; }
@@ -115,11 +116,12 @@ public:
     inline ShaderProgram *     GetShaderProgram(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.GetObject(index); }
     inline uint32_t            GetShaderID(const Shader *shader)                { FUN_ENTRY(GL_LOG_TRACE); return mShaders.GetObjectId(shader); }
     inline uint32_t            GetShaderProgramID(const ShaderProgram *program) { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.GetObjectId(program); }
-    inline uint32_t            GetShadingObjectCount(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectCount; }
-    inline ShadingNamespace_t  GetShadingObject(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectPool[index]; }
-    
-// Set Functions
-    void                       SetCacheManager(CacheManager *cacheManager);
+           uint32_t            GetShadingObjectCount(void)                const;
+           ShadingNamespace_t  GetShadingObject(GLuint index);
+
+// Share Functions
+    inline void                Share(void)                                      { FUN_ENTRY(GL_LOG_TRACE); ++mShareCount; }
+    inline bool                Release(void)                                    { FUN_ENTRY(GL_LOG_TRACE); return --mShareCount == 0; }
 
 // Map Functions
            uint32_t            PushShadingObject(const ShadingNamespace_t& obj);
@@ -129,8 +131,7 @@ public:
     inline bool                BufferExists(GLuint index)                 const { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.ObjectExists(index); }
     inline bool                RenderbufferExists(GLuint index)           const { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.ObjectExists(index); }
     inline bool                FramebufferExists(GLuint index)            const { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.ObjectExists(index); }
-    inline bool                ShadingObjectExists(GLuint index)          const { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectPool.find(index) != mShadingObjectPool.end(); }
-
+           bool                ShadingObjectExists(GLuint index)          const;
            GLboolean           IsShadingObject(GLuint index, shadingNamespaceType_t type) const;
     bool                       IsTextureAttachedToFBO(const Texture *texture);
     uint32_t                   FindShaderID(const Shader *shader);
@@ -140,11 +141,11 @@ public:
     void                       CreateDefaultTextures(void);
 
 //PurgeList Functions
-    void                       AddToPurgeList(BufferObject *object)             { FUN_ENTRY(GL_LOG_TRACE); mPurgeListBufferObject.push_back(object); }
-    void                       AddToPurgeList(Texture *object)                  { FUN_ENTRY(GL_LOG_TRACE); mPurgeListTexture.push_back(object); }
-    void                       AddToPurgeList(Shader *object)                   { FUN_ENTRY(GL_LOG_TRACE); mPurgeListShaders.push_back(object); }
-    void                       AddToPurgeList(ShaderProgram *object)            { FUN_ENTRY(GL_LOG_TRACE); mPurgeListShaderPrograms.push_back(object); }
-    void                       AddToPurgeList(Renderbuffer *object)             { FUN_ENTRY(GL_LOG_TRACE); mPurgeListRenderbuffers.push_back(object); }
+    void                       AddToPurgeList(BufferObject *object)             { FUN_ENTRY(GL_LOG_TRACE); std::lock_guard<std::mutex> lock(mPurgeListMutex); mPurgeListBufferObject.push_back(object); }
+    void                       AddToPurgeList(Texture *object)                  { FUN_ENTRY(GL_LOG_TRACE); std::lock_guard<std::mutex> lock(mPurgeListMutex); mPurgeListTexture.push_back(object); }
+    void                       AddToPurgeList(Shader *object)                   { FUN_ENTRY(GL_LOG_TRACE); std::lock_guard<std::mutex> lock(mPurgeListMutex); mPurgeListShaders.push_back(object); }
+    void                       AddToPurgeList(ShaderProgram *object)            { FUN_ENTRY(GL_LOG_TRACE); std::lock_guard<std::mutex> lock(mPurgeListMutex); mPurgeListShaderPrograms.push_back(object); }
+    void                       AddToPurgeList(Renderbuffer *object)             { FUN_ENTRY(GL_LOG_TRACE); std::lock_guard<std::mutex> lock(mPurgeListMutex); mPurgeListRenderbuffers.push_back(object); }
     void                       CleanPurgeList();
     void                       FramebufferCacheAttachement(Texture *texture, GLuint index);
     void                       FramebufferCacheAttachement(Renderbuffer *renderbuffer, GLuint index);
@@ -150,15 +150,12 @@ ScreenSpacePass::ShaderData::InitResources(CacheManager* cacheManager, const vul
 
     Destroy();
     shaderCompiler = new GlslangShaderCompiler();
+    this->cacheManager = cacheManager;
     vertShader = new Shader();
-    vertShader->SetShaderCompiler(shaderCompiler);
     vertShader->SetVkContext(mVkContext);
     fragShader = new Shader();
-    fragShader->SetShaderCompiler(shaderCompiler);
     fragShader->SetVkContext(mVkContext);
     shaderProgram = new ShaderProgram(mVkContext);
-    shaderProgram->SetShaderCompiler(shaderCompiler);
-    shaderProgram->SetCacheManager(cacheManager);
 }
 
 bool
@@ -172,7 +169,7 @@ ScreenSpacePass::ShaderData::Generate(const std::string& vertexSource, const std
     vertShader->SetShaderType(SHADER_TYPE_VERTEX);
     GLint vertexLength = static_cast<GLint>(vertexSource.length());
     vertShader->SetShaderSource(1, &vertexSourcec100Str, &vertexLength);
-    if(!vertShader->CompileShader()) {
+    if(!vertShader->CompileShader(shaderCompiler)) {
         GLOVE_PRINT_ERR("Could not compile vertex shader for screen-space pass\n");
         return false;
     }
@@ -180,14 +177,14 @@ ScreenSpacePass::ShaderData::Generate(const std::string& vertexSource, const std
     fragShader->SetShaderType(SHADER_TYPE_FRAGMENT);
     GLint fragmentLength = static_cast<GLint>(fragmentSource.length());
     fragShader->SetShaderSource(1, &fragmentSourcec100Str, &fragmentLength);
-    if(!fragShader->CompileShader()) {
+    if(!fragShader->CompileShader(shaderCompiler)) {
         GLOVE_PRINT_ERR("Could not compile fragment shader for screen-space pass\n");
         return false;
     }
 
     shaderProgram->AttachShader(vertShader);
     shaderProgram->AttachShader(fragShader);
-    if(!shaderProgram->LinkProgram()) {
+    if(!shaderProgram->LinkProgram(shaderCompiler, cacheManager)) {
         GLOVE_PRINT_ERR("Could not link shader program for screen-space pass\n");
         return false;
     }
@@ -349,7 +346,7 @@ ScreenSpacePass::BindUniformDescriptors(const VkCommandBuffer *cmdBuffer) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mShaderData.shaderProgram->UpdateDescriptorSet();
+    mShaderData.shaderProgram->UpdateDescriptorSet(mShaderData.cacheManager);
     mShaderData.shaderProgram->UpdateBuiltInUniformData(0.0f, 1.0f);
     vkCmdBindDescriptorSets(*cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mShaderData.shaderProgram->GetVkPipelineLayout(), 0, 1,
                             mShaderData.shaderProgram->GetVkDescSet(), 0, nullptr);
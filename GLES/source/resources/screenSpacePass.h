@@ -47,11 +47,12 @@ struct UniformBufferObject_ScreenSpace {
 };
 struct ShaderData {
     class ShaderCompiler                       *shaderCompiler;
+    CacheManager                               *cacheManager;
     class ShaderProgram                        *shaderProgram;
     class Shader                               *vertShader;
     class Shader                               *fragShader;
     ShaderData():
-    shaderCompiler(nullptr), shaderProgram(nullptr),
+    shaderCompiler(nullptr), cacheManager(nullptr), shaderProgram(nullptr),
     vertShader(nullptr), fragShader(nullptr){
 
     }
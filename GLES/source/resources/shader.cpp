@@ -30,7 +30,7 @@
 #include "shader.h"
 
 Shader::Shader(const vulkanAPI::vkContext_t *vkContext)
-: mVkContext(vkContext), mVkShaderModule(VK_NULL_HANDLE), mShaderCompiler(nullptr), mSource(nullptr),
+: mVkContext(vkContext), mVkShaderModule(VK_NULL_HANDLE), mSource(nullptr),
   mSourceLength(0), mShaderType(SHADER_TYPE_INVALID), mShaderVersion(ESSL_VERSION_100), mCompiled(false)
 {
     FUN_ENTRY(GL_LOG_TRACE);
@@ -45,11 +45,11 @@ Shader::~Shader()
 }
 
 int
-Shader::GetInfoLogLength(void) const
+Shader::GetInfoLogLength(ShaderCompiler *compiler) const
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    return mShaderCompiler->GetShaderInfoLog(mShaderType, mShaderVersion) ? (int)strlen(mShaderCompiler->GetShaderInfoLog(mShaderType, mShaderVersion)) : 0;
+    return (compiler && compiler->GetShaderInfoLog(mShaderType, mShaderVersion)) ? (int)strlen(compiler->GetShaderInfoLog(mShaderType, mShaderVersion)) : 0;
 }
 
 void
@@ -118,10 +118,6 @@ Shader::SetShaderSource(GLsizei count, const GLchar *const *source, const GLint
     mSource[currentLength] = '\0';
     delete[] sourceLengths;
 
-    if(GLOVE_SAVE_SHADER_SOURCES_TO_FILES) {
-        mShaderCompiler->EnableSaveSourceToFiles();
-    }
-
     if(GLOVE_DUMP_ORIGINAL_SHADER_SOURCE) {
         GlslPrintShaderSource(mShaderType, mShaderVersion, mSource);
     }
@@ -151,17 +147,17 @@ Shader::GetShaderSource(void) const
 }
 
 char *
-Shader::GetInfoLog(void) const
+Shader::GetInfoLog(ShaderCompiler *compiler) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     char *log = nullptr;
 
-    if(mShaderCompiler) {
-        uint32_t len = strlen(mShaderCompiler->GetShaderInfoLog(mShaderType, mShaderVersion)) + 1;
+    if(compiler) {
+        uint32_t len = strlen(compiler->GetShaderInfoLog(mShaderType, mShaderVersion)) + 1;
         log = new char[len];
 
-        memcpy(log, mShaderCompiler->GetShaderInfoLog(mShaderType, mShaderVersion), len);
+        memcpy(log, compiler->GetShaderInfoLog(mShaderType, mShaderVersion), len);
 
         /// NULL terminate it
         if(log[len - 1] != '\0') {
@@ -173,11 +169,16 @@ Shader::GetInfoLog(void) const
 }
 
 bool
-Shader::CompileShader(void)
+Shader::CompileShader(ShaderCompiler *compiler)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mCompiled = mShaderCompiler->CompileShader(&mSource, mShaderType, mShaderVersion);
+    // shaders may be shared, so they are compiled by the compiler of the calling context
+    if(GLOVE_SAVE_SHADER_SOURCES_TO_FILES) {
+        compiler->EnableSaveSourceToFiles();
+    }
+
+    mCompiled = compiler->CompileShader(&mSource, mShaderType, mShaderVersion);
 
     return mCompiled;
 }
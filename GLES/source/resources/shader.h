@@ -31,7 +31,6 @@ class Shader : public refObject {
 private:
     const vulkanAPI::vkContext_t *      mVkContext;
     VkShaderModule                      mVkShaderModule;
-    ShaderCompiler *                    mShaderCompiler;
 
     char *                              mSource;
     vector<uint32_t>                    mSpv;
@@ -48,12 +47,12 @@ public:
     Shader(const vulkanAPI::vkContext_t *vkContext = nullptr);
     ~Shader();
 
-    bool                                CompileShader(void);
+    bool                                CompileShader(ShaderCompiler *compiler);
     VkShaderModule                      CreateVkShaderModule(void);
 
 // Get Functions
-    char *                              GetInfoLog(void)                        const;
-    int                                 GetInfoLogLength(void)                  const;
+    char *                              GetInfoLog(ShaderCompiler *compiler)        const;
+    int                                 GetInfoLogLength(ShaderCompiler *compiler)  const;
     char *                              GetShaderSource(void)                   const;
     int                                 GetShaderSourceLength(void)             const;
     shader_type_t                       GetShaderType(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderType; }
@@ -62,7 +61,6 @@ public:
 // Set Functions
     void                                SetShaderSource(GLsizei count, const GLchar *const *string, const GLint *length);
     void                                SetVkContext(const vulkanAPI::vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext       = vkContext; }
-    void                                SetShaderCompiler(ShaderCompiler* compiler)     { FUN_ENTRY(GL_LOG_TRACE); mShaderCompiler  = compiler; }
     void                                SetShaderType(shader_type_t type)               { FUN_ENTRY(GL_LOG_TRACE); mShaderType      = type; }
 
 // Is/Has Functions
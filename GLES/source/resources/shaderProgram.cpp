@@ -45,6 +45,10 @@ ShaderProgram::ShaderProgram(const vulkanAPI::vkContext_t *vkContext)
     mMinDepthRange = 1.f;
     mMaxDepthRange = 0.f;
 
+    mDepthRangeLocations[0] = -1;
+    mDepthRangeLocations[1] = -1;
+    mDepthRangeLocations[2] = -1;
+
     mVkShaderModules[0] = VK_NULL_HANDLE;
     mVkShaderModules[1] = VK_NULL_HANDLE;
 
@@ -63,11 +67,10 @@ ShaderProgram::ShaderProgram(const vulkanAPI::vkContext_t *vkContext)
     mLinked = false;
     mIsPrecompiled = false;
     mValidated = false;
+    mVertexInputLocations = 0;
     mActiveVertexVkBuffersCount = 0;
     mActiveIndexVkBuffer = VK_NULL_HANDLE;
     mExplicitIbo = nullptr;
-
-    SetPipelineVertexInputStateInfo();
 }
 
 ShaderProgram::~ShaderProgram()
@@ -141,26 +144,12 @@ ShaderProgram::SetPipelineShaderStage(uint32_t &pipelineShaderStageCount, int *p
     return linked;
 }
 
-void
-ShaderProgram::SetPipelineVertexInputStateInfo(void)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    mVkPipelineVertexInput.sType                            = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    mVkPipelineVertexInput.pNext                            = nullptr;
-    mVkPipelineVertexInput.flags                            = 0;
-    mVkPipelineVertexInput.vertexBindingDescriptionCount    = 0;
-    mVkPipelineVertexInput.pVertexBindingDescriptions       = mVkVertexInputBinding;
-    mVkPipelineVertexInput.vertexAttributeDescriptionCount  = 0;
-    mVkPipelineVertexInput.pVertexAttributeDescriptions     = mVkVertexInputAttribute;
-}
-
 int
-ShaderProgram::GetInfoLogLength(void) const
+ShaderProgram::GetInfoLogLength(ShaderCompiler *compiler) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    return mShaderCompiler->GetProgramInfoLog(ESSL_VERSION_100) ? (int)strlen(mShaderCompiler->GetProgramInfoLog(ESSL_VERSION_100)) + 1 : 0;
+    return (compiler && compiler->GetProgramInfoLog(ESSL_VERSION_100)) ? (int)strlen(compiler->GetProgramInfoLog(ESSL_VERSION_100)) + 1 : 0;
 }
 
 Shader *
@@ -341,7 +330,7 @@ ShaderProgram::Validate()
 }
 
 bool
-ShaderProgram::ValidateProgram(void)
+ShaderProgram::ValidateProgram(ShaderCompiler *compiler)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -355,62 +344,62 @@ ShaderProgram::ValidateProgram(void)
     }
 
     if(GLOVE_DUMP_INPUT_SHADER_REFLECTION) {
-        mShaderCompiler->EnablePrintReflection(ESSL_VERSION_100);
+        compiler->EnablePrintReflection(ESSL_VERSION_100);
     }
     
-    return mShaderCompiler->ValidateProgram(ESSL_VERSION_100);
+    return compiler->ValidateProgram(ESSL_VERSION_100);
 }
 
 bool
-ShaderProgram::LinkProgram()
+ShaderProgram::LinkProgram(ShaderCompiler *compiler, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(!(mLinked = ValidateProgram())) {
+    if(!(mLinked = ValidateProgram(compiler))) {
         return false;
     }
 
     if(GLOVE_SAVE_SHADER_SOURCES_TO_FILES) {
-        mShaderCompiler->EnableSaveSourceToFiles();
+        compiler->EnableSaveSourceToFiles();
     }
 
     if(GLOVE_SAVE_SPIRV_BINARY_TO_FILES) {
-        mShaderCompiler->EnableSaveBinaryToFiles();
+        compiler->EnableSaveBinaryToFiles();
     }
 
     if(GLOVE_SAVE_SPIRV_TEXT_TO_FILE) {
-        mShaderCompiler->EnableSaveSpvTextToFile();
+        compiler->EnableSaveSpvTextToFile();
     }
 
     if(GLOVE_DUMP_PROCESSED_SHADER_SOURCE) {
-        mShaderCompiler->EnablePrintConvertedShader();
+        compiler->EnablePrintConvertedShader();
     }
 
     if(GLOVE_DUMP_VULKAN_SHADER_REFLECTION) {
-        mShaderCompiler->EnablePrintReflection(ESSL_VERSION_400);
+        compiler->EnablePrintReflection(ESSL_VERSION_400);
     }
 
     if(GLOVE_DUMP_SPIRV_SHADER_SOURCE) {
-        mShaderCompiler->EnablePrintSpv();
+        compiler->EnablePrintSpv();
     }
 
     ResetVulkanVertexInput();
 
-    mShaderCompiler->PrepareReflection(ESSL_VERSION_100);
-    UpdateAttributeInterface();
+    compiler->PrepareReflection(ESSL_VERSION_100);
+    UpdateAttributeInterface(compiler);
 
     Context *context = GetCurrentContext();
     assert(context);
-    mLinked = mShaderCompiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_VERTEX  , ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted()) &&
-              mShaderCompiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_FRAGMENT, ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted());
+    mLinked = compiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_VERTEX  , ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted()) &&
+              compiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_FRAGMENT, ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted());
     if(!mLinked) {
         return false;
     }
-    mLinked = mShaderCompiler->LinkProgram((uintptr_t)this, ESSL_VERSION_400, GetVertexShader()->GetSPV(), GetFragmentShader()->GetSPV());
+    mLinked = compiler->LinkProgram((uintptr_t)this, ESSL_VERSION_400, GetVertexShader()->GetSPV(), GetFragmentShader()->GetSPV());
     if(!mLinked) {
         return false;
     }
-    BuildShaderResourceInterface();
+    BuildShaderResourceInterface(compiler, cacheManager);
 
     /// A program object will fail to link if the number of active vertex attributes exceeds GL_MAX_VERTEX_ATTRIBS
     /// A link error will be generated if an attempt is made to utilize more than the space available for fragment shader uniform variables.
@@ -423,7 +412,7 @@ ShaderProgram::LinkProgram()
 
     if(GLOVE_DUMP_VULKAN_SHADER_REFLECTION) {
         printf("-------- SHADER PROGRAM REFLECTION GLOVE --------\n\n");
-        mShaderCompiler->PrintUniformReflection();
+        compiler->PrintUniformReflection();
         printf("-------------------------------------------------\n\n");
     }
 
@@ -431,12 +420,12 @@ ShaderProgram::LinkProgram()
 }
 
 bool
-ShaderProgram::AllocateExplicitIndexBuffer(const void* data, size_t size, BufferObject** ibo)
+ShaderProgram::AllocateExplicitIndexBuffer(const void* data, size_t size, BufferObject** ibo, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
     if(mExplicitIbo != nullptr) {
-        mCacheManager->CacheVBO(mExplicitIbo);
+        cacheManager->CacheVBO(mExplicitIbo);
         mExplicitIbo = nullptr;
     }
 
@@ -448,7 +437,7 @@ ShaderProgram::AllocateExplicitIndexBuffer(const void* data, size_t size, Buffer
 }
 
 bool
-ShaderProgram::ConvertIndexBufferToUint16(const void* srcData, size_t elementCount, BufferObject** ibo)
+ShaderProgram::ConvertIndexBufferToUint16(const void* srcData, size_t elementCount, BufferObject** ibo, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -457,7 +446,7 @@ ShaderProgram::ConvertIndexBufferToUint16(const void* srcData, size_t elementCou
 
     bool validatedBuffer = ConvertBuffer<uint8_t, uint16_t>(srcData, convertedIndicesU16, elementCount);
     if(validatedBuffer) {
-        validatedBuffer = AllocateExplicitIndexBuffer(convertedIndicesU16, actualSize, ibo);
+        validatedBuffer = AllocateExplicitIndexBuffer(convertedIndicesU16, actualSize, ibo, cacheManager);
     }
     delete[] convertedIndicesU16;
 
@@ -472,28 +461,40 @@ ShaderProgram::LineLoopConversion(void* data, uint32_t indexCount, size_t elemen
     memcpy(static_cast<uint8_t*>(data) + (indexCount - 1) * elementByteSize, data, elementByteSize);
 }
 
+template<typename T>
+static uint32_t
+FindMaxIndex(const T* indices, uint32_t indexCount)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    T maxIndex = indices[0];
+    for(uint32_t i = indexCount - 1; i > 0; --i) {
+        if(maxIndex < indices[i]) {
+            maxIndex = indices[i];
+        }
+    }
+
+    return static_cast<uint32_t>(maxIndex);
+}
+
 uint32_t
-ShaderProgram::GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset)
+ShaderProgram::GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset, GLenum type)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint16_t* srcData = new uint16_t[actualSize];
+    uint8_t* srcData = new uint8_t[actualSize];
     ibo->GetData(actualSize, offset, srcData);
 
-    uint16_t maxIndex = srcData[0];
-    for(uint32_t i = indexCount - 1; i > 0; --i) {
-        uint16_t index = srcData[i];
-        if(maxIndex < index) {
-            maxIndex = index;
-        }
-    }
+    // GL_UNSIGNED_BYTE indices have already been widened to uint16 at this point
+    uint32_t maxIndex = type == GL_UNSIGNED_INT ? FindMaxIndex(reinterpret_cast<const uint32_t*>(srcData), indexCount) :
+                                                  FindMaxIndex(reinterpret_cast<const uint16_t*>(srcData), indexCount);
     delete[] srcData;
 
     return maxIndex;
 }
 
 void
-ShaderProgram::PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo)
+ShaderProgram::PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -506,6 +507,7 @@ ShaderProgram::PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex
     // - If there is a index buffer bound, use the indices parameter as offset.
     // - Otherwise, indices contains the index buffer data. Therefore create a temporary object and store the data there.
     // If the data format is GL_UNSIGNED_BYTE (not supported by Vulkan), convert the data to uint16 and pass this instead.
+    // GL_UNSIGNED_INT (GL_OES_element_index_uint) maps directly onto VK_INDEX_TYPE_UINT32.
     if(ibo) {
         offset = reinterpret_cast<VkDeviceSize>(indices);
 
@@ -514,14 +516,14 @@ ShaderProgram::PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex
             uint8_t* srcData = new uint8_t[indexCount];
             ibo->GetData(indexCount, offset, srcData);
             offset = 0;
-            validatedBuffer = ConvertIndexBufferToUint16(srcData, indexCount, &ibo);
+            validatedBuffer = ConvertIndexBufferToUint16(srcData, indexCount, &ibo, cacheManager);
             delete[] srcData;
         }
     } else {
         if(type == GL_UNSIGNED_BYTE) {
-            validatedBuffer = ConvertIndexBufferToUint16(indices, indexCount, &ibo);
+            validatedBuffer = ConvertIndexBufferToUint16(indices, indexCount, &ibo, cacheManager);
         } else {
-            validatedBuffer = AllocateExplicitIndexBuffer(indices, actualSize, &ibo);
+            validatedBuffer = AllocateExplicitIndexBuffer(indices, actualSize, &ibo, cacheManager);
         }
     }
 
@@ -533,38 +535,19 @@ ShaderProgram::PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex
         ibo->GetData(actualSize - sizeOne, offset, srcData);
         LineLoopConversion(srcData, indexCount, sizeOne);
 
-        validatedBuffer = AllocateExplicitIndexBuffer(srcData, actualSize, &ibo);
+        validatedBuffer = AllocateExplicitIndexBuffer(srcData, actualSize, &ibo, cacheManager);
         delete[] srcData;
     }
 
     if(validatedBuffer) {
         *firstIndex = offset;
-        *maxIndex = GetMaxIndex(ibo, indexCount, actualSize, offset);
+        *maxIndex = GetMaxIndex(ibo, indexCount, actualSize, offset, type);
         mActiveIndexVkBuffer = ibo->GetVkBuffer();
     }
 }
 
 bool
-ShaderProgram::PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex,
-                                                std::vector<GenericVertexAttribute>& genericVertAttribs,
-                                                bool updatedVertexAttrib)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    // store the location-binding associations for faster lookup
-    std::map<uint32_t, uint32_t> vboLocationBindings;
-
-    if(UpdateVertexAttribProperties(vertCount, firstVertex, genericVertAttribs, vboLocationBindings, updatedVertexAttrib)) {
-        GenerateVertexInputProperties(genericVertAttribs, vboLocationBindings);
-        return true;
-    }
-    return false;
-}
-
-bool
-ShaderProgram::UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVertex,
-                                              std::vector<GenericVertexAttribute>& genericVertAttribs,
-                                              std::map<uint32_t, uint32_t>& vboLocationBindings, bool updatedVertexAttrib)
+ShaderProgram::PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex, VertexArrayObject *vao, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -573,124 +556,51 @@ ShaderProgram::UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVert
         --vertCount;
     }
 
-    // store attribute locations containing the same VkBuffer and stride
-    // as they are directly associated with vertex input bindings
-    typedef std::pair<VkBuffer, int32_t> BUFFER_STRIDE_PAIR;
-    std::map<BUFFER_STRIDE_PAIR, std::vector<uint32_t>> unique_buffer_stride_map;
-
-    std::vector<uint32_t> locationUsed;
-    for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveAttributes(); ++i) {
-        const uint32_t attributelocation  = mShaderResourceInterface.GetAttributeLocation(i);
-        const uint32_t occupiedLocations = OccupiedLocationsPerGlType(mShaderResourceInterface.GetAttributeType(i));
-
-        for(uint32_t j = 0; j < occupiedLocations; ++j) {
-            const uint32_t location = attributelocation + j;
-
-            // if location is currently used then ommit it
-            if (std::find(locationUsed.begin(), locationUsed.end(), location) != locationUsed.end()) {
-                continue;
-            }
-
-            GenericVertexAttribute& gva = genericVertAttribs[location];
-            bool updatedVBO   = false;
-            BufferObject *vbo = gva.UpdateVertexAttribute(static_cast<uint32_t>(firstVertex + vertCount), updatedVBO);
-            if(updatedVBO) {
-                updatedVertexAttrib = true;
-            }
-            VkBuffer bo       = vbo->GetVkBuffer();
-
-            // If the primitives are rendered with GL_LINE_LOOP, which is not
-            // supported in Vulkan, we have to modify the vbo and add the first vertex at the end.
-            if(GetCurrentContext()->IsModeLineLoop() && !mActiveIndexVkBuffer) {
-                BufferObject* vboLineLoopUpdated = new VertexBufferObject(mVkContext);
-
-                size_t sizeOld = vbo->GetSize();
-                size_t sizeOne = gva.GetStride();
-                size_t sizeNew = sizeOld + sizeOne;
-
-                uint8_t *dataNew = new uint8_t[sizeNew];
-
-                vbo->GetData(sizeOld, 0, dataNew);
-                memcpy(dataNew + sizeOld, dataNew, sizeOne);
-                vboLineLoopUpdated->Allocate(sizeNew, dataNew);
-
-                delete[] dataNew;
-                bo          = vboLineLoopUpdated->GetVkBuffer();
-                mCacheManager->CacheVBO(vboLineLoopUpdated);
-                updatedVertexAttrib = true;
-            }
-
-            // store each location
-            int32_t stride      = gva.GetStride();
-            BUFFER_STRIDE_PAIR p = {bo, stride};
-            unique_buffer_stride_map[p].push_back(location);
-            locationUsed.push_back(location);
-        }
-    }
-
-    if(!updatedVertexAttrib) {
-        return false;
-    }
-
-    memset(mActiveVertexVkBuffers, VK_NULL_HANDLE, sizeof(VkBuffer) * mActiveVertexVkBuffersCount);
-    mActiveVertexVkBuffersCount = 0;
-
-    // generate unique bindings for each VKbuffer/stride pair
-    uint32_t current_binding = 0;
-    for(const auto& iter : unique_buffer_stride_map) {
-        VkBuffer bo = iter.first.first;
-        for(const auto& loc_str_iter : iter.second) {
-            vboLocationBindings[loc_str_iter] = current_binding;
+    // client-side arrays and generic values are uploaded on every draw,
+    // which only changes the VkBuffers bound and not the vertex input state
+    BufferObject *locationVbos[GLOVE_MAX_VERTEX_ATTRIBS];
+    for(uint32_t location = 0; location < GLOVE_MAX_VERTEX_ATTRIBS; ++location) {
+        if(mVertexInputLocations & (1u << location)) {
+            bool updatedVBO = false;
+            locationVbos[location] = vao->GetGenericVertexAttribute(location)->UpdateVertexAttribute(static_cast<uint32_t>(firstVertex + vertCount), updatedVBO);
         }
-        mActiveVertexVkBuffers[current_binding] = bo;
-        ++current_binding;
     }
-    mActiveVertexVkBuffersCount = current_binding;
-    return true;
-}
 
-void
-ShaderProgram::GenerateVertexInputProperties(std::vector<GenericVertexAttribute>& genericVertAttribs, const std::map<uint32_t, uint32_t>& vboLocationBindings)
-{
-    // create vertex input bindings and attributes
-    uint32_t count = 0;
-    std::vector<uint32_t> locationUsed;
+    const bool updatedVertexInput = vao->UpdateVertexInput(mVertexInputLocations);
 
-    for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveAttributes(); ++i) {
-        const uint32_t attributelocation  = mShaderResourceInterface.GetAttributeLocation(i);
-        const uint32_t occupiedLocations = OccupiedLocationsPerGlType(mShaderResourceInterface.GetAttributeType(i));
-
-        for(uint32_t j = 0; j < occupiedLocations; ++j) {
-            const uint32_t location = attributelocation + j;
-            const uint32_t binding  = vboLocationBindings.at(location);
+    mActiveVertexVkBuffersCount = vao->GetBindingCount();
+    for(uint32_t binding = 0; binding < mActiveVertexVkBuffersCount; ++binding) {
+        BufferObject *vbo = locationVbos[vao->GetBindingLocation(binding)];
+        VkBuffer bo       = vbo->GetVkBuffer();
 
-            // if location is currently used then ommit it
-            if (std::find(locationUsed.begin(), locationUsed.end(), location) != locationUsed.end()) {
-                continue;
-            }
+        // If the primitives are rendered with GL_LINE_LOOP, which is not
+        // supported in Vulkan, we have to modify the vbo and add the first vertex at the end.
+        if(GetCurrentContext()->IsModeLineLoop() && !mActiveIndexVkBuffer) {
+            BufferObject* vboLineLoopUpdated = new VertexBufferObject(mVkContext);
 
-            GenericVertexAttribute& gva = genericVertAttribs[location];
-            mVkVertexInputBinding[binding].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-            mVkVertexInputBinding[binding].binding   = binding;
-            mVkVertexInputBinding[binding].stride    = static_cast<uint32_t>(gva.GetStride());
+            size_t sizeOld = vbo->GetSize();
+            size_t sizeOne = vao->GetVkPipelineVertexInput()->pVertexBindingDescriptions[binding].stride;
+            size_t sizeNew = sizeOld + sizeOne;
 
-            mVkVertexInputAttribute[count].binding  = binding;
-            mVkVertexInputAttribute[count].location = location;
-            mVkVertexInputAttribute[count].format   = gva.GetVkFormat();
-            mVkVertexInputAttribute[count].offset   = gva.GetOffset();
+            uint8_t *dataNew = new uint8_t[sizeNew];
 
-            ++count;
+            vbo->GetData(sizeOld, 0, dataNew);
+            memcpy(dataNew + sizeOld, dataNew, sizeOne);
+            vboLineLoopUpdated->Allocate(sizeNew, dataNew);
 
-            locationUsed.push_back(location);
+            delete[] dataNew;
+            bo          = vboLineLoopUpdated->GetVkBuffer();
+            cacheManager->CacheVBO(vboLineLoopUpdated);
         }
+
+        mActiveVertexVkBuffers[binding] = bo;
     }
 
-    mVkPipelineVertexInput.vertexBindingDescriptionCount   = mActiveVertexVkBuffersCount;
-    mVkPipelineVertexInput.vertexAttributeDescriptionCount = count;
+    return updatedVertexInput;
 }
 
 void
-ShaderProgram::UsePrecompiledBinary(const void *binary, size_t binarySize)
+ShaderProgram::UsePrecompiledBinary(const void *binary, size_t binarySize, ShaderCompiler *compiler, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -698,11 +608,11 @@ ShaderProgram::UsePrecompiledBinary(const void *binary, size_t binarySize)
 
     ResetVulkanVertexInput();
 
-    uint32_t reflectionOffset = mShaderCompiler->DeserializeReflection(binary);
+    uint32_t reflectionOffset = compiler->DeserializeReflection(binary);
     uint32_t spirvOffset = DeserializeShadersSpirv(reinterpret_cast<const uint8_t *>(binary) + reflectionOffset);
     const uint8_t *vulkanDataPtr = reinterpret_cast<const uint8_t *>(binary) + reflectionOffset + spirvOffset;
 
-    BuildShaderResourceInterface();
+    BuildShaderResourceInterface(compiler, cacheManager);
 
     mPipelineCache->Create(vulkanDataPtr, binarySize - reflectionOffset);
 
@@ -710,11 +620,11 @@ ShaderProgram::UsePrecompiledBinary(const void *binary, size_t binarySize)
 }
 
 void
-ShaderProgram::GetBinaryData(void *binary, GLsizei *binarySize)
+ShaderProgram::GetBinaryData(void *binary, GLsizei *binarySize, ShaderCompiler *compiler)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint32_t reflectionOffset = mShaderCompiler->SerializeReflection(binary);
+    uint32_t reflectionOffset = compiler->SerializeReflection(binary);
 
     uint8_t *spirvDataPtr = reinterpret_cast<uint8_t *>(binary) + reflectionOffset;
     uint32_t spirvOffset = SerializeShadersSpirv(spirvDataPtr);
@@ -746,17 +656,17 @@ ShaderProgram::GetBinaryLength(void)
 }
 
 char *
-ShaderProgram::GetInfoLog(void) const
+ShaderProgram::GetInfoLog(ShaderCompiler *compiler) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     char *log = nullptr;
 
-    if(mShaderCompiler) {
-        uint32_t len = strlen(mShaderCompiler->GetProgramInfoLog(ESSL_VERSION_100)) + 1;
+    if(compiler) {
+        uint32_t len = strlen(compiler->GetProgramInfoLog(ESSL_VERSION_100)) + 1;
         log = new char[len];
 
-        memcpy(log, mShaderCompiler->GetProgramInfoLog(ESSL_VERSION_100), len);
+        memcpy(log, compiler->GetProgramInfoLog(ESSL_VERSION_100), len);
         log[len - 1] = '\0';
     }
 
@@ -768,6 +678,7 @@ ShaderProgram::GetUniformData(uint32_t location, size_t size, void *ptr) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     mShaderResourceInterface.GetUniformClientData(location, size, ptr);
 }
 
@@ -776,6 +687,7 @@ ShaderProgram::SetUniformData(uint32_t location, size_t size, const void *ptr)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     mShaderResourceInterface.SetUniformClientData(location, size, ptr);
     mUpdateDescriptorData = true;
 }
@@ -785,19 +697,11 @@ ShaderProgram::SetUniformSampler(uint32_t location, int count, const int *textur
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     mShaderResourceInterface.SetUniformSampler(location, count, textureUnit);
     mUpdateDescriptorSets = true;
 }
 
-void
-ShaderProgram::SetCacheManager(CacheManager *cacheManager)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    mCacheManager = cacheManager;
-    mShaderResourceInterface.SetCacheManager(cacheManager);
-}
-
 void
 ShaderProgram::ReleaseVkObjects(void)
 {
@@ -1021,23 +925,22 @@ ShaderProgram::UpdateBuiltInUniformData(float minDepthRange, float maxDepthRange
     mMinDepthRange = minDepthRange;
     mMaxDepthRange = maxDepthRange;
 
-    int location;
-    if((location = GetUniformLocation("gl_DepthRange.near")) != -1) {
-        SetUniformData(location, sizeof(float), &mMinDepthRange);
+    if(mDepthRangeLocations[0] != -1) {
+        SetUniformData(mDepthRangeLocations[0], sizeof(float), &mMinDepthRange);
     }
 
-    if((location = GetUniformLocation("gl_DepthRange.far")) != -1) {
-        SetUniformData(location, sizeof(float), &mMaxDepthRange);
+    if(mDepthRangeLocations[1] != -1) {
+        SetUniformData(mDepthRangeLocations[1], sizeof(float), &mMaxDepthRange);
     }
 
-    if((location = GetUniformLocation("gl_DepthRange.diff")) != -1) {
+    if(mDepthRangeLocations[2] != -1) {
         float diffDepthRange = mMaxDepthRange - mMinDepthRange;
-        SetUniformData(location, sizeof(float), &diffDepthRange);
+        SetUniformData(mDepthRangeLocations[2], sizeof(float), &diffDepthRange);
     }
 }
 
-void
-ShaderProgram::UpdateDescriptorSet(void)
+bool
+ShaderProgram::UpdateDescriptorSet(CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -1047,13 +950,13 @@ ShaderProgram::UpdateDescriptorSet(void)
     assert(mVkContext);
 
     if(mShaderResourceInterface.GetLiveUniformBlocks() == 0) {
-        return;
+        return false;
     }
 
     /// Transfer any new local uniform data into the buffer objects
     if(mUpdateDescriptorData) {
         bool allocatedNewBufferObject = false;
-        mShaderResourceInterface.UpdateUniformBufferData(mVkContext, &allocatedNewBufferObject);
+        mShaderResourceInterface.UpdateUniformBufferData(mVkContext, cacheManager, &allocatedNewBufferObject);
         if(allocatedNewBufferObject) {
             mUpdateDescriptorSets = true;
         }
@@ -1062,6 +965,7 @@ ShaderProgram::UpdateDescriptorSet(void)
     }
 
     // Check if any texture is attached to a user-based FBO
+    bool sampledFramebufferTexture = false;
     for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveUniforms(); ++i) {
         if(mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D || mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_CUBE) {
             for(int32_t j = 0; j < mShaderResourceInterface.GetUniformArraySize(i); ++j) {
@@ -1072,6 +976,7 @@ ShaderProgram::UpdateDescriptorSet(void)
                 mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP, textureUnit); // TODO remove mGlContext
                 if(context->GetResourceManager()->IsTextureAttachedToFBO(activeTexture)) {
                     mUpdateDescriptorSets = true;
+                    sampledFramebufferTexture = true;
                     break;
                 }
             }
@@ -1084,16 +989,19 @@ ShaderProgram::UpdateDescriptorSet(void)
     /// 3. glBindTexture has been called
     /// 4. Texture is attached to a user-based FBO
     if(!mUpdateDescriptorSets) {
-        return;
+        return false;
     }
 
-    UpdateSamplerDescriptors();
+    UpdateSamplerDescriptors(cacheManager);
 
     mUpdateDescriptorSets = false;
+
+    /// A sampled framebuffer texture may be rendered to by any later draw, so it has to be revalidated again
+    return sampledFramebufferTexture;
 }
 
 void
-ShaderProgram::UpdateSamplerDescriptors(void)
+ShaderProgram::UpdateSamplerDescriptors(CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -1176,7 +1084,7 @@ ShaderProgram::UpdateSamplerDescriptors(void)
                         if(inverted_texture->IsCompleted()) {
                             inverted_texture->Allocate();
                             inverted_texture->PrepareVkImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                            mCacheManager->CacheTexture(inverted_texture);
+                            cacheManager->CacheTexture(inverted_texture);
                         }
 
                         activeTexture = inverted_texture;
@@ -1232,30 +1140,46 @@ ShaderProgram::ResetVulkanVertexInput(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mVkPipelineVertexInput.vertexAttributeDescriptionCount = 0;
-    mVkPipelineVertexInput.vertexBindingDescriptionCount = 0;
+    mVertexInputLocations = 0;
     mActiveVertexVkBuffersCount = 0;
     memset(static_cast<void *>(mActiveVertexVkBuffers), 0, sizeof(mActiveVertexVkBuffers));
 }
 
 void
-ShaderProgram::UpdateAttributeInterface(void)
+ShaderProgram::UpdateAttributeInterface(ShaderCompiler *compiler)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mShaderResourceInterface.SetReflection(mShaderCompiler->GetShaderReflection());
+    mShaderResourceInterface.SetReflection(compiler->GetShaderReflection());
     mShaderResourceInterface.UpdateAttributeInterface();
     mShaderResourceInterface.SetReflectionSize();
     mShaderResourceInterface.SetReflection(nullptr);
 }
 
 void
-ShaderProgram::BuildShaderResourceInterface(void)
+ShaderProgram::UpdateVertexInputLocations(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mShaderResourceInterface.SetReflection(mShaderCompiler->GetShaderReflection());
-    mShaderResourceInterface.CreateInterface();
+    // the locations consumed by the vertex shader select the vao arrays that are fetched
+    mVertexInputLocations = 0;
+    for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveAttributes(); ++i) {
+        const uint32_t attributelocation = mShaderResourceInterface.GetAttributeLocation(i);
+        const uint32_t occupiedLocations = OccupiedLocationsPerGlType(mShaderResourceInterface.GetAttributeType(i));
+
+        for(uint32_t j = 0; j < occupiedLocations; ++j) {
+            mVertexInputLocations |= 1u << (attributelocation + j);
+        }
+    }
+}
+
+void
+ShaderProgram::BuildShaderResourceInterface(ShaderCompiler *compiler, CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    mShaderResourceInterface.SetReflection(compiler->GetShaderReflection());
+    mShaderResourceInterface.CreateInterface(cacheManager);
     mShaderResourceInterface.SetReflection(nullptr);
     mShaderResourceInterface.AllocateUniformClientData();
     mShaderResourceInterface.AllocateUniformBufferObjects(mVkContext);
@@ -1263,6 +1187,15 @@ ShaderProgram::BuildShaderResourceInterface(void)
     mShaderResourceInterface.SetActiveUniformMaxLength();
     mShaderResourceInterface.SetActiveAttributeMaxLength();
 
+    /// Resolve the built-in uniforms once, the client data of the new interface are zeroed
+    mDepthRangeLocations[0] = GetUniformLocation("gl_DepthRange.near");
+    mDepthRangeLocations[1] = GetUniformLocation("gl_DepthRange.far");
+    mDepthRangeLocations[2] = GetUniformLocation("gl_DepthRange.diff");
+    mMinDepthRange = 1.f;
+    mMaxDepthRange = 0.f;
+
+    UpdateVertexInputLocations();
+
     AllocateVkDescriptoSet();
     mUpdateDescriptorSets = true;
     mUpdateDescriptorData = true;
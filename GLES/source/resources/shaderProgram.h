@@ -27,9 +27,10 @@
 #include "shader.h"
 #include "shaderResourceInterface.h"
 #include "utils/cacheManager.h"
-#include "genericVertexAttribute.h"
+#include "vertexArrayObject.h"
 #include "vulkan/pipelineCache.h"
 #include "refObject.h"
+#include <mutex>
 
 class Context;
 
@@ -44,12 +45,8 @@ private:
     VkPipelineLayout                                    mVkPipelineLayout;
 
     vulkanAPI::PipelineCache                           *mPipelineCache;
-    CacheManager                                       *mCacheManager;
-
-    VkPipelineVertexInputStateCreateInfo                mVkPipelineVertexInput;
-    VkVertexInputBindingDescription                     mVkVertexInputBinding[GLOVE_MAX_VERTEX_ATTRIBS];
-    VkVertexInputAttributeDescription                   mVkVertexInputAttribute[GLOVE_MAX_VERTEX_ATTRIBS];
 
+    uint32_t                                            mVertexInputLocations;
     uint32_t                                            mActiveVertexVkBuffersCount;
     VkBuffer                                            mActiveVertexVkBuffers[GLOVE_MAX_VERTEX_ATTRIBS];
 
@@ -64,6 +61,7 @@ private:
 
     float                                               mMinDepthRange;
     float                                               mMaxDepthRange;
+    int                                                 mDepthRangeLocations[3];
 
     uint32_t                                            mStageCount;
 #define MAX_SHADERS 2
@@ -74,54 +72,56 @@ private:
     Shader                                             *mShaders[MAX_SHADERS];
     int                                                 mStagesIDs[MAX_SHADERS];
 
-    ShaderCompiler                                     *mShaderCompiler;
     ShaderResourceInterface                             mShaderResourceInterface;
 
-    bool                                                ValidateProgram(void);
+    /// Programs may be shared between contexts, the draw-time state is guarded by this lock
+    mutable std::recursive_mutex                        mMutex;
+
+    bool                                                ValidateProgram(ShaderCompiler *compiler);
     void                                                ReleaseVkObjects(void);
     bool                                                AllocateVkDescriptoSet(void);
     bool                                                CreateDescriptorSetLayout(uint32_t nLiveUniformBlocks);
     bool                                                CreateDescriptorPool(uint32_t nLiveUniformBlocks);
     bool                                                CreateDescriptorSet(void);
-    void                                                UpdateSamplerDescriptors(void);
+    void                                                UpdateSamplerDescriptors(CacheManager *cacheManager);
 
     uint32_t                                            SerializeShadersSpirv(void *binary);
     uint32_t                                            DeserializeShadersSpirv(const void *binary);
 
     void                                                ResetVulkanVertexInput(void);
-    void                                                UpdateAttributeInterface(void);
-    void                                                BuildShaderResourceInterface(void);
-    bool                                                UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVertex, std::vector<GenericVertexAttribute>& genericVertAttribs, std::map<uint32_t, uint32_t>& vboLocationBindings, bool updatedVertexAttrib);
-    void                                                GenerateVertexInputProperties(std::vector<GenericVertexAttribute>& genericVertAttribs, const std::map<uint32_t, uint32_t>& vboLocationBindings);
+    void                                                UpdateAttributeInterface(ShaderCompiler *compiler);
+    void                                                BuildShaderResourceInterface(ShaderCompiler *compiler, CacheManager *cacheManager);
+    void                                                UpdateVertexInputLocations(void);
 
     void                                                LineLoopConversion(void* data, uint32_t indexCount, size_t elementByteSize);
-    bool                                                ConvertIndexBufferToUint16(const void* srcData, size_t elementCount, BufferObject** ibo);
-    bool                                                AllocateExplicitIndexBuffer(const void* data, size_t size, BufferObject** ibo);
-    uint32_t                                            GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset);
+    bool                                                ConvertIndexBufferToUint16(const void* srcData, size_t elementCount, BufferObject** ibo, CacheManager *cacheManager);
+    bool                                                AllocateExplicitIndexBuffer(const void* data, size_t size, BufferObject** ibo, CacheManager *cacheManager);
+    uint32_t                                            GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset, GLenum type);
 
 public:
     ShaderProgram(const vulkanAPI::vkContext_t *vkContext = nullptr);
     ~ShaderProgram() override;
 
-    void                                                SetPipelineVertexInputStateInfo(void);
     bool                                                SetPipelineShaderStage(uint32_t &pipelineShaderStageCount, int *pipelineStagesIDs, VkPipelineShaderStageCreateInfo *pipelineShaderStages);
-    void                                                PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo);
-    bool                                                PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex, std::vector<GenericVertexAttribute>& genericVertAttribs, bool updatedVertexAttrib);
+    void                                                PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo, CacheManager *cacheManager);
+    bool                                                PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex, VertexArrayObject *vao, CacheManager *cacheManager);
     Shader                                             *IsShaderAttached(Shader *shader) const;
     void                                                AttachShader(Shader *shader);
     void                                                DetachShader(Shader *shader);
-    int                                                 GetInfoLogLength(void) const;
-    char                                               *GetInfoLog(void) const;
-    bool                                                LinkProgram();
+    int                                                 GetInfoLogLength(ShaderCompiler *compiler) const;
+    char                                               *GetInfoLog(ShaderCompiler *compiler) const;
+    bool                                                LinkProgram(ShaderCompiler *compiler, CacheManager *cacheManager);
 
     void                                                DetachShaders(void);
 
     void                                                Validate(void);
     bool                                                ValidateSamplers(void);
     void                                                EnableUpdateOfDescriptorSets(void)                  { FUN_ENTRY(GL_LOG_TRACE); mUpdateDescriptorSets = true; }
+    bool                                                HasDirtyDescriptors(void)                   const   { FUN_ENTRY(GL_LOG_TRACE); return mUpdateDescriptorSets || mUpdateDescriptorData; }
+    uint32_t                                            GetVertexInputLocations(void)               const   { FUN_ENTRY(GL_LOG_TRACE); return mVertexInputLocations; }
 
-    void                                                UsePrecompiledBinary(const void *binary, size_t binarySize);
-    void                                                GetBinaryData(void *binary, GLsizei *binarySize);
+    void                                                UsePrecompiledBinary(const void *binary, size_t binarySize, ShaderCompiler *compiler, CacheManager *cacheManager);
+    void                                                GetBinaryData(void *binary, GLsizei *binarySize, ShaderCompiler *compiler);
     GLsizei                                             GetBinaryLength(void);
 
     uint32_t                                            GetNumberOfActiveUniforms(void)             const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetLiveUniforms(); }
@@ -138,24 +138,22 @@ public:
     Shader                                             *GetFragmentShader(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return mShaders[1]; }
     size_t                                              GetActiveUniformMaxLen(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetActiveUniformMaxLen(); }
     size_t                                              GetActiveAttribMaxLen(void)                 const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetActiveAttribMaxLen(); }
-    VkPipelineVertexInputStateCreateInfo               *GetVkPipelineVertexInput(void)                      { FUN_ENTRY(GL_LOG_TRACE); return &mVkPipelineVertexInput; }
     VkPipelineLayout                                    GetVkPipelineLayout(void)                   const   { FUN_ENTRY(GL_LOG_TRACE); return mVkPipelineLayout; }
     int                                                 GetStagesIDs(uint32_t index)                const   { FUN_ENTRY(GL_LOG_TRACE); return mStagesIDs[index]; }
     const VkDescriptorSet                              *GetVkDescSet(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return &mVkDescSet; }
     uint32_t                                            GetActiveVertexVkBuffersCount(void)         const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexVkBuffersCount; }
     const VkBuffer                                     *GetActiveVertexVkBuffers(void)              const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexVkBuffers; }
     VkBuffer                                            GetActiveIndexVkBuffer(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveIndexVkBuffer; }
+    std::recursive_mutex                               &GetMutex(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mMutex; }
 
     void                                                SetVkContext(const vulkanAPI::vkContext_t *vkContext) { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; mPipelineCache->SetContext(mVkContext);}
-    void                                                SetShaderCompiler(ShaderCompiler* shaderCompiler)   { FUN_ENTRY(GL_LOG_TRACE); assert(shaderCompiler != nullptr); mShaderCompiler = shaderCompiler; }
     void                                                SetStagesIDs(uint32_t index, uint32_t id)           { FUN_ENTRY(GL_LOG_TRACE); mStagesIDs[index] = id; }
 
     void                                                SetCustomAttribsLayout(const char *name, int index) { FUN_ENTRY(GL_LOG_TRACE); mShaderResourceInterface.SetCustomAttribsLayout(name, index); }
     void                                                SetUniformData(uint32_t location, size_t size, const void *ptr);
     void                                                GetUniformData(uint32_t location, size_t size, void *ptr) const;
     void                                                SetUniformSampler(uint32_t location, int count, const int *textureUnit);
-    void                                                SetCacheManager(CacheManager *cacheManager);
-    void                                                UpdateDescriptorSet(void);
+    bool                                                UpdateDescriptorSet(CacheManager *cacheManager);
     void                                                UpdateBuiltInUniformData(float minDepthRange, float maxDepthRange);
 
     uint32_t                                            GetNumberOfActiveAttributes(void) const;
@@ -34,7 +34,7 @@
 
 ShaderResourceInterface::ShaderResourceInterface()
 : mLiveAttributes(0), mLiveUniforms(0), mLiveUniformBlocks(0),
-  mActiveAttributeMaxLength(0), mActiveUniformMaxLength(0), mReflectionSize(0), mCacheManager(nullptr)
+  mActiveAttributeMaxLength(0), mActiveUniformMaxLength(0), mReflectionSize(0)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -43,11 +43,12 @@ ShaderResourceInterface::~ShaderResourceInterface()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    Reset();
+    // the cache manager may already be gone, so release the UBOs directly
+    Reset(nullptr);
 }
 
 void
-ShaderResourceInterface::Reset(void)
+ShaderResourceInterface::Reset(CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -55,17 +56,40 @@ ShaderResourceInterface::Reset(void)
     mLiveUniforms       = 0;
     mLiveUniformBlocks  = 0;
 
+    ReleaseUniformBufferObjects(cacheManager);
+
     mAttributeInterface.clear();
     mUniformInterface.clear();
     mUniformBlockInterface.clear();
+    mUniformDataInterface.clear();
+    mUniformClientData.clear();
+    mUniformLocations.clear();
 }
 
 void
-ShaderResourceInterface::CreateInterface(void)
+ShaderResourceInterface::ReleaseUniformBufferObjects(CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    Reset();
+    // UBOs of a previous link may still be referenced by submitted command buffers
+    for(auto &blockData : mUniformBlockDataInterface) {
+        if(blockData.pBufferObject) {
+            if(cacheManager) {
+                cacheManager->CacheUBO(blockData.pBufferObject);
+            } else {
+                delete blockData.pBufferObject;
+            }
+        }
+    }
+    mUniformBlockDataInterface.clear();
+}
+
+void
+ShaderResourceInterface::CreateInterface(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Reset(cacheManager);
 
     mLiveAttributes     = mShaderReflection->GetLiveAttributes();
     mLiveUniforms       = mShaderReflection->GetLiveUniforms();
@@ -87,7 +111,20 @@ ShaderResourceInterface::CreateInterface(void)
                                        mShaderReflection->GetUniformBlockIndex(i),
                                        mShaderReflection->GetUniformArraySize(i),
                                        mShaderReflection->GetUniformType(i),
-                                       mShaderReflection->GetUniformOffset(i));
+                                       mShaderReflection->GetUniformOffset(i),
+                                       IsBuildInUniform(mShaderReflection->GetUniformReflectionName(i)));
+    }
+
+    /// Resolve every location (including array elements) to its uniform slot
+    uint32_t nLocations = 0;
+    for(const auto &uni : mUniformInterface) {
+        nLocations = std::max(nLocations, static_cast<uint32_t>(uni.location + uni.arraySize));
+    }
+    mUniformLocations.assign(nLocations, GLOVE_INVALID_OFFSET);
+    for(uint32_t i = 0; i < mLiveUniforms; ++i) {
+        for(int32_t j = 0; j < mUniformInterface[i].arraySize; ++j) {
+            mUniformLocations[mUniformInterface[i].location + j] = i;
+        }
     }
 
     for(uint32_t i = 0; i < mShaderReflection->GetLiveUniformBlocks(); ++i) {
@@ -97,6 +134,13 @@ ShaderResourceInterface::CreateInterface(void)
                                             mShaderReflection->GetUniformBlockBlockStage(i),
                                             mShaderReflection->GetUniformBlockOpaque(i));
     }
+
+    mUniformBlockDataInterface.resize(mLiveUniformBlocks);
+    for(uint32_t i = 0; i < mLiveUniforms; ++i) {
+        if(mUniformInterface[i].index < mLiveUniformBlocks) {
+            mUniformBlockDataInterface[mUniformInterface[i].index].uniforms.push_back(i);
+        }
+    }
 }
 
 void
@@ -104,14 +148,19 @@ ShaderResourceInterface::AllocateUniformClientData(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(auto& uni : mUniformInterface) {
-        size_t   size = uni.arraySize * GlslTypeToSize(uni.type);
-        uint8_t* data = new uint8_t[size];
-        memset(static_cast<void *>(data), 0, size);
-
-        mUniformDataInterface.insert(make_pair(uni.name, uniformData()));
-        map<std::string, uniformData>::iterator it = mUniformDataInterface.find(uni.name);
-        it->second.pClientData = data;
+    /// All client data live in a single zero-initialized allocation
+    size_t totalSize = 0;
+    for(const auto& uni : mUniformInterface) {
+        totalSize += uni.arraySize * GlslTypeToSize(uni.type);
+    }
+    mUniformClientData.assign(totalSize, 0);
+
+    mUniformDataInterface.clear();
+    mUniformDataInterface.reserve(mUniformInterface.size());
+    size_t offset = 0;
+    for(const auto& uni : mUniformInterface) {
+        mUniformDataInterface.emplace_back(mUniformClientData.data() + offset);
+        offset += uni.arraySize * GlslTypeToSize(uni.type);
     }
 }
 
@@ -120,41 +169,26 @@ ShaderResourceInterface::AllocateUniformBufferObjects(const vulkanAPI::vkContext
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(auto &uniBlock : mUniformBlockInterface) {
-        if(!uniBlock.isOpaque) {
-
-            mUniformBlockDataInterface.insert(make_pair(uniBlock.name, uniformBlockData()));
-            map<std::string, uniformBlockData>::iterator it = mUniformBlockDataInterface.find(uniBlock.name);
-
-            it->second.pBufferObject = new UniformBufferObject(vkContext);
-            it->second.pBufferObject->Allocate(uniBlock.memorySize, nullptr);
+    for(uint32_t i = 0; i < mLiveUniformBlocks; ++i) {
+        if(!mUniformBlockInterface[i].isOpaque) {
+            mUniformBlockDataInterface[i].pBufferObject = new UniformBufferObject(vkContext);
+            mUniformBlockDataInterface[i].pBufferObject->Allocate(mUniformBlockInterface[i].memorySize, nullptr);
         }
     }
 
     return true;
 }
 
-UniformBufferObject *
-ShaderResourceInterface::GetUniformBufferObject(uint32_t index) const
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    map<std::string, uniformBlockData>::const_iterator itBlock = mUniformBlockDataInterface.find(mUniformBlockInterface[index].name);
-    return itBlock->second.pBufferObject;
-}
-
 const ShaderResourceInterface::uniform *
 ShaderResourceInterface::GetUniformAtLocation(uint32_t loc) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(const auto &uniform : mUniformInterface) {
-        if(loc >= (uint32_t)uniform.location && loc < (uint32_t)(uniform.location + uniform.arraySize)) {
-            return &uniform;
-        }
+    if(loc >= mUniformLocations.size() || mUniformLocations[loc] == GLOVE_INVALID_OFFSET) {
+        return nullptr;
     }
 
-    return nullptr;
+    return &mUniformInterface[mUniformLocations[loc]];
 }
 
 int
@@ -194,21 +228,11 @@ ShaderResourceInterface::GetUniformClientData(uint32_t location, size_t size, vo
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    const ShaderResourceInterface::uniform *uniform = GetUniformAtLocation(location);
+    const uint32_t index   = mUniformLocations[location];
+    const uniform &uni     = mUniformInterface[index];
+    size_t arrayOffset     = (location - uni.location) * GlslTypeToSize(uni.type);
 
-    size_t arrayOffset = (location - uniform->location) * GlslTypeToSize(uniform->type);
-
-    map<std::string, uniformData>::const_iterator it = mUniformDataInterface.find(uniform->name);
-    memcpy(ptr, static_cast<const void *>(it->second.pClientData + arrayOffset), size);
-}
-
-const uint8_t*
-ShaderResourceInterface::GetUniformClientData(uint32_t index) const
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    map<std::string, uniformData>::const_iterator it = mUniformDataInterface.find(mUniformInterface[index].name);
-    return it->second.pClientData;
+    memcpy(ptr, static_cast<const void *>(mUniformDataInterface[index].pClientData + arrayOffset), size);
 }
 
 int
@@ -258,20 +282,13 @@ ShaderResourceInterface::SetUniformClientData(uint32_t location, size_t size, co
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    ShaderResourceInterface::uniform *uniform = nullptr;
-    for(auto &uni: mUniformInterface) {
-        if(location >= (uint32_t)uni.location && location < (uint32_t)(uni.location + uni.arraySize)) {
-            uniform = &uni;
-            break;
-        }
-    }
+    const uint32_t index   = mUniformLocations[location];
+    const uniform &uni     = mUniformInterface[index];
+    size_t arrayOffset     = (location - uni.location) * GlslTypeToSize(uni.type);
 
-    size_t arrayOffset = (location - uniform->location) * GlslTypeToSize(uniform->type);
-
-    map<std::string, uniformData>::iterator it = mUniformDataInterface.find(uniform->name);
-    memcpy(static_cast<void *>(it->second.pClientData + arrayOffset), ptr, size);
-
-    it->second.clientDataDirty = true;
+    uniformData &data      = mUniformDataInterface[index];
+    memcpy(static_cast<void *>(data.pClientData + arrayOffset), ptr, size);
+    data.clientDataDirty   = true;
 }
 
 void
@@ -281,16 +298,16 @@ ShaderResourceInterface::SetUniformSampler(uint32_t location, int count, const i
 
     while(count--) {
 
-        const ShaderResourceInterface::uniform *uniformSampler = GetUniformAtLocation(location);
-        map<std::string, uniformData>::iterator it = mUniformDataInterface.find(uniformSampler->name);
-
-        size_t arrayOffset = (location - uniformSampler->location) * GlslTypeToSize(uniformSampler->type);
+        const uint32_t index = mUniformLocations[location];
+        const uniform &uni   = mUniformInterface[index];
+        size_t arrayOffset   = (location - uni.location) * GlslTypeToSize(uni.type);
+        glsl_sampler_t *unit = reinterpret_cast<glsl_sampler_t *>(mUniformDataInterface[index].pClientData + arrayOffset);
 
         /// Make sure textureUnit is inside [0, GLOVE_MAX_COMBINED_TEXTURE_IMAGE_UNITS)
         if(*textureUnit >= GL_TEXTURE0 && *textureUnit < GL_TEXTURE0 + GLOVE_MAX_COMBINED_TEXTURE_IMAGE_UNITS) {
-            *((glsl_sampler_t *)(it->second.pClientData + arrayOffset)) = (glsl_sampler_t)(*textureUnit - GL_TEXTURE0);
+            *unit = (glsl_sampler_t)(*textureUnit - GL_TEXTURE0);
         } else {
-            *((glsl_sampler_t *)(it->second.pClientData + arrayOffset)) = (glsl_sampler_t)(*textureUnit);
+            *unit = (glsl_sampler_t)(*textureUnit);
         }
 
         ++textureUnit;
@@ -348,52 +365,23 @@ ShaderResourceInterface::UpdateAttributeInterface(void)
 }
 
 bool
-ShaderResourceInterface::UpdateUniformBufferData(const vulkanAPI::vkContext_t *vkContext, bool *allocatedNewBufferObject)
+ShaderResourceInterface::UpdateUniformBufferData(const vulkanAPI::vkContext_t *vkContext, CacheManager *cacheManager, bool *allocatedNewBufferObject)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint32_t blockIndex=0;
-    bool     blockDataDirty;
-
-    struct uniformDirty {
-        size_t       offset;
-        size_t       size;
-        const void * data;
-    };
-
-    for(auto &uniBlock : mUniformBlockInterface) {
-
-        map<std::string, uniformBlockData>::iterator itBlock = mUniformBlockDataInterface.find(uniBlock.name);
-
-        blockDataDirty = false;
-        std::vector<struct uniformDirty> uniformInterfaceDirty;
-        for(auto &uniform : mUniformInterface) {
+    for(uint32_t blockIndex = 0; blockIndex < mLiveUniformBlocks; ++blockIndex) {
 
-            // if does not belong to Block
-            if(uniform.index != blockIndex) {
-                continue;
-            }
-
-            map<std::string, uniformData>::iterator itUniform = mUniformDataInterface.find(uniform.name);
-
-            // check if is updated
-            if(!itUniform->second.clientDataDirty) {
-               continue;
-            }
-            itUniform->second.clientDataDirty = false;
-
-            blockDataDirty = true;
-            if(IsBuildInUniform(uniform.name)) {
-                blockDataDirty = false;
-            }
+        uniformBlockData &blockData = mUniformBlockDataInterface[blockIndex];
+        if(!blockData.pBufferObject) {
+            continue;
+        }
 
-            // compute uniform size
-            for (size_t i = 0; i < (size_t)uniform.arraySize; i++) {
-                struct uniformDirty newUniformDirty;
-                newUniformDirty.size   = GlslTypeToSize(uniform.type);
-                newUniformDirty.offset = uniform.offset + i*GlslTypeToAllignment(uniform.type);
-                newUniformDirty.data   = static_cast<const void *>(itUniform->second.pClientData + i*newUniformDirty.size);
-                uniformInterfaceDirty.push_back(newUniformDirty);
+        /// Only a change in a user uniform requires a new buffer, built-in ones are updated in place
+        bool blockDataDirty = false;
+        for(auto index : blockData.uniforms) {
+            if(mUniformDataInterface[index].clientDataDirty && !mUniformInterface[index].isBuiltIn) {
+                blockDataDirty = true;
+                break;
             }
         }
 
@@ -402,31 +390,40 @@ ShaderResourceInterface::UpdateUniformBufferData(const vulkanAPI::vkContext_t *v
             size_t   srcSize = 0;
             uint8_t *srcData = nullptr;
 
-            if(itBlock->second.pBufferObject && itBlock->second.pBufferObject->GetSize() > 0) {
-                mCacheManager->CacheUBO(itBlock->second.pBufferObject);
+            if(blockData.pBufferObject->GetSize() > 0) {
+                cacheManager->CacheUBO(blockData.pBufferObject);
 
                 // memcopy data
-                srcSize = itBlock->second.pBufferObject->GetSize();
+                srcSize = blockData.pBufferObject->GetSize();
                 srcData = new uint8_t[srcSize];
-                itBlock->second.pBufferObject->GetData(srcSize, 0, srcData);
+                blockData.pBufferObject->GetData(srcSize, 0, srcData);
 
                 *allocatedNewBufferObject = true;
             }
 
-            itBlock->second.pBufferObject = new UniformBufferObject(vkContext);
-            itBlock->second.pBufferObject->Allocate(uniBlock.memorySize, srcData);
+            blockData.pBufferObject = new UniformBufferObject(vkContext);
+            blockData.pBufferObject->Allocate(mUniformBlockInterface[blockIndex].memorySize, srcData);
 
             if(srcSize) {
                 delete[] srcData;
             }
         }
 
-        for (auto &u : uniformInterfaceDirty) {
-            itBlock->second.pBufferObject->UpdateData(u.size, u.offset, u.data);
-        }
+        for(auto index : blockData.uniforms) {
+            uniformData &data = mUniformDataInterface[index];
+            if(!data.clientDataDirty) {
+                continue;
+            }
+            data.clientDataDirty = false;
 
-        ++blockIndex;
+            const uniform &uni  = mUniformInterface[index];
+            const size_t size   = GlslTypeToSize(uni.type);
+            const size_t stride = GlslTypeToAllignment(uni.type);
+            for(size_t i = 0; i < (size_t)uni.arraySize; ++i) {
+                blockData.pBufferObject->UpdateData(size, uni.offset + i*stride, data.pClientData + i*size);
+            }
+        }
     }
 
     return true;
-}
\ No newline at end of file
+}
@@ -54,14 +54,16 @@ public:
         int32_t                     arraySize;
         GLenum                      type;
         size_t                      offset;
+        bool                        isBuiltIn;
 
-        uniform(string n, uint32_t l, uint32_t i, int32_t a, GLenum t, size_t o)
+        uniform(string n, uint32_t l, uint32_t i, int32_t a, GLenum t, size_t o, bool b)
          : name(n),
            location(l),
            index(i),
            arraySize(a),
            type(t),
-           offset(o)
+           offset(o),
+           isBuiltIn(b)
         {
             FUN_ENTRY(GL_LOG_TRACE);
         }
@@ -73,25 +75,15 @@ public:
         uint8_t                    *pClientData;
         bool                        clientDataDirty;
 
-        uniformData()
-         : pClientData(nullptr),
+        uniformData(uint8_t *d)
+         : pClientData(d),
            clientDataDirty(false)
         {
             FUN_ENTRY(GL_LOG_TRACE);
         }
-
-        ~uniformData()
-        {
-            FUN_ENTRY(GL_LOG_TRACE);
-
-            if(pClientData) {
-                delete[] pClientData;
-                pClientData = nullptr;
-            }
-        }
     };
     typedef struct uniformData              uniformData;
-    typedef map<string, uniformData>        uniformDataInterface;
+    typedef vector<uniformData>             uniformDataInterface;
 
     struct uniformBlock {
         string                      name;
@@ -115,25 +107,16 @@ public:
 
     struct uniformBlockData {
         UniformBufferObject *       pBufferObject;
+        vector<uint32_t>            uniforms;
 
         uniformBlockData()
          : pBufferObject(nullptr)
         {
             FUN_ENTRY(GL_LOG_TRACE);
         }
-
-        ~uniformBlockData()
-        {
-            FUN_ENTRY(GL_LOG_TRACE);
-
-            if(pBufferObject) {
-                delete pBufferObject;
-                pBufferObject = nullptr;
-            }
-        }
     };
     typedef struct uniformBlockData         uniformBlockData;
-    typedef map<string, uniformBlockData>   uniformBlockDataInterface;
+    typedef vector<uniformBlockData>        uniformBlockDataInterface;
 
     typedef map<string, uint32_t>           attribsLayout_t;
 
@@ -152,14 +135,16 @@ private:
 
     uniformInterface                        mUniformInterface;
     uniformDataInterface                    mUniformDataInterface;
+    vector<uint8_t>                         mUniformClientData;
+    vector<uint32_t>                        mUniformLocations;
 
     uniformBlockInterface                   mUniformBlockInterface;
     uniformBlockDataInterface               mUniformBlockDataInterface;
 
     attribsLayout_t                         mCustomAttributesLayout;
-    CacheManager*                           mCacheManager;
 
-    void                                    Reset(void);
+    void                                    Reset(CacheManager *cacheManager);
+    void                                    ReleaseUniformBufferObjects(CacheManager *cacheManager);
 
 public:
     ShaderResourceInterface();
@@ -190,8 +175,8 @@ public:
            void                             GetUniformClientData(uint32_t loc,
                                                                  size_t size,
                                                                  void *ptr)        const;
-	const  uint8_t                         *GetUniformClientData(uint32_t index)   const;
-	UniformBufferObject                    *GetUniformBufferObject(uint32_t index) const;
+    inline const uint8_t                   *GetUniformClientData(uint32_t index)   const { FUN_ENTRY(GL_LOG_TRACE); return mUniformDataInterface[index].pClientData; }
+    inline UniformBufferObject             *GetUniformBufferObject(uint32_t index) const { FUN_ENTRY(GL_LOG_TRACE); return mUniformBlockDataInterface[index].pBufferObject; }
 
 
     inline uint32_t                         GetUniformBlockBinding(uint32_t index) const { FUN_ENTRY(GL_LOG_TRACE); return mUniformBlockInterface[index].binding; }
@@ -204,7 +189,6 @@ public:
     const attribute                        *GetVertexAttribute(int index)          const { FUN_ENTRY(GL_LOG_TRACE); return &(*(mAttributeInterface.cbegin() + index)); }
 
 /// Set Functions
-    inline void                             SetCacheManager(CacheManager *cacheManager)          { FUN_ENTRY(GL_LOG_TRACE); mCacheManager     = cacheManager; }
     inline void                             SetReflection(ShaderReflection* reflection)          { FUN_ENTRY(GL_LOG_TRACE); mShaderReflection = reflection; };
     inline void                             SetReflectionSize(void)                              { FUN_ENTRY(GL_LOG_TRACE); mReflectionSize   = mShaderReflection->GetReflectionSize(); }
     inline void                             SetCustomAttribsLayout(const char *name, int index)  { FUN_ENTRY(GL_LOG_TRACE); mCustomAttributesLayout[std::string(name)] = index; }    
@@ -219,12 +203,13 @@ public:
                                                        const int *textureUnit);
 
 /// Allocate Functions
-    void                                    CreateInterface(void);
+    void                                    CreateInterface(CacheManager *cacheManager);
     void                                    AllocateUniformClientData(void);
 	bool                                    AllocateUniformBufferObjects(const vulkanAPI::vkContext_t *vkContext);
 
 /// Update Functions    
     bool                                    UpdateUniformBufferData(const vulkanAPI::vkContext_t *vkContext,
+                                                                    CacheManager *cacheManager,
                                                                     bool *allocatedNewBufferObject);
     void                                    UpdateAttributeInterface(void);
 
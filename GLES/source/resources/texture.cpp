@@ -29,6 +29,7 @@
 
 #include "texture.h"
 #include "utils/VkToGlConverter.h"
+#include "utils/GlToVkConverter.h"
 #include "utils/glUtils.h"
 #include "context/context.h"
 
@@ -215,21 +216,33 @@ Texture::Allocate(void)
 
     State_t *state = &mState[0][0];
 
+    if(IsEtcCompressedFormat(state->format)) {
+        return AllocateCompressed();
+    }
+
     SetWidth (state->width);
     SetHeight(state->height);
     SetFormat(state->format);
     SetType  (state->type);
     SetInternalFormat(GlFormatToGlInternalFormat(state->format, state->type));
 
-    mExplicitInternalFormat = VkFormatToGlInternalformat(mImage->GetFormat());
+    // luminance/alpha data is kept as is in R8/R8G8 images and the GL semantics
+    // are restored through the image view swizzle. Any other format that the
+    // device does not support natively has already been promoted to RGBA8 and
+    // it is converted on upload.
+    const VkFormat vkformat = mImage->GetFormat();
+    if(vkformat == VK_FORMAT_R8_UNORM || vkformat == VK_FORMAT_R8G8_UNORM) {
+        mExplicitInternalFormat = mInternalFormat;
+    } else {
+        mExplicitInternalFormat = VkFormatToGlInternalformat(vkformat);
+    }
     mExplicitType           = GlInternalFormatToGlType(mExplicitInternalFormat);
+    mImageView->SetComponentMapping(GlColorFormatToVkComponentMapping(mFormat, vkformat));
 
     if(!CreateVkTexture()) {
         return false;
     }
 
-    // NOTE:: there is an implicit conversion of all textures to GL_RGBA
-    // TODO:: this should definitely NOT be the case
     GLenum srcInternalFormat = mInternalFormat;
     GLenum dstInternalFormat = mExplicitInternalFormat;
     GLenum dstType = mExplicitType;
@@ -253,6 +266,70 @@ Texture::Allocate(void)
     return true;
 }
 
+bool
+Texture::AllocateCompressed(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    State_t *state = &mState[0][0];
+
+    SetWidth (state->width);
+    SetHeight(state->height);
+    SetFormat(state->format);
+    SetType  (state->type);
+    SetInternalFormat(state->format);
+
+    // the blocks are either uploaded as is, or decoded to RGBA8 when the device
+    // cannot sample the requested block format
+    const VkFormat vkformat = mImage->GetFormat();
+    const bool     native   = vkformat != VK_FORMAT_R8G8B8A8_UNORM;
+    mExplicitInternalFormat = native ? mInternalFormat : GL_RGBA8_OES;
+    mExplicitType           = GL_UNSIGNED_BYTE;
+    mImageView->SetComponentMapping(GlColorFormatToVkComponentMapping(mFormat, vkformat));
+
+    // block compressed images can be neither rendered to nor linearly tiled
+    const VkImageUsageFlagBits usage  = mImage->GetImageUsage();
+    const VkImageTiling        tiling = mImage->GetImageTiling();
+    if(native) {
+        mImage->SetImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_SAMPLED_BIT      |
+                                                                VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                                                VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
+        mImage->SetImageTiling(VK_IMAGE_TILING_OPTIMAL);
+    }
+
+    const bool created = CreateVkTexture();
+    mImage->SetImageUsage(usage);
+    mImage->SetImageTiling(tiling);
+    if(!created) {
+        return false;
+    }
+
+    for(GLint layer = 0; layer < mLayersCount; ++layer) {
+        for(GLint level = 0; level < mMipLevelsCount; ++level) {
+            state = &mState[layer][level];
+            if(state->data == nullptr) {
+                continue;
+            }
+
+            if(native) {
+                Rect rect(0, 0, state->width, state->height);
+                BufferObject *tbo = new TransferSrcBufferObject(mVkContext);
+                tbo->Allocate(GetEtcCompressedImageSize(mFormat, state->width, state->height), state->data);
+                SubmitCopyPixels(&rect, tbo, level, layer, mFormat, true);
+                delete tbo;
+            } else {
+                ImageRect rect(0, 0, state->width, state->height, 4, 1, Texture::GetDefaultInternalAlignment());
+                uint8_t *pixels = new uint8_t[rect.GetRectBufferSize()];
+                DecodeEtcImage(mFormat, state->width, state->height, state->data, pixels);
+                CopyPixelsFromHost(&rect, &rect, level, layer, GL_RGBA8_OES, pixels);
+                delete[] pixels;
+            }
+        }
+    }
+
+    return true;
+}
+
 void
 Texture::SetState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLenum type, GLint unpackAlignment, const void *pixels)
 {
@@ -343,6 +420,79 @@ Texture::SetSubState(ImageRect *srcRect, ImageRect *dstRect, GLint level, GLint
     SetDataUpdated(true);
 }
 
+void
+Texture::SetCompressedState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum internalformat, const void *data)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // compressed levels are kept in their block layout until allocation
+    mState[layer][level].width  = width;
+    mState[layer][level].height = height;
+    mState[layer][level].format = internalformat;
+    mState[layer][level].type   = GL_UNSIGNED_BYTE;
+
+    if(mState[layer][level].data) {
+        delete [] (uint8_t *)mState[layer][level].data;
+        mState[layer][level].data = nullptr;
+    }
+
+    if(data) {
+        const size_t size = GetEtcCompressedImageSize(internalformat, width, height);
+        mState[layer][level].data = new uint8_t[size];
+        memcpy(mState[layer][level].data, data, size);
+    }
+}
+
+bool
+Texture::GetCompressedLevelSize(GLint level, GLint layer, GLint *width, GLint *height, GLenum *format) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // look the level up without adding an undefined one to the map
+    const auto it = mState[layer].find(static_cast<uint32_t>(level));
+    if(it == mState[layer].end() || !IsEtcCompressedFormat(it->second.format)) {
+        return false;
+    }
+
+    *width  = it->second.width;
+    *height = it->second.height;
+    *format = it->second.format;
+
+    return true;
+}
+
+void
+Texture::SetCompressedSubState(GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLint level, GLint layer, const void *data)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    State_t *state = &mState[layer][level];
+    const size_t blockSize = GetEtcBlockSize(state->format);
+    if(state->data == nullptr) {
+        const size_t size = GetEtcCompressedImageSize(state->format, state->width, state->height);
+        state->data = new uint8_t[size];
+        memset(state->data, 0, size);
+    }
+
+    if(data) {
+        // offsets are block aligned, so the update is a copy of whole block rows
+        const size_t dstStride = ((state->width + ETC_BLOCK_DIM - 1) / ETC_BLOCK_DIM) * blockSize;
+        const size_t srcStride = ((width        + ETC_BLOCK_DIM - 1) / ETC_BLOCK_DIM) * blockSize;
+        const GLint  rows      =  (height       + ETC_BLOCK_DIM - 1) / ETC_BLOCK_DIM;
+
+        const uint8_t *src = static_cast<const uint8_t *>(data);
+              uint8_t *dst = static_cast<uint8_t *>(state->data) + (yoffset / ETC_BLOCK_DIM) * dstStride
+                                                                  + (xoffset / ETC_BLOCK_DIM) * blockSize;
+        for(GLint row = 0; row < rows; ++row) {
+            memcpy(dst, src, srcStride);
+            src += srcStride;
+            dst += dstStride;
+        }
+    }
+
+    SetDataUpdated(true);
+}
+
 void Texture::CopyPixelsToHost(ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum dstFormat, void *dstData)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
@@ -427,10 +577,41 @@ void Texture::CopyPixelsFromHost(ImageRect *srcRect, ImageRect *dstRect, GLint m
  #endif
 }
 
+BufferObject *Texture::CopyPixelsToBuffer(VkCommandBuffer *cmdBuffer, const ImageRect *srcRect, GLint miplevel, GLint layer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the copy is only recorded, the caller owns the buffer and must not read it
+    // back before the command buffer has completed execution
+    BufferObject *tbo = new TransferDstBufferObject(mVkContext);
+    if(!tbo->Allocate(srcRect->GetRectBufferSize(), nullptr)) {
+        delete tbo;
+        return nullptr;
+    }
+
+    RecordCopyPixels(cmdBuffer, srcRect, tbo, miplevel, layer, false);
+
+    return tbo;
+}
+
 void Texture::SubmitCopyPixels(const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, GLenum srcFormat, bool copyToImage)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    assert(GetCurrentContext());
+    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
+    commandBufferManager->BeginVkAuxCommandBuffer();
+    VkCommandBuffer activeCmdBuffer = commandBufferManager->GetAuxCommandBuffer();
+    RecordCopyPixels(&activeCmdBuffer, rect, tbo, miplevel, layer, copyToImage);
+    commandBufferManager->EndVkAuxCommandBuffer();
+    commandBufferManager->SubmitVkAuxCommandBuffer();
+    commandBufferManager->WaitVkAuxCommandBuffer();
+}
+
+void Texture::RecordCopyPixels(VkCommandBuffer *cmdBuffer, const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, bool copyToImage)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
     mImage->CreateBufferImageCopy(rect->x, rect->y, rect->width, rect->height, miplevel, layer, 1);
     mImage->ModifyImageSubresourceRange(miplevel, 1, layer, 1);
 
@@ -439,22 +620,13 @@ void Texture::SubmitCopyPixels(const Rect *rect, BufferObject *tbo, GLint miplev
                       oldImageLayout != VK_IMAGE_LAYOUT_PREINITIALIZED) ? oldImageLayout : VK_IMAGE_LAYOUT_GENERAL;
     VkImageLayout newImageLayout = copyToImage ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
 
-    assert(GetCurrentContext());
-    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
-    commandBufferManager->BeginVkAuxCommandBuffer();
-    VkCommandBuffer activeCmdBuffer = commandBufferManager->GetAuxCommandBuffer();
-    {
-        mImage->ModifyImageLayout(&activeCmdBuffer, newImageLayout);
-        if(copyToImage) {
-            mImage->CopyBufferToImage(&activeCmdBuffer, tbo->GetVkBuffer());
-        } else {
-            mImage->CopyImageToBuffer(&activeCmdBuffer, tbo->GetVkBuffer());
-        }
-        mImage->ModifyImageLayout(&activeCmdBuffer, oldImageLayout);
+    mImage->ModifyImageLayout(cmdBuffer, newImageLayout);
+    if(copyToImage) {
+        mImage->CopyBufferToImage(cmdBuffer, tbo->GetVkBuffer());
+    } else {
+        mImage->CopyImageToBuffer(cmdBuffer, tbo->GetVkBuffer());
     }
-    commandBufferManager->EndVkAuxCommandBuffer();
-    commandBufferManager->SubmitVkAuxCommandBuffer();
-    commandBufferManager->WaitVkAuxCommandBuffer();
+    mImage->ModifyImageLayout(cmdBuffer, oldImageLayout);
 }
 
 void
@@ -475,6 +647,20 @@ Texture::PrepareVkImageLayout(VkImageLayout newImageLayout)
     commandBufferManager->WaitVkAuxCommandBuffer();
 }
 
+void
+Texture::PrepareVkImageLayout(VkCommandBuffer *cmdBuffer, VkImageLayout newImageLayout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the layout is tracked on the host, images already in place need no barrier
+    if(mImage->GetImageLayout() == newImageLayout) {
+        return;
+    }
+
+    mImage->ModifyImageSubresourceRange(0, mMipLevelsCount, 0, mLayersCount);
+    mImage->ModifyImageLayout(cmdBuffer, newImageLayout);
+}
+
 void
 Texture::InvertPixels()
 {
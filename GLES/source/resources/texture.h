@@ -31,6 +31,7 @@
 #include "vulkan/sampler.h"
 #include "vulkan/imageView.h"
 #include "utils/GlToVkConverter.h"
+#include "utils/etcDecoder.h"
 
 #define ISPOWEROFTWO(x)           ((x != 0) && !(x & (x - 1)))
 
@@ -83,6 +84,7 @@ private:
     static int                  mDefaultInternalAlignment;
 
     bool                        AllocateVkMemory(void);
+    bool                        AllocateCompressed(void);
     void                        ReleaseVkResources(void);
 
 public:
@@ -94,6 +96,8 @@ public:
     bool                    Allocate();
     void                    SetState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLenum type, GLint unpackAlignment, const void *pixels);
     void                    SetSubState(ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData);
+    void                    SetCompressedState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum internalformat, const void *data);
+    void                    SetCompressedSubState(GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLint level, GLint layer, const void *data);
     void                    GenerateMipmaps(GLenum hintMipmapMode);
 
 // Init Functions
@@ -104,6 +108,7 @@ public:
     static int              GetDefaultInternalAlignment()                       { FUN_ENTRY(GL_LOG_TRACE); return mDefaultInternalAlignment; }
     inline int              GetInvertedYOrigin(const Rect* rect)                { FUN_ENTRY(GL_LOG_TRACE); return mDims.height - rect->height - rect->y; }
     void                    PrepareVkImageLayout(VkImageLayout newImageLayout);
+    void                    PrepareVkImageLayout(VkCommandBuffer *cmdBuffer, VkImageLayout newImageLayout);
 
 // Create Functions
     bool                    CreateVkTexture(void);
@@ -115,7 +120,9 @@ public:
 // Copy Functions
      void                   CopyPixelsFromHost (ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData);
      void                   CopyPixelsToHost   (ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum dstFormat, void *dstData);
+     BufferObject*          CopyPixelsToBuffer (VkCommandBuffer *cmdBuffer, const ImageRect *srcRect, GLint miplevel, GLint layer);
      void                   SubmitCopyPixels   (const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, GLenum dstFormat, bool copyToImage);
+     void                   RecordCopyPixels   (VkCommandBuffer *cmdBuffer, const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, bool copyToImage);
      void                   InvertPixels       (void);
 
 // Get Functions
@@ -134,6 +141,7 @@ public:
     inline GLint            GetLayersCount(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mLayersCount; }
     inline GLint            GetMipLevelsCount(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return mMipLevelsCount; }
     inline bool             GetDataUpdated(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mDataUpdated; }
+           bool             GetCompressedLevelSize(GLint level, GLint layer, GLint *width, GLint *height, GLenum *format) const;
     
     inline Texture         *GetDepthStencilTexture(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilTexture;}
     inline uint32_t         GetDepthStencilTextureRefCount(void)        const   { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilTextureRefCount; }
@@ -144,7 +152,9 @@ public:
     inline VkFormat         GetVkFormat(void)                           const   { FUN_ENTRY(GL_LOG_TRACE); return mImage->GetFormat(); }
     inline VkImageLayout    GetVkImageLayout(void)                      const   { FUN_ENTRY(GL_LOG_TRACE); return mImage->GetImageLayout(); }
     inline VkImageView      GetVkImageView(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mImageView->GetImageView(); }
+    inline VkSampleCountFlagBits GetVkImageSamples(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mImage->GetSampleCount(); }
     VkFormat                FindSupportedVkColorFormat(VkFormat format)         { FUN_ENTRY(GL_LOG_TRACE); return mImage->FindSupportedVkColorFormat(format); }
+    VkFormat                FindSupportedVkCompressedFormat(VkFormat format)    { FUN_ENTRY(GL_LOG_TRACE); return mImage->FindSupportedVkCompressedFormat(format); }
 
 // Set Functions
     inline void             SetVkContext(const vulkanAPI::vkContext_t *vkContext) { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext;
@@ -182,6 +192,7 @@ public:
     inline void             SetVkImageLayout(VkImageLayout layout)              { FUN_ENTRY(GL_LOG_TRACE); mImage->SetImageLayout(layout); }
     inline void             SetVkImageTiling(VkImageTiling tiling)              { FUN_ENTRY(GL_LOG_TRACE); mImage->SetImageTiling(tiling); }
     inline void             SetVkImageTiling(void)                              { FUN_ENTRY(GL_LOG_TRACE); mImage->SetImageTiling();       }
+    inline void             SetVkImageSamples(VkSampleCountFlagBits samples)    { FUN_ENTRY(GL_LOG_TRACE); mImage->SetSampleCount(samples); }
     inline void             SetVkImageTarget(vulkanAPI::Image::VkImageTarget
                                                                      target)    { FUN_ENTRY(GL_LOG_TRACE); mImage->SetImageTarget(target); }
 
@@ -191,12 +202,7 @@ public:
 
 // Is Functions
     inline bool             IsCubeMap(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mTarget  == GL_TEXTURE_CUBE_MAP; }
-    inline bool             IsCompressed(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return (mFormat != GL_ALPHA           &&
-                                                                                                                   mFormat != GL_RGB             &&
-                                                                                                                   mFormat != GL_RGBA            &&
-                                                                                                                   mFormat != GL_LUMINANCE       &&
-                                                                                                                   mFormat != GL_LUMINANCE_ALPHA &&
-                                                                                                                   mFormat != GL_BGRA8_EXT); }
+    inline bool             IsCompressed(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return IsEtcCompressedFormat(mFormat); }
            bool             IsNPOT(void);
            bool             IsNPOTAccessCompleted(void);
            bool             IsCompleted(void);
@@ -0,0 +1,177 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       vertexArrayObject.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Vertex Array Object Functionality in GLOVE (GL_OES_vertex_array_object)
+ *
+ *  A vertex array object holds the generic vertex attribute arrays and the
+ *  element array buffer binding. It also caches the Vulkan vertex input state
+ *  derived from them, which is regenerated only when one of its attribute
+ *  arrays is respecified or the program consumes a different set of locations.
+ */
+
+#include "vertexArrayObject.h"
+
+VertexArrayObject::VertexArrayObject(const vulkanAPI::vkContext_t *vkContext)
+: mGenericVertexAttributes(GLOVE_MAX_VERTEX_ATTRIBS), mElementArrayBuffer(nullptr),
+  mUpdateVertexInput(true), mVertexInputLocations(0)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    memset(static_cast<void *>(mBindingLocations), 0, sizeof(mBindingLocations));
+
+    mVkPipelineVertexInput.sType                            = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    mVkPipelineVertexInput.pNext                            = nullptr;
+    mVkPipelineVertexInput.flags                            = 0;
+    mVkPipelineVertexInput.vertexBindingDescriptionCount    = 0;
+    mVkPipelineVertexInput.pVertexBindingDescriptions       = mVkVertexInputBinding;
+    mVkPipelineVertexInput.vertexAttributeDescriptionCount  = 0;
+    mVkPipelineVertexInput.pVertexAttributeDescriptions     = mVkVertexInputAttribute;
+
+    SetVkContext(vkContext);
+}
+
+VertexArrayObject::~VertexArrayObject()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(auto& gva : mGenericVertexAttributes) {
+        gva.Release();
+    }
+    mGenericVertexAttributes.clear();
+}
+
+void
+VertexArrayObject::SetVkContext(const vulkanAPI::vkContext_t *vkContext)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto& gva : mGenericVertexAttributes) {
+        gva.SetVkContext(vkContext);
+    }
+}
+
+void
+VertexArrayObject::SetCacheManager(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto& gva : mGenericVertexAttributes) {
+        gva.SetCacheManager(cacheManager);
+    }
+}
+
+void
+VertexArrayObject::SetGenericValues(VertexArrayObject *vao)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the current generic values are context state and follow the bound vao
+    GLfloat genericValue[4];
+    for(uint32_t i = 0; i < GLOVE_MAX_VERTEX_ATTRIBS; ++i) {
+        vao->GetGenericVertexAttribute(i)->GetGenericValue(genericValue);
+        mGenericVertexAttributes[i].SetGenericValue(genericValue);
+    }
+}
+
+uint32_t
+VertexArrayObject::FindSharedBinding(uint32_t location, uint32_t bindingCount) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // client-side arrays, generic values and converted GL_FIXED data are sourced
+    // from a VBO of their own, so only buffer object arrays may share a binding
+    const GenericVertexAttribute& gva = mGenericVertexAttributes[location];
+    if(!gva.IsEnabled() || gva.IsInternalVBO() || gva.GetType() == GL_FIXED) {
+        return bindingCount;
+    }
+
+    for(uint32_t binding = 0; binding < bindingCount; ++binding) {
+        const GenericVertexAttribute& bgva = mGenericVertexAttributes[mBindingLocations[binding]];
+        if(bgva.IsEnabled() && !bgva.IsInternalVBO() && bgva.GetType() != GL_FIXED &&
+           bgva.GetExternalVbo() == gva.GetExternalVbo() && bgva.GetStride() == gva.GetStride()) {
+            return binding;
+        }
+    }
+
+    return bindingCount;
+}
+
+bool
+VertexArrayObject::UpdateVertexInput(uint32_t locations)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!mUpdateVertexInput && mVertexInputLocations == locations) {
+        return false;
+    }
+
+    // create vertex input bindings and attributes
+    uint32_t bindingCount   = 0;
+    uint32_t attributeCount = 0;
+    for(uint32_t location = 0; location < GLOVE_MAX_VERTEX_ATTRIBS; ++location) {
+        if(!(locations & (1u << location))) {
+            continue;
+        }
+
+        const GenericVertexAttribute& gva = mGenericVertexAttributes[location];
+        const uint32_t binding = FindSharedBinding(location, bindingCount);
+        if(binding == bindingCount) {
+            mVkVertexInputBinding[binding].binding   = binding;
+            mVkVertexInputBinding[binding].stride    = static_cast<uint32_t>(gva.GetStride());
+            mVkVertexInputBinding[binding].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+            mBindingLocations[binding] = location;
+            ++bindingCount;
+        }
+
+        mVkVertexInputAttribute[attributeCount].location = location;
+        mVkVertexInputAttribute[attributeCount].binding  = binding;
+        mVkVertexInputAttribute[attributeCount].format   = gva.GetVkFormat();
+        mVkVertexInputAttribute[attributeCount].offset   = gva.GetOffset();
+        ++attributeCount;
+    }
+
+    mVkPipelineVertexInput.vertexBindingDescriptionCount   = bindingCount;
+    mVkPipelineVertexInput.vertexAttributeDescriptionCount = attributeCount;
+
+    mVertexInputLocations = locations;
+    mUpdateVertexInput    = false;
+
+    return true;
+}
+
+bool
+VertexArrayObject::IsSourcedFromBufferObjects(uint32_t locations) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // client-side arrays and converted GL_FIXED data are captured per draw call,
+    // the generic values of disabled arrays do not depend on the vertices drawn
+    for(uint32_t location = 0; location < GLOVE_MAX_VERTEX_ATTRIBS; ++location) {
+        if(!(locations & (1u << location))) {
+            continue;
+        }
+
+        const GenericVertexAttribute& gva = mGenericVertexAttributes[location];
+        if(gva.IsEnabled() && (gva.IsInternalVBO() || gva.GetType() == GL_FIXED)) {
+            return false;
+        }
+    }
+
+    return true;
+}
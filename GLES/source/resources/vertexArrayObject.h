@@ -0,0 +1,67 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       vertexArrayObject.h
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Vertex Array Object Functionality in GLOVE (GL_OES_vertex_array_object)
+ *
+ */
+
+#ifndef __VERTEXARRAYOBJECT_H__
+#define __VERTEXARRAYOBJECT_H__
+
+#include "genericVertexAttribute.h"
+
+class VertexArrayObject {
+private:
+    std::vector<GenericVertexAttribute>             mGenericVertexAttributes;
+    BufferObject                                   *mElementArrayBuffer;
+
+    bool                                            mUpdateVertexInput;
+    uint32_t                                        mVertexInputLocations;
+    uint32_t                                        mBindingLocations[GLOVE_MAX_VERTEX_ATTRIBS];
+
+    VkPipelineVertexInputStateCreateInfo            mVkPipelineVertexInput;
+    VkVertexInputBindingDescription                 mVkVertexInputBinding[GLOVE_MAX_VERTEX_ATTRIBS];
+    VkVertexInputAttributeDescription               mVkVertexInputAttribute[GLOVE_MAX_VERTEX_ATTRIBS];
+
+    uint32_t                                        FindSharedBinding(uint32_t location, uint32_t bindingCount) const;
+
+public:
+    VertexArrayObject(const vulkanAPI::vkContext_t *vkContext = nullptr);
+    ~VertexArrayObject();
+
+    bool                                            UpdateVertexInput(uint32_t locations);
+    bool                                            IsSourcedFromBufferObjects(uint32_t locations) const;
+
+    // Get Functions
+    inline std::vector<GenericVertexAttribute>&     GetGenericVertexAttributes(void)            { FUN_ENTRY(GL_LOG_TRACE); return mGenericVertexAttributes; }
+    inline GenericVertexAttribute                  *GetGenericVertexAttribute(size_t index)     { FUN_ENTRY(GL_LOG_TRACE); return &mGenericVertexAttributes[index]; }
+    inline BufferObject                            *GetElementArrayBuffer(void)           const { FUN_ENTRY(GL_LOG_TRACE); return mElementArrayBuffer; }
+    inline VkPipelineVertexInputStateCreateInfo    *GetVkPipelineVertexInput(void)              { FUN_ENTRY(GL_LOG_TRACE); return &mVkPipelineVertexInput; }
+    inline uint32_t                                 GetBindingCount(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return mVkPipelineVertexInput.vertexBindingDescriptionCount; }
+    inline uint32_t                                 GetBindingLocation(uint32_t binding)  const { FUN_ENTRY(GL_LOG_TRACE); return mBindingLocations[binding]; }
+
+    // Set Functions
+           void                                     SetVkContext(const vulkanAPI::vkContext_t *vkContext);
+           void                                     SetCacheManager(CacheManager *cacheManager);
+           void                                     SetGenericValues(VertexArrayObject *vao);
+    inline void                                     SetElementArrayBuffer(BufferObject *bo)     { FUN_ENTRY(GL_LOG_TRACE); mElementArrayBuffer = bo; }
+    inline void                                     SetUpdateVertexInput(bool enable)           { FUN_ENTRY(GL_LOG_TRACE); mUpdateVertexInput  = enable; }
+};
+
+#endif // __VERTEXARRAYOBJECT_H__
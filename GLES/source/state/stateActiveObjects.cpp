@@ -31,6 +31,7 @@
 
 StateActiveObjects::StateActiveObjects()
 : mActiveShaderProgram(nullptr),
+mActiveVertexArrayObject(nullptr),
 mActiveFramebufferObjectID(0),
 mActiveRenderbufferObjectID(0),
 mActiveTextureUnit(GL_TEXTURE0)
@@ -27,8 +27,10 @@
 #include "resources/shaderProgram.h"
 #include "resources/bufferObject.h"
 #include "resources/texture.h"
+#include "resources/vertexArrayObject.h"
 
-#define GL_BUFFER_TARGET_TO_TYPE(__target__)  ((__target__) == GL_ARRAY_BUFFER ? BUFFER_OBJECT_TARGET_ARRAY : BUFFER_OBJECT_TARGET_ELEMENT)
+#define GL_BUFFER_TARGET_TO_TYPE(__target__)  ((__target__) == GL_ARRAY_BUFFER         ? BUFFER_OBJECT_TARGET_ARRAY   : \
+                                               (__target__) == GL_ELEMENT_ARRAY_BUFFER ? BUFFER_OBJECT_TARGET_ELEMENT : BUFFER_OBJECT_TARGET_PIXEL_PACK)
 #define GL_TEXTURE_TARGET_TO_TYPE(__target__) ((__target__) == GL_TEXTURE_2D ? 0 : 1)
 #define GL_TEXTURE_ENUM_TO_UNIT(__enum__)     ((__enum__) - GL_TEXTURE0)
 
@@ -37,11 +39,13 @@ private:
       typedef enum {
         BUFFER_OBJECT_TARGET_ARRAY = 0,
         BUFFER_OBJECT_TARGET_ELEMENT,
+        BUFFER_OBJECT_TARGET_PIXEL_PACK,
         BUFFER_OBJECT_TARGET_ALL
       } BufferObjectTarget_t;
 
       BufferObject*             mActiveBufferObjects[BUFFER_OBJECT_TARGET_ALL];
       ShaderProgram*            mActiveShaderProgram;
+      VertexArrayObject*        mActiveVertexArrayObject;
       GLuint                    mActiveFramebufferObjectID;
       GLuint                    mActiveRenderbufferObjectID;
       GLenum                    mActiveTextureUnit;
@@ -55,6 +59,7 @@ public:
       inline Texture*           GetActiveTexture(GLenum target)                            { FUN_ENTRY(GL_LOG_TRACE); return mActiveTextures[GL_TEXTURE_TARGET_TO_TYPE(target)][GL_TEXTURE_ENUM_TO_UNIT(mActiveTextureUnit)]; }
       inline Texture*           GetActiveTexture(GLenum target, int j)                     { FUN_ENTRY(GL_LOG_TRACE); return mActiveTextures[GL_TEXTURE_TARGET_TO_TYPE(target)][j]; }
       inline ShaderProgram*     GetActiveShaderProgram(void)                               { FUN_ENTRY(GL_LOG_TRACE); return mActiveShaderProgram; }
+      inline VertexArrayObject* GetActiveVertexArrayObject(void)                           { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexArrayObject; }
       inline BufferObject*      GetActiveBufferObject(BufferObjectTarget_t target)         { FUN_ENTRY(GL_LOG_TRACE); return mActiveBufferObjects[target]; }
       inline BufferObject*      GetActiveBufferObject(GLenum target)                       { FUN_ENTRY(GL_LOG_TRACE); return GetActiveBufferObject(GL_BUFFER_TARGET_TO_TYPE(target)); }
       inline uint32_t           GetActiveFramebufferObjectID(void)                  const  { FUN_ENTRY(GL_LOG_TRACE); return mActiveFramebufferObjectID; }
@@ -68,6 +73,7 @@ public:
       inline void               SetActiveFramebufferObjectID(GLuint id)                    { FUN_ENTRY(GL_LOG_TRACE); mActiveFramebufferObjectID  = id; }
       inline void               SetActiveRenderbufferObjectID(GLuint id)                   { FUN_ENTRY(GL_LOG_TRACE); mActiveRenderbufferObjectID = id; }
       inline void               SetActiveShaderProgram(ShaderProgram *program)             { FUN_ENTRY(GL_LOG_TRACE); mActiveShaderProgram = program; }
+      inline void               SetActiveVertexArrayObject(VertexArrayObject *vao)         { FUN_ENTRY(GL_LOG_TRACE); mActiveVertexArrayObject = vao; }
       inline void               SetActiveBufferObject(BufferObjectTarget_t target,
                                                       BufferObject *bo)                    { FUN_ENTRY(GL_LOG_TRACE); mActiveBufferObjects[target] = bo; }
       inline void               SetActiveBufferObject(GLenum target,
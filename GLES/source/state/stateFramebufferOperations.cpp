@@ -95,11 +95,9 @@ StateFramebufferOperations::StencilMaskActive() const
 {
    FUN_ENTRY(GL_LOG_TRACE);
 
-   if((mStencilMaskBack > 0u && mStencilMaskBack < 0xFFFFFFFFu) ||
-      (mStencilMaskFront > 0u && mStencilMaskFront < 0xFFFFFFFFu)) {
-       return true;
-    }
-    return false;
+   // clears are affected only by the front writemask and only its
+   // lower 8 bits matter for the supported stencil formats
+   return (mStencilMaskFront & 0xFFu) != 0xFFu;
 }
 
 bool
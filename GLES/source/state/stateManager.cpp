@@ -137,9 +137,31 @@ StateManager::InitVkPipelineStates(vulkanAPI::Pipeline *pipeline)
                             backdepthFailOp, backwriteMask, backcompareOp, backcompareMask, backreference, frontfailOp, frontpassOp, frontdepthFailOp, frontwriteMask, frontcompareOp, frontcompareMask, frontreference );
     pipeline->CreateViewportState(viewportCount, scissorCount);
     pipeline->CreateMultisampleState(alphaToOneEnable, alphaToCoverageEnable, rasterizationSamples, sampleShadingEnable, minSampleShading);
+    /// GL state that changes often is set in the command buffer, so that it does not require a new VkPipeline
     std::vector<VkDynamicState> states = {VK_DYNAMIC_STATE_VIEWPORT,
                                           VK_DYNAMIC_STATE_SCISSOR,
-                                          VK_DYNAMIC_STATE_LINE_WIDTH};
+                                          VK_DYNAMIC_STATE_LINE_WIDTH,
+                                          VK_DYNAMIC_STATE_DEPTH_BIAS,
+                                          VK_DYNAMIC_STATE_BLEND_CONSTANTS,
+                                          VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK,
+                                          VK_DYNAMIC_STATE_STENCIL_WRITE_MASK,
+                                          VK_DYNAMIC_STATE_STENCIL_REFERENCE};
+#ifdef VK_EXT_extended_dynamic_state
+    if(vulkanAPI::GetContext()->mIsExtendedDynamicStateSupported) {
+        states.insert(states.end(), {VK_DYNAMIC_STATE_CULL_MODE_EXT,
+                                     VK_DYNAMIC_STATE_FRONT_FACE_EXT,
+                                     VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT,
+                                     VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT,
+                                     VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT,
+                                     VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT,
+                                     VK_DYNAMIC_STATE_STENCIL_OP_EXT});
+    }
+#endif
+#ifdef VK_EXT_extended_dynamic_state2
+    if(vulkanAPI::GetContext()->mIsExtendedDynamicState2Supported) {
+        states.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT);
+    }
+#endif
     pipeline->CreateDynamicState(states);
     pipeline->CreateInfo();
 }
@@ -24,6 +24,7 @@
 #include "GlToVkConverter.h"
 #include "glLogger.h"
 #include "glUtils.h"
+#include "etcDecoder.h"
 
 VkBool32
 GlBooleanToVkBool(GLboolean value)
@@ -345,8 +346,8 @@ VkFormat GlColorFormatToVkColorFormat(GLenum format, GLenum type)
             switch(format) {
                 case GL_RGB:                        return VK_FORMAT_R8G8B8_UNORM;
                 case GL_LUMINANCE:
-                case GL_ALPHA:
-                case GL_LUMINANCE_ALPHA:
+                case GL_ALPHA:                      return VK_FORMAT_R8_UNORM;
+                case GL_LUMINANCE_ALPHA:            return VK_FORMAT_R8G8_UNORM;
                 case GL_RGBA:                       return VK_FORMAT_R8G8B8A8_UNORM;
                 default: { NOT_REACHED();           return VK_FORMAT_UNDEFINED; }
             }
@@ -369,6 +370,25 @@ VkFormat GlColorFormatToVkColorFormat(GLenum format, GLenum type)
     }
 }
 
+VkComponentMapping
+GlColorFormatToVkComponentMapping(GLenum format, VkFormat vkformat)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // luminance and alpha textures are stored in single/dual channel images
+    // and expanded to their GL semantics when sampled
+    if(vkformat == VK_FORMAT_R8_UNORM || vkformat == VK_FORMAT_R8G8_UNORM) {
+        switch(format) {
+        case GL_LUMINANCE:          return {VK_COMPONENT_SWIZZLE_R,    VK_COMPONENT_SWIZZLE_R,    VK_COMPONENT_SWIZZLE_R,    VK_COMPONENT_SWIZZLE_ONE};
+        case GL_ALPHA:              return {VK_COMPONENT_SWIZZLE_ZERO, VK_COMPONENT_SWIZZLE_ZERO, VK_COMPONENT_SWIZZLE_ZERO, VK_COMPONENT_SWIZZLE_R};
+        case GL_LUMINANCE_ALPHA:    return {VK_COMPONENT_SWIZZLE_R,    VK_COMPONENT_SWIZZLE_R,    VK_COMPONENT_SWIZZLE_R,    VK_COMPONENT_SWIZZLE_G};
+        default:                    break;
+        }
+    }
+
+    return {VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A};
+}
+
 VkFormat
 GlAttribPointerToVkFormat(GLint nElements, GLenum type, GLboolean normalized)
 {
@@ -456,3 +476,20 @@ GlToVkIndexType(GLenum type)
     default: NOT_FOUND_ENUM(type);          return VK_INDEX_TYPE_MAX_ENUM;
     }
 }
+
+VkFormat
+GlCompressedFormatToVkFormat(GLenum internalformat)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // ETC1 is a subset of ETC2 and it is sampled through the same format
+    switch(internalformat) {
+    case GL_ETC1_RGB8_OES:
+    case GL_COMPRESSED_RGB8_ETC2:                       return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:   return VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK;
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:                  return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+    case GL_COMPRESSED_R11_EAC:                         return VK_FORMAT_EAC_R11_UNORM_BLOCK;
+    case GL_COMPRESSED_RG11_EAC:                        return VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
+    default: { NOT_REACHED();                           return VK_FORMAT_UNDEFINED; }
+    }
+}
@@ -50,5 +50,7 @@ VkFormat                GlInternalFormatToVkFormat(GLenum internalformatDepth, G
 VkFormat                GlAttribPointerToVkFormat(GLint nElements, GLenum type, GLboolean normalized);
 VkIndexType             GlToVkIndexType(GLenum type);
 VkFormat                GlColorFormatToVkColorFormat(GLenum format, GLenum type);
+VkComponentMapping      GlColorFormatToVkComponentMapping(GLenum format, VkFormat vkformat);
+VkFormat                GlCompressedFormatToVkFormat(GLenum internalformat);
 
 #endif // __GLTOVKCONVERTER_H__
@@ -18,34 +18,129 @@
  *  @version    1.0
  *
  *  @brief      A simple interface is provided for handling all the accesses to
- *              the arrays of classes needed in GLOVE using the map container.
+ *              the arrays of classes needed in GLOVE using a handle table.
  *
  */
 
 #ifndef __ARRAYS_HPP__
 #define __ARRAYS_HPP__
 
-#include <map>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
 
 /**
  * @brief A templated class for handling the memory allocation, indexing and
  * searching of all the different arrays of classes.
  *
- * A separate map container is created for every class that the GLOVE supports.
- * This map is used later for the creation of the various new objects,
- * their indexing and searching. The key value of the map is used as the GL
- * handle, therefore the 0 value is not permitted. The mapped value is the
- * generated object.
+ * A separate handle table is created for every class that the GLOVE supports.
+ * This table is used later for the creation of the various new objects,
+ * their indexing and searching. The GL handle is the index of the object in
+ * the table, therefore the 0 value is not permitted. Handles of deallocated
+ * objects are kept in a free list and reused by later allocations, so the
+ * table stays dense. A reverse index from each object to its handle makes
+ * lookups in both directions constant time.
+ *
+ * Objects may also be created with arbitrary handles that were never
+ * returned by Allocate(). Those that lie far beyond the end of the table are
+ * kept in a hash map instead, so that the table does not grow to their size.
+ *
+ * The containers of objects that are shared between contexts are accessed
+ * from more than one thread, so each table is guarded by a mutex of its own.
+ * Callers that iterate over the objects returned by GetObjectList() must hold
+ * the lock returned by GetMutex().
  */
 template <class ELEMENT>
 class ObjectArray {
 private:
-    uint32_t mCounter;                 /**< The id (key-value of the map)
-                                          reserved during the creation of a new
-                                          object. */
-    std::map<uint32_t, ELEMENT *> mObjects; /**< The templated map container (one
-                                          for each different class that maps
-                                          id to a specific object). */
+    uint32_t mCounter;                 /**< The highest handle of the table
+                                          that has been reserved or used so
+                                          far. */
+    std::vector<ELEMENT *> mObjects;   /**< The handle table (one for each
+                                          different class that maps id to a
+                                          specific object). Empty slots are
+                                          nullptr. */
+    std::vector<bool> mReserved;       /**< Marks the handles that are returned
+                                          by Allocate() or hold an object. */
+    std::vector<uint32_t> mFreeHandles; /**< The handles of the deallocated
+                                          objects, available for reuse. */
+    std::unordered_map<uint32_t, ELEMENT *> mSparseObjects; /**< The objects
+                                          with handles beyond the reach of the
+                                          table. */
+    std::unordered_map<const ELEMENT *, uint32_t> mHandles; /**< The reverse
+                                          index from an object to its handle. */
+    mutable std::mutex mMutex;         /**< Guards the handle table. */
+
+    static const uint32_t mMaxTableGap = 1024; /**< How far beyond the end of
+                                          the table a handle may lie and still
+                                          be stored in it. */
+
+    /**
+    * @brief Decides whether the given handle is stored in the handle table
+    * rather than in the hash map.
+    * @param index: The GL handle.
+    */
+    bool IsTableHandle(uint32_t index) const
+    {
+        if(index < mObjects.size()) {
+            return mSparseObjects.find(index) == mSparseObjects.end();
+        }
+
+        // index + 1 must not overflow when the table grows to hold the handle
+        return index - mObjects.size() < mMaxTableGap && index != UINT32_MAX;
+    }
+
+    /**
+    * @brief Grows the handle table so that it can hold the given handle.
+    * @param index: The GL handle to be stored, see IsTableHandle().
+    */
+    void Reserve(uint32_t index)
+    {
+        if(index >= mObjects.size()) {
+            mObjects.resize(index + 1, nullptr);
+            mReserved.resize(index + 1, false);
+        }
+        if(mCounter < index) {
+            mCounter = index;
+        }
+    }
+
+    /**
+    * @brief Empties the slot of the given handle and makes it available for
+    * reuse (element is NOT destroyed).
+    * @param index: The GL handle of the element.
+    */
+    void Release(uint32_t index)
+    {
+        typename std::unordered_map<uint32_t, ELEMENT *>::iterator it = mSparseObjects.find(index);
+        if(it != mSparseObjects.end()) {
+            mHandles.erase(it->second);
+            mSparseObjects.erase(it);
+            return;
+        }
+
+        mHandles.erase(mObjects[index]);
+        mObjects[index]  = nullptr;
+        mReserved[index] = false;
+        mFreeHandles.push_back(index);
+    }
+
+    /**
+    * @brief Returns the element with the given handle, nullptr if there is
+    * none.
+    * @param index: The GL handle of the element.
+    */
+    ELEMENT *Find(uint32_t index) const
+    {
+        if(index < mObjects.size() && mObjects[index] != nullptr) {
+            return mObjects[index];
+        }
+
+        typename std::unordered_map<uint32_t, ELEMENT *>::const_iterator it = mSparseObjects.find(index);
+        return it == mSparseObjects.end() ? nullptr : it->second;
+    }
+
 public:
 
     /**
@@ -58,38 +153,68 @@ public:
     }
 
     /**
-    * @brief The destructor removes all elements from the map container (which
-    * are destroyed), leaving the container with a size of 0.
+    * @brief The destructor destroys all elements of the handle table, leaving
+    * the container with a size of 0.
     */
     ~ObjectArray()
     {
-        typename std::map<uint32_t, ELEMENT *>::iterator it;
-        for(it = mObjects.begin(); it != mObjects.end(); it++) {
-            delete it->second;
+        for(auto object : mObjects) {
+            delete object;
+        }
+        for(auto &object : mSparseObjects) {
+            delete object.second;
         }
         mObjects.clear();
+        mReserved.clear();
+        mFreeHandles.clear();
+        mSparseObjects.clear();
+        mHandles.clear();
     }
 
     /**
-    * @brief Returns the GL handle and reserves this as the new key value.
+    * @brief Returns the GL handle and reserves it for a new object.
     * @return The GL handle.
+    *
+    * The handles of deallocated objects are reused first. A handle in the
+    * free list may have been taken meanwhile by an object created through
+    * GetObject(), in which case it is skipped, as are the handles of the hash
+    * map that the table has grown to reach.
     */
     uint32_t Allocate()
     {
-        return ++mCounter;
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        while(!mFreeHandles.empty()) {
+            uint32_t index = mFreeHandles.back();
+            mFreeHandles.pop_back();
+            if(!mReserved[index]) {
+                mReserved[index] = true;
+                return index;
+            }
+        }
+
+        uint32_t index = mCounter + 1;
+        while(mSparseObjects.find(index) != mSparseObjects.end()) {
+            ++index;
+        }
+        Reserve(index);
+        mReserved[index] = true;
+        return index;
     }
 
     /**
-    * @brief Removes from the map container a single element with the given
+    * @brief Removes from the handle table a single element with the given
     * key value (element is  destroyed).
     * @param index: The GL handle of the element to be destroyed.
     */
     bool Deallocate(uint32_t index)
     {
-        typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
-        if(it != mObjects.end()) {
-            delete it->second;
-            mObjects.erase(it);
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        ELEMENT *object = Find(index);
+        if(object != nullptr) {
+            Release(index);
+            delete object;
 
             return true;
         }
@@ -98,14 +223,15 @@ public:
     }
 
     /**
-    * @brief Removes from the map container a single element with the given
+    * @brief Removes from the handle table a single element with the given
     * key value (element is NOT destroyed).
     */
     bool RemoveFromList(uint32_t index)
     {
-        typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
-        if(it != mObjects.end()) {
-            mObjects.erase(it);
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if(Find(index) != nullptr) {
+            Release(index);
             return true;
         }
         return false;
@@ -115,23 +241,32 @@ public:
      * @brief Searches the container for an element with a key equivalent to
      * index and returns it.
      * @param index: The GL handle of the element to be found or to be created.
-     * @return A pointer to the element in the map.
+     * @return A pointer to the element in the table.
      *
      * In case the key value is not found (thus, the element does not exist)
      * a new object is created. Consequently this method is the only way to
-     * insert a new element in the map.
+     * insert a new element in the table.
      */
     ELEMENT *GetObject(uint32_t index)
     {
-        if(mCounter < index) {
-            mCounter = index;
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if(!IsTableHandle(index)) {
+            ELEMENT *&object = mSparseObjects[index];
+            if(object == nullptr) {
+                object = new ELEMENT();
+                mHandles[object] = index;
+            }
+            return object;
         }
-        typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
-        if(it != mObjects.end()) {
-            return it->second;
-        } else {
-            return mObjects[index] = new ELEMENT();
+
+        Reserve(index);
+        if(mObjects[index] == nullptr) {
+            mObjects[index]  = new ELEMENT();
+            mReserved[index] = true;
+            mHandles[mObjects[index]] = index;
         }
+        return mObjects[index];
     }
 
     /**
@@ -142,8 +277,8 @@ public:
      */
     bool ObjectExists(uint32_t index) const
     {
-        typename std::map<uint32_t, ELEMENT *>::const_iterator it = mObjects.find(index);
-        return it == mObjects.end() ? false : true;
+        std::lock_guard<std::mutex> lock(mMutex);
+        return Find(index) != nullptr;
     }
 
     /**
@@ -151,29 +286,45 @@ public:
      * @param *element: The element to be searched in the container.
      * @return The GL handle of the element.
      *
-     * The container is traversed using the mapped value as the search value.
-     * The GL handle is returned in case the wanted element exists, else the
-     * returned value is 0.
+     * The handle is found through the reverse index. The GL handle is
+     * returned in case the wanted element exists, else the returned value
+     * is ~0.
      */
     uint32_t GetObjectId(const ELEMENT * element) const
     {
-        typename std::map<uint32_t, ELEMENT *>::const_iterator it;
-        for(it = mObjects.begin(); it != mObjects.end(); it++) {
-            if(it->second == element) {
-                return it->first;
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        typename std::unordered_map<const ELEMENT *, uint32_t>::const_iterator it = mHandles.find(element);
+        return it == mHandles.end() ? ~0 : it->second;
+    }
+
+    /**
+     * @brief Returns all the elements of the container, whether they are
+     * stored in the handle table or in the hash map.
+     * @return The elements, in no particular order.
+     */
+    std::vector<ELEMENT *> GetObjectList(void) const
+    {
+        std::vector<ELEMENT *> objects;
+        objects.reserve(mHandles.size());
+        for(auto object : mObjects) {
+            if(object != nullptr) {
+                objects.push_back(object);
             }
         }
-
-        return ~0;
+        for(auto &object : mSparseObjects) {
+            objects.push_back(object.second);
+        }
+        return objects;
     }
 
     /**
-     * @brief Returns the map container for a specific class.
-     * @return The map container.
+     * @brief Returns the mutex that guards the handle table.
+     * @return The mutex to be held while iterating over GetObjectList().
      */
-    std::map<uint32_t, ELEMENT *> *GetObjects(void)
+    std::mutex &GetMutex(void) const
     {
-        return &mObjects;
+        return mMutex;
     }
 };
 
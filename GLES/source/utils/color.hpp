@@ -36,7 +36,8 @@ CLAMP(const T x, const T minVal, const T maxVal) {
 
 #define CLAMPF_01(x)                                    CLAMP(x, 0.0f, 1.0f)
 
-// TODO:: check and reimplement/optimize conversions for packed image formats if needed
+// Bulk conversions to RGBA8 during texture uploads go through the vectorized
+// row converters in pixelConverters.h, which match these per-pixel functions
 struct Color {
     unsigned char r, g, b, a;
 
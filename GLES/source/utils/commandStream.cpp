@@ -0,0 +1,272 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       commandStream.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Deferred GL command stream. GL calls are queued by the application thread and
+ *              translated to Vulkan by a backend thread that owns the context.
+ *
+ *  Commands are consumed in batches, so the lock is taken once per batch and not
+ *  once per command. Calls that return data wait until the stream has drained.
+ */
+
+#include "commandStream.h"
+
+CommandStream::CommandStream()
+: mBusy(false), mTerminate(false), mActiveVertexArray(0), mArrayBuffer(0)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    mVertexArrays[0] = vertexArrayState_t();
+
+    mThread = std::thread(&CommandStream::Run, this);
+}
+
+CommandStream::~CommandStream()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // the commands still queued are executed before the thread exits
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTerminate = true;
+    }
+    mCommandsAvailable.notify_one();
+
+    mThread.join();
+}
+
+void
+CommandStream::Run(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::deque<command_t> commands;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while(true) {
+        mCommandsAvailable.wait(lock, [this]() { return !mCommands.empty() || mTerminate; });
+        if(mCommands.empty()) {
+            break;
+        }
+
+        commands.swap(mCommands);
+        mBusy = true;
+        lock.unlock();
+
+        for(auto &command : commands) {
+            command();
+        }
+        commands.clear();
+
+        lock.lock();
+        mBusy = false;
+        if(mCommands.empty()) {
+            mCommandsDrained.notify_all();
+        }
+    }
+}
+
+CommandStream::data_t
+CommandStream::CopyData(const void *data, GLsizeiptr size)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(data == nullptr || size <= 0) {
+        return nullptr;
+    }
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    return std::make_shared<std::vector<uint8_t>>(bytes, bytes + size);
+}
+
+void
+CommandStream::Enqueue(command_t command)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // a busy thread picks up the new command once it is done with its batch
+        wake = !mBusy && mCommands.empty();
+        mCommands.push_back(std::move(command));
+    }
+
+    if(wake) {
+        mCommandsAvailable.notify_one();
+    }
+}
+
+void
+CommandStream::Execute(const command_t &command)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Enqueue(command);
+    Finish();
+}
+
+void
+CommandStream::Finish(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCommandsDrained.wait(lock, [this]() { return mCommands.empty() && !mBusy; });
+}
+
+void
+CommandStream::BindBuffer(GLenum target, GLuint buffer)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(target == GL_ARRAY_BUFFER) {
+        mArrayBuffer = buffer;
+    } else if(target == GL_ELEMENT_ARRAY_BUFFER) {
+        mVertexArrays[mActiveVertexArray].elementArrayBuffer = buffer;
+    }
+}
+
+void
+CommandStream::DeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    vertexArrayState_t &vao = mVertexArrays[mActiveVertexArray];
+    for(GLsizei i = 0; i < n; ++i) {
+        if(buffers[i] == 0) {
+            continue;
+        }
+
+        if(mArrayBuffer == buffers[i]) {
+            mArrayBuffer = 0;
+        }
+        if(vao.elementArrayBuffer == buffers[i]) {
+            vao.elementArrayBuffer = 0;
+        }
+
+        // arrays sourced from a deleted buffer are conservatively treated as client-side
+        for(uint32_t index = 0; index < GLOVE_MAX_VERTEX_ATTRIBS; ++index) {
+            if(vao.arrayBuffers[index] == buffers[i]) {
+                vao.arrayBuffers[index] = 0;
+                vao.clientArrays |= 1u << index;
+            }
+        }
+    }
+}
+
+void
+CommandStream::EnableVertexAttribArray(GLuint index)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(index < GLOVE_MAX_VERTEX_ATTRIBS) {
+        mVertexArrays[mActiveVertexArray].enabledArrays |= 1u << index;
+    }
+}
+
+void
+CommandStream::DisableVertexAttribArray(GLuint index)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(index < GLOVE_MAX_VERTEX_ATTRIBS) {
+        mVertexArrays[mActiveVertexArray].enabledArrays &= ~(1u << index);
+    }
+}
+
+void
+CommandStream::VertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *ptr)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    (void)size; (void)type; (void)normalized; (void)stride; (void)ptr;
+
+    if(indx >= GLOVE_MAX_VERTEX_ATTRIBS) {
+        return;
+    }
+
+    vertexArrayState_t &vao = mVertexArrays[mActiveVertexArray];
+    vao.arrayBuffers[indx] = mArrayBuffer;
+    if(mArrayBuffer == 0) {
+        vao.clientArrays |= 1u << indx;
+    } else {
+        vao.clientArrays &= ~(1u << indx);
+    }
+}
+
+void
+CommandStream::BindVertexArrayOES(GLuint array)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // binding a name that was not generated fails and leaves the binding as it is
+    if(array != 0 && mVertexArrays.find(array) == mVertexArrays.end()) {
+        return;
+    }
+
+    mActiveVertexArray = array;
+}
+
+void
+CommandStream::GenVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(n < 0 || arrays == nullptr) {
+        return;
+    }
+
+    for(GLsizei i = 0; i < n; ++i) {
+        mVertexArrays[arrays[i]] = vertexArrayState_t();
+    }
+}
+
+void
+CommandStream::DeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(GLsizei i = 0; i < n; ++i) {
+        if(arrays[i] == 0) {
+            continue;
+        }
+
+        mVertexArrays.erase(arrays[i]);
+        if(mActiveVertexArray == arrays[i]) {
+            mActiveVertexArray = 0;
+        }
+    }
+}
+
+bool
+CommandStream::ReadsClientArrays(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    const vertexArrayState_t &vao = mVertexArrays[mActiveVertexArray];
+    return (vao.enabledArrays & vao.clientArrays) != 0;
+}
+
+bool
+CommandStream::ReadsClientIndices(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return mVertexArrays[mActiveVertexArray].elementArrayBuffer == 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       commandStream.h
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Deferred GL command stream. GL calls are queued by the application thread and
+ *              translated to Vulkan by a backend thread that owns the context.
+ *
+ */
+
+#ifndef __COMMANDSTREAM_H__
+#define __COMMANDSTREAM_H__
+
+#include "utils/globals.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class CommandStream {
+public:
+    typedef std::function<void(void)>               command_t;
+    typedef std::shared_ptr<std::vector<uint8_t>>   data_t;
+
+private:
+    std::thread                                     mThread;
+    std::mutex                                      mMutex;
+    std::condition_variable                         mCommandsAvailable;
+    std::condition_variable                         mCommandsDrained;
+    std::deque<command_t>                           mCommands;
+    bool                                            mBusy;
+    bool                                            mTerminate;
+
+    /// Vertex array state shadowed on the application thread. Client-side arrays
+    /// are read when a draw is translated, so such draws cannot be deferred
+    typedef struct vertexArrayState_t {
+        uint32_t                                    enabledArrays;
+        uint32_t                                    clientArrays;
+        GLuint                                      arrayBuffers[GLOVE_MAX_VERTEX_ATTRIBS];
+        GLuint                                      elementArrayBuffer;
+    } vertexArrayState_t;
+
+    std::map<GLuint, vertexArrayState_t>            mVertexArrays;
+    GLuint                                          mActiveVertexArray;
+    GLuint                                          mArrayBuffer;
+
+    void                                            Run(void);
+
+public:
+    CommandStream();
+    ~CommandStream();
+
+    static data_t                                   CopyData(const void *data, GLsizeiptr size);
+
+    void                                            Enqueue(command_t command);
+    void                                            Execute(const command_t &command);
+    void                                            Finish(void);
+
+// Client state tracking
+    void                                            BindBuffer(GLenum target, GLuint buffer);
+    void                                            DeleteBuffers(GLsizei n, const GLuint *buffers);
+    void                                            EnableVertexAttribArray(GLuint index);
+    void                                            DisableVertexAttribArray(GLuint index);
+    void                                            VertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *ptr);
+    void                                            BindVertexArrayOES(GLuint array);
+    void                                            GenVertexArraysOES(GLsizei n, const GLuint *arrays);
+    void                                            DeleteVertexArraysOES(GLsizei n, const GLuint *arrays);
+
+    bool                                            ReadsClientArrays(void);
+    bool                                            ReadsClientIndices(void);
+};
+
+#endif // __COMMANDSTREAM_H__
@@ -0,0 +1,410 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       etcDecoder.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      ETC1/ETC2/EAC block decoder
+ *
+ *  @scope
+ *
+ *  Compressed textures are uploaded as is when the Vulkan device samples
+ *  ETC2/EAC natively. Otherwise they are expanded here to RGBA8 before
+ *  the upload. The decoder follows the block layouts of the OpenGL ES 3.0
+ *  specification (Annex C) and does not depend on Vulkan, so it can be
+ *  tested on the host.
+ *
+ */
+
+#include "etcDecoder.h"
+#include <cstring>
+
+#define ETC_BLOCK_PIXELS                                16
+
+static const GLenum etcCompressedFormats[] = {
+    GL_ETC1_RGB8_OES,
+    GL_COMPRESSED_RGB8_ETC2,
+    GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,
+    GL_COMPRESSED_RGBA8_ETC2_EAC,
+    GL_COMPRESSED_R11_EAC,
+    GL_COMPRESSED_RG11_EAC
+};
+
+static const int etcModifierTable[8][2] = {
+    {  2,   8 }, {  5,  17 }, {  9,  29 }, { 13,  42 },
+    { 18,  60 }, { 24,  80 }, { 33, 106 }, { 47, 183 }
+};
+
+static const int etcDistanceTable[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+static const int eacModifierTable[16][8] = {
+    { -3, -6,  -9, -15, 2, 5, 8, 14 },
+    { -3, -7, -10, -13, 2, 6, 9, 12 },
+    { -2, -5,  -8, -13, 1, 4, 7, 12 },
+    { -2, -4,  -6, -13, 1, 3, 5, 12 },
+    { -3, -6,  -8, -12, 2, 5, 7, 11 },
+    { -3, -7,  -9, -11, 2, 6, 8, 10 },
+    { -4, -7,  -8, -11, 3, 6, 7, 10 },
+    { -3, -5,  -8, -11, 2, 4, 7, 10 },
+    { -2, -6,  -8, -10, 1, 5, 7,  9 },
+    { -2, -5,  -8, -10, 1, 4, 7,  9 },
+    { -2, -4,  -8, -10, 1, 3, 7,  9 },
+    { -2, -5,  -7, -10, 1, 4, 6,  9 },
+    { -3, -4,  -7, -10, 2, 3, 6,  9 },
+    { -1, -2,  -3, -10, 0, 1, 2,  9 },
+    { -4, -6,  -8,  -9, 3, 5, 7,  8 },
+    { -3, -5,  -7,  -9, 2, 4, 6,  8 }
+};
+
+static inline int
+Clamp(int value, int maxValue)
+{
+    return value < 0 ? 0 : (value > maxValue ? maxValue : value);
+}
+
+static inline uint32_t
+ReadBE32(const uint8_t *src)
+{
+    return (static_cast<uint32_t>(src[0]) << 24) | (static_cast<uint32_t>(src[1]) << 16) |
+           (static_cast<uint32_t>(src[2]) <<  8) |  static_cast<uint32_t>(src[3]);
+}
+
+static inline uint64_t
+ReadBE64(const uint8_t *src)
+{
+    return (static_cast<uint64_t>(ReadBE32(src)) << 32) | ReadBE32(src + 4);
+}
+
+static inline int Extend4(uint32_t c) { return static_cast<int>((c << 4) | c);        }
+static inline int Extend5(uint32_t c) { return static_cast<int>((c << 3) | (c >> 2)); }
+static inline int Extend6(uint32_t c) { return static_cast<int>((c << 2) | (c >> 4)); }
+static inline int Extend7(uint32_t c) { return static_cast<int>((c << 1) | (c >> 6)); }
+
+/// Sign extends the 3-bit differential color component
+static inline int
+Delta3(uint32_t d)
+{
+    return (d & 0x4) ? static_cast<int>(d) - 8 : static_cast<int>(d);
+}
+
+static inline void
+SetPixel(uint8_t *block, int x, int y, int r, int g, int b, int a)
+{
+    uint8_t *p = &block[4 * (y * ETC_BLOCK_DIM + x)];
+    p[0] = static_cast<uint8_t>(Clamp(r, 255));
+    p[1] = static_cast<uint8_t>(Clamp(g, 255));
+    p[2] = static_cast<uint8_t>(Clamp(b, 255));
+    p[3] = static_cast<uint8_t>(Clamp(a, 255));
+}
+
+/// Pixel indices are stored column-major, MSBs in bits 31..16 and LSBs in bits 15..0
+static inline uint32_t
+PixelIndex(uint32_t lo, int x, int y)
+{
+    const int i = x * ETC_BLOCK_DIM + y;
+    return (((lo >> (i + 16)) & 0x1) << 1) | ((lo >> i) & 0x1);
+}
+
+static void
+DecodeEtcIndividualDifferential(uint32_t hi, uint32_t lo, bool differential, bool punchthrough, bool opaque, uint8_t *block)
+{
+    int base[2][3];
+    if(differential) {
+        const uint32_t r = (hi >> 27) & 0x1F, g = (hi >> 19) & 0x1F, b = (hi >> 11) & 0x1F;
+        base[0][0] = Extend5(r);
+        base[0][1] = Extend5(g);
+        base[0][2] = Extend5(b);
+        base[1][0] = Extend5(static_cast<uint32_t>(static_cast<int>(r) + Delta3((hi >> 24) & 0x7)));
+        base[1][1] = Extend5(static_cast<uint32_t>(static_cast<int>(g) + Delta3((hi >> 16) & 0x7)));
+        base[1][2] = Extend5(static_cast<uint32_t>(static_cast<int>(b) + Delta3((hi >>  8) & 0x7)));
+    } else {
+        base[0][0] = Extend4((hi >> 28) & 0xF);
+        base[1][0] = Extend4((hi >> 24) & 0xF);
+        base[0][1] = Extend4((hi >> 20) & 0xF);
+        base[1][1] = Extend4((hi >> 16) & 0xF);
+        base[0][2] = Extend4((hi >> 12) & 0xF);
+        base[1][2] = Extend4((hi >>  8) & 0xF);
+    }
+
+    const uint32_t table[2] = { (hi >> 5) & 0x7, (hi >> 2) & 0x7 };
+    const bool     flip     = hi & 0x1;
+
+    for(int x = 0; x < ETC_BLOCK_DIM; ++x) {
+        for(int y = 0; y < ETC_BLOCK_DIM; ++y) {
+            const int      sub   = flip ? (y >= 2) : (x >= 2);
+            const uint32_t index = PixelIndex(lo, x, y);
+
+            if(punchthrough && !opaque && index == 2) {
+                SetPixel(block, x, y, 0, 0, 0, 0);
+                continue;
+            }
+
+            // 00: +small, 01: +large, 10: -small, 11: -large
+            int modifier = etcModifierTable[table[sub]][index & 0x1];
+            if(punchthrough && !opaque && !(index & 0x1)) {
+                modifier = 0;
+            }
+            if(index & 0x2) {
+                modifier = -modifier;
+            }
+
+            SetPixel(block, x, y, base[sub][0] + modifier, base[sub][1] + modifier, base[sub][2] + modifier, 255);
+        }
+    }
+}
+
+static void
+DecodeEtcTH(uint32_t hi, uint32_t lo, bool hMode, bool punchthrough, bool opaque, uint8_t *block)
+{
+    int paint[4][3];
+
+    if(hMode) {
+        const uint32_t r1 =  (hi >> 27) & 0xF;
+        const uint32_t g1 = (((hi >> 24) & 0x7) << 1) | ((hi >> 20) & 0x1);
+        const uint32_t b1 = (((hi >> 19) & 0x1) << 3) | ((hi >> 15) & 0x7);
+        const uint32_t r2 =  (hi >> 11) & 0xF;
+        const uint32_t g2 =  (hi >>  7) & 0xF;
+        const uint32_t b2 =  (hi >>  3) & 0xF;
+
+        const uint32_t c1 = (r1 << 8) | (g1 << 4) | b1;
+        const uint32_t c2 = (r2 << 8) | (g2 << 4) | b2;
+        const int      d  = etcDistanceTable[(((hi >> 2) & 0x1) << 2) | ((hi & 0x1) << 1) | (c1 >= c2 ? 1 : 0)];
+
+        const int base[2][3] = { { Extend4(r1), Extend4(g1), Extend4(b1) },
+                                 { Extend4(r2), Extend4(g2), Extend4(b2) } };
+        for(int c = 0; c < 3; ++c) {
+            paint[0][c] = base[0][c] + d;
+            paint[1][c] = base[0][c] - d;
+            paint[2][c] = base[1][c] + d;
+            paint[3][c] = base[1][c] - d;
+        }
+    } else {
+        const uint32_t r1 = (((hi >> 27) & 0x3) << 2) | ((hi >> 24) & 0x3);
+        const int      d  = etcDistanceTable[(((hi >> 2) & 0x3) << 1) | (hi & 0x1)];
+
+        const int base[2][3] = { { Extend4(r1),              Extend4((hi >> 20) & 0xF), Extend4((hi >> 16) & 0xF) },
+                                 { Extend4((hi >> 12) & 0xF), Extend4((hi >>  8) & 0xF), Extend4((hi >>  4) & 0xF) } };
+        for(int c = 0; c < 3; ++c) {
+            paint[0][c] = base[0][c];
+            paint[1][c] = base[1][c] + d;
+            paint[2][c] = base[1][c];
+            paint[3][c] = base[1][c] - d;
+        }
+    }
+
+    for(int x = 0; x < ETC_BLOCK_DIM; ++x) {
+        for(int y = 0; y < ETC_BLOCK_DIM; ++y) {
+            const uint32_t index = PixelIndex(lo, x, y);
+
+            if(punchthrough && !opaque && index == 2) {
+                SetPixel(block, x, y, 0, 0, 0, 0);
+            } else {
+                SetPixel(block, x, y, paint[index][0], paint[index][1], paint[index][2], 255);
+            }
+        }
+    }
+}
+
+static void
+DecodeEtcPlanar(uint64_t bits, uint8_t *block)
+{
+    const int ro = Extend6(static_cast<uint32_t>((bits >> 57) & 0x3F));
+    const int go = Extend7(static_cast<uint32_t>((((bits >> 56) & 0x1) << 6) | ((bits >> 49) & 0x3F)));
+    const int bo = Extend6(static_cast<uint32_t>((((bits >> 48) & 0x1) << 5) | (((bits >> 43) & 0x3) << 3) | ((bits >> 39) & 0x7)));
+    const int rh = Extend6(static_cast<uint32_t>((((bits >> 34) & 0x1F) << 1) | ((bits >> 32) & 0x1)));
+    const int gh = Extend7(static_cast<uint32_t>((bits >> 25) & 0x7F));
+    const int bh = Extend6(static_cast<uint32_t>((bits >> 19) & 0x3F));
+    const int rv = Extend6(static_cast<uint32_t>((bits >> 13) & 0x3F));
+    const int gv = Extend7(static_cast<uint32_t>((bits >>  6) & 0x7F));
+    const int bv = Extend6(static_cast<uint32_t>( bits        & 0x3F));
+
+    for(int y = 0; y < ETC_BLOCK_DIM; ++y) {
+        for(int x = 0; x < ETC_BLOCK_DIM; ++x) {
+            SetPixel(block, x, y,
+                     (x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2,
+                     (x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2,
+                     (x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2,
+                     255);
+        }
+    }
+}
+
+static void
+DecodeEtc2ColorBlock(const uint8_t *src, bool etc1, bool punchthrough, uint8_t *block)
+{
+    const uint64_t bits = ReadBE64(src);
+    const uint32_t hi   = static_cast<uint32_t>(bits >> 32);
+    const uint32_t lo   = static_cast<uint32_t>(bits);
+
+    // the punchthrough formats reuse the differential bit as the opaque bit
+    const bool differential = punchthrough || ((hi >> 1) & 0x1);
+    const bool opaque       = (hi >> 1) & 0x1;
+
+    if(etc1 || !differential) {
+        DecodeEtcIndividualDifferential(hi, lo, differential, punchthrough, opaque, block);
+        return;
+    }
+
+    // ETC2 signals its additional modes through overflowing differential colors
+    const int r = static_cast<int>((hi >> 27) & 0x1F) + Delta3((hi >> 24) & 0x7);
+    const int g = static_cast<int>((hi >> 19) & 0x1F) + Delta3((hi >> 16) & 0x7);
+    const int b = static_cast<int>((hi >> 11) & 0x1F) + Delta3((hi >>  8) & 0x7);
+
+    if(r < 0 || r > 31) {
+        DecodeEtcTH(hi, lo, false, punchthrough, opaque, block);
+    } else if(g < 0 || g > 31) {
+        DecodeEtcTH(hi, lo, true, punchthrough, opaque, block);
+    } else if(b < 0 || b > 31) {
+        DecodeEtcPlanar(bits, block);
+    } else {
+        DecodeEtcIndividualDifferential(hi, lo, true, punchthrough, opaque, block);
+    }
+}
+
+/// Decodes an 8-bit EAC alpha block, or an 11-bit R/RG channel reduced to 8 bits, into the given channel
+static void
+DecodeEacBlock(const uint8_t *src, bool elevenBit, int channel, uint8_t *block)
+{
+    const uint64_t bits       = ReadBE64(src);
+    const int      base       = static_cast<int>((bits >> 56) & 0xFF);
+    const int      multiplier = static_cast<int>((bits >> 52) & 0xF);
+    const int     *modifiers  = eacModifierTable[(bits >> 48) & 0xF];
+
+    for(int x = 0; x < ETC_BLOCK_DIM; ++x) {
+        for(int y = 0; y < ETC_BLOCK_DIM; ++y) {
+            const int i        = x * ETC_BLOCK_DIM + y;
+            const int modifier = modifiers[(bits >> (45 - 3 * i)) & 0x7];
+
+            int value;
+            if(elevenBit) {
+                value = Clamp(base * 8 + 4 + modifier * (multiplier ? multiplier * 8 : 1), 2047);
+                value = (value * 255 + 1023) / 2047;
+            } else {
+                value = Clamp(base + modifier * multiplier, 255);
+            }
+            block[4 * (y * ETC_BLOCK_DIM + x) + channel] = static_cast<uint8_t>(value);
+        }
+    }
+}
+
+static void
+DecodeBlock(GLenum internalformat, const uint8_t *src, uint8_t *block)
+{
+    switch(internalformat) {
+    case GL_ETC1_RGB8_OES:                              DecodeEtc2ColorBlock(src, true,  false, block); break;
+    case GL_COMPRESSED_RGB8_ETC2:                       DecodeEtc2ColorBlock(src, false, false, block); break;
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:   DecodeEtc2ColorBlock(src, false, true,  block); break;
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:                  DecodeEtc2ColorBlock(src + 8, false, false, block);
+                                                        DecodeEacBlock(src, false, 3, block); break;
+    case GL_COMPRESSED_R11_EAC:
+    case GL_COMPRESSED_RG11_EAC:
+        for(int i = 0; i < ETC_BLOCK_PIXELS; ++i) {
+            block[4 * i + 1] = 0;
+            block[4 * i + 2] = 0;
+            block[4 * i + 3] = 255;
+        }
+        DecodeEacBlock(src, true, 0, block);
+        if(internalformat == GL_COMPRESSED_RG11_EAC) {
+            DecodeEacBlock(src + 8, true, 1, block);
+        }
+        break;
+    default: break;
+    }
+}
+
+const GLenum *
+GetEtcCompressedFormats(GLint *count)
+{
+    *count = static_cast<GLint>(sizeof(etcCompressedFormats) / sizeof(etcCompressedFormats[0]));
+
+    return etcCompressedFormats;
+}
+
+bool
+IsEtcCompressedFormat(GLenum internalformat)
+{
+    return GetEtcBlockSize(internalformat) != 0;
+}
+
+size_t
+GetEtcBlockSize(GLenum internalformat)
+{
+    switch(internalformat) {
+    case GL_ETC1_RGB8_OES:
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_R11_EAC:                         return 8;
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+    case GL_COMPRESSED_RG11_EAC:                        return 16;
+    default:                                            return 0;
+    }
+}
+
+size_t
+GetEtcCompressedImageSize(GLenum internalformat, GLsizei width, GLsizei height)
+{
+    const size_t blocksX = (static_cast<size_t>(width)  + ETC_BLOCK_DIM - 1) / ETC_BLOCK_DIM;
+    const size_t blocksY = (static_cast<size_t>(height) + ETC_BLOCK_DIM - 1) / ETC_BLOCK_DIM;
+
+    return blocksX * blocksY * GetEtcBlockSize(internalformat);
+}
+
+GLenum
+ValidateEtcSubImage(GLsizei levelWidth, GLsizei levelHeight, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height)
+{
+    // written as subtractions so that large offsets cannot overflow
+    if(xoffset < 0 || yoffset < 0 || width < 0 || height < 0 ||
+       width > levelWidth || height > levelHeight ||
+       xoffset > levelWidth - width || yoffset > levelHeight - height) {
+        return GL_INVALID_VALUE;
+    }
+
+    // updates must cover whole blocks, except for the blocks at the right and bottom edges
+    if((xoffset % ETC_BLOCK_DIM) || (yoffset % ETC_BLOCK_DIM) ||
+       ((width  % ETC_BLOCK_DIM) && (xoffset + width ) != levelWidth ) ||
+       ((height % ETC_BLOCK_DIM) && (yoffset + height) != levelHeight)) {
+        return GL_INVALID_OPERATION;
+    }
+
+    return GL_NO_ERROR;
+}
+
+bool
+DecodeEtcImage(GLenum internalformat, GLsizei width, GLsizei height, const void *src, uint8_t *dst)
+{
+    const size_t blockSize = GetEtcBlockSize(internalformat);
+    if(!blockSize || width < 0 || height < 0 || src == nullptr || dst == nullptr) {
+        return false;
+    }
+
+    const uint8_t *srcBlock = static_cast<const uint8_t *>(src);
+    uint8_t        block[4 * ETC_BLOCK_PIXELS];
+
+    for(GLsizei by = 0; by < height; by += ETC_BLOCK_DIM) {
+        for(GLsizei bx = 0; bx < width; bx += ETC_BLOCK_DIM) {
+            DecodeBlock(internalformat, srcBlock, block);
+            srcBlock += blockSize;
+
+            const GLsizei rows    = (height - by) < ETC_BLOCK_DIM ? (height - by) : ETC_BLOCK_DIM;
+            const GLsizei columns = (width  - bx) < ETC_BLOCK_DIM ? (width  - bx) : ETC_BLOCK_DIM;
+            for(GLsizei y = 0; y < rows; ++y) {
+                memcpy(&dst[4 * ((by + y) * width + bx)], &block[4 * y * ETC_BLOCK_DIM], 4 * columns);
+            }
+        }
+    }
+
+    return true;
+}
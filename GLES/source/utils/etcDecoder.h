@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       etcDecoder.h
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      ETC1/ETC2/EAC block decoder
+ *
+ */
+
+#ifndef __ETCDECODER_H__
+#define __ETCDECODER_H__
+
+#include "GLES2/gl2.h"
+#include "GLES2/gl2ext.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// ETC2/EAC tokens are core in OpenGL ES 3.0 only
+#ifndef GL_COMPRESSED_R11_EAC
+#define GL_COMPRESSED_R11_EAC                           0x9270
+#endif
+#ifndef GL_COMPRESSED_RG11_EAC
+#define GL_COMPRESSED_RG11_EAC                          0x9272
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2                         0x9274
+#endif
+#ifndef GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2     0x9276
+#endif
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC                    0x9278
+#endif
+
+#define ETC_BLOCK_DIM                                   4
+
+/// Returns the compressed formats accepted by glCompressedTexImage2D
+const GLenum *          GetEtcCompressedFormats(GLint *count);
+bool                    IsEtcCompressedFormat(GLenum internalformat);
+/// Returns the size in bytes of a 4x4 block, 0 for unknown formats
+size_t                  GetEtcBlockSize(GLenum internalformat);
+size_t                  GetEtcCompressedImageSize(GLenum internalformat, GLsizei width, GLsizei height);
+/// Validates a glCompressedTexSubImage2D region against the dimensions of the updated
+/// level. Returns GL_INVALID_VALUE if the region does not fit in the level and
+/// GL_INVALID_OPERATION if it does not cover whole blocks, GL_NO_ERROR otherwise
+GLenum                  ValidateEtcSubImage(GLsizei levelWidth, GLsizei levelHeight, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height);
+
+/// Decodes a whole image to tightly packed RGBA8. Pixels of the last
+/// block row/column that lie outside width x height are discarded.
+bool                    DecodeEtcImage(GLenum internalformat, GLsizei width, GLsizei height, const void *src, uint8_t *dst);
+
+#endif // __ETCDECODER_H__
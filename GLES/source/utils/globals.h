@@ -88,6 +88,9 @@
 #define GLOVE_DUMP_PROCESSED_SHADER_SOURCE              false
 #define GLOVE_DUMP_SPIRV_SHADER_SOURCE                  false
 
+#define GLOVE_ENABLE_DRAW_COALESCING                    false
+#define GLOVE_ENABLE_DEFERRED_COMMAND_STREAM            false
+
 #define GLOVE_INVALID_OFFSET                            UINT32_MAX
 
 #define GLOVE_VULKAN_DEPTH_RANGE                        vulkan_DepthRange
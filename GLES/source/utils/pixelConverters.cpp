@@ -0,0 +1,570 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pixelConverters.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Vectorized row converters for common pixel format pairs
+ *
+ *  @scope
+ *
+ *  Texture uploads of formats that Vulkan cannot sample natively (RGB8,
+ *  packed 16-bit formats, luminance/alpha) are expanded to RGBA8 on the
+ *  CPU. The converters below process a whole row per call, using SSE2,
+ *  SSSE3, AVX2 or NEON when available. The instruction set is selected
+ *  once at runtime, and the scalar path (built on Color) handles both
+ *  unsupported CPUs and the row tails.
+ *
+ */
+
+#include "pixelConverters.h"
+#include "color.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define GLOVE_ROW_CONVERTERS_X86
+#   include <immintrin.h>
+#   define TARGET_SSE2                                  __attribute__((target("sse2")))
+#   define TARGET_SSSE3                                 __attribute__((target("ssse3")))
+#   define TARGET_AVX2                                  __attribute__((target("avx2")))
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define GLOVE_ROW_CONVERTERS_NEON
+#   include <arm_neon.h>
+#endif
+
+/// Scalar converters
+
+template<Color (*SrcColorFunPtr)(const uint8_t*), uint32_t srcPixelSize>
+static void
+ConvertRowScalar(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    for(uint32_t i = 0; i < pixels; ++i) {
+        Color color = SrcColorFunPtr(src);
+        Color::ConvertToRGBA(color, dst);
+        src += srcPixelSize;
+        dst += 4;
+    }
+}
+
+static const RowConverterFunPtr scalarRowConverters[ROW_CONVERTER_MAX] = {
+    ConvertRowScalar<&Color::FromRGB,            3>,
+    ConvertRowScalar<&Color::FromBGRA,           4>,
+    ConvertRowScalar<&Color::From565,            2>,
+    ConvertRowScalar<&Color::From4444,           2>,
+    ConvertRowScalar<&Color::From5551,           2>,
+    ConvertRowScalar<&Color::FromLuminance,      1>,
+    ConvertRowScalar<&Color::FromLuminanceAlpha, 2>,
+    ConvertRowScalar<&Color::FromAlpha,          1>
+};
+
+static const uint32_t srcPixelSizes[ROW_CONVERTER_MAX] = { 3, 4, 2, 2, 2, 1, 2, 1 };
+
+static inline void
+ConvertRowTail(rowConverter_e type, const uint8_t *src, uint8_t *dst, uint32_t pixels, uint32_t done)
+{
+    if(done < pixels) {
+        scalarRowConverters[type](src + done * srcPixelSizes[type], dst + done * 4, pixels - done);
+    }
+}
+
+#ifdef GLOVE_ROW_CONVERTERS_X86
+
+/// SSE2 converters
+///
+/// The packed 16-bit formats are unpacked into two 16-bit lanes per pixel,
+/// one holding R|G<<8 and one holding B|A<<8, which are then interleaved.
+
+TARGET_SSE2 static inline __m128i
+Expand5To8_SSE2(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 3), _mm_srli_epi16(x, 2));
+}
+
+TARGET_SSE2 static inline void
+Unpack565_SSE2(__m128i v, __m128i *rg, __m128i *ba)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+
+    __m128i r = Expand5To8_SSE2(_mm_srli_epi16(v, 11));
+    __m128i g = _mm_and_si128(_mm_srli_epi16(v, 5), mask6);
+    __m128i b = Expand5To8_SSE2(_mm_and_si128(v, mask5));
+    g = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+
+    *rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    *ba = _mm_or_si128(b, _mm_set1_epi16(static_cast<short>(0xFF00)));
+}
+
+TARGET_SSE2 static inline void
+Unpack4444_SSE2(__m128i v, __m128i *rg, __m128i *ba)
+{
+    const __m128i mask   = _mm_set1_epi16(0x0F);
+    const __m128i scale  = _mm_set1_epi16(0x11);
+
+    __m128i rgNibbles = _mm_or_si128(_mm_srli_epi16(v, 12), _mm_and_si128(v, _mm_set1_epi16(0x0F00)));
+    __m128i baNibbles = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 4), mask), _mm_slli_epi16(_mm_and_si128(v, mask), 8));
+
+    *rg = _mm_mullo_epi16(rgNibbles, scale);
+    *ba = _mm_mullo_epi16(baNibbles, scale);
+}
+
+TARGET_SSE2 static inline void
+Unpack5551_SSE2(__m128i v, __m128i *rg, __m128i *ba)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+
+    __m128i r = Expand5To8_SSE2(_mm_srli_epi16(v, 11));
+    __m128i g = Expand5To8_SSE2(_mm_and_si128(_mm_srli_epi16(v, 6), mask5));
+    __m128i b = Expand5To8_SSE2(_mm_and_si128(_mm_srli_epi16(v, 1), mask5));
+    __m128i a = _mm_sub_epi16(_mm_setzero_si128(), _mm_and_si128(v, _mm_set1_epi16(0x1)));
+
+    *rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    *ba = _mm_or_si128(b, _mm_and_si128(a, _mm_set1_epi16(static_cast<short>(0xFF00))));
+}
+
+template<void (*Unpack)(__m128i, __m128i*, __m128i*), rowConverter_e type>
+TARGET_SSE2 static void
+ConvertRowPacked16_SSE2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        __m128i rg, ba;
+        Unpack(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2)), &rg, &ba);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),      _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 16), _mm_unpackhi_epi16(rg, ba));
+    }
+    ConvertRowTail(type, src, dst, pixels, i);
+}
+
+TARGET_SSE2 static void
+ConvertRowBGRAToRGBA_SSE2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    const __m128i maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+    const __m128i maskR  = _mm_set1_epi32(0x000000FF);
+    const __m128i maskB  = _mm_set1_epi32(0x00FF0000);
+
+    uint32_t i = 0;
+    for(; i + 4 <= pixels; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        __m128i o = _mm_or_si128(_mm_and_si128(v, maskGA),
+                    _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 16), maskR),
+                                 _mm_and_si128(_mm_slli_epi32(v, 16), maskB)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), o);
+    }
+    ConvertRowTail(ROW_CONVERTER_BGRA_TO_RGBA, src, dst, pixels, i);
+}
+
+TARGET_SSE2 static void
+ConvertRowLuminanceToRGBA_SSE2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        __m128i l   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i llo = _mm_unpacklo_epi8(l, l);
+        __m128i lhi = _mm_unpackhi_epi8(l, l);
+        __m128i alo = _mm_unpacklo_epi8(l, alpha);
+        __m128i ahi = _mm_unpackhi_epi8(l, alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),      _mm_unpacklo_epi16(llo, alo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 16), _mm_unpackhi_epi16(llo, alo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 32), _mm_unpacklo_epi16(lhi, ahi));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 48), _mm_unpackhi_epi16(lhi, ahi));
+    }
+    ConvertRowTail(ROW_CONVERTER_LUMINANCE_TO_RGBA, src, dst, pixels, i);
+}
+
+TARGET_SSE2 static void
+ConvertRowLuminanceAlphaToRGBA_SSE2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    const __m128i maskL = _mm_set1_epi16(0x00FF);
+
+    uint32_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        __m128i la = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2));
+        __m128i l  = _mm_and_si128(la, maskL);
+        __m128i ll = _mm_or_si128(l, _mm_slli_epi16(l, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),      _mm_unpacklo_epi16(ll, la));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 16), _mm_unpackhi_epi16(ll, la));
+    }
+    ConvertRowTail(ROW_CONVERTER_LUMINANCE_ALPHA_TO_RGBA, src, dst, pixels, i);
+}
+
+TARGET_SSE2 static void
+ConvertRowAlphaToRGBA_SSE2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        __m128i a   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i alo = _mm_unpacklo_epi8(zero, a);
+        __m128i ahi = _mm_unpackhi_epi8(zero, a);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),      _mm_unpacklo_epi16(zero, alo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 16), _mm_unpackhi_epi16(zero, alo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 32), _mm_unpacklo_epi16(zero, ahi));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4 + 48), _mm_unpackhi_epi16(zero, ahi));
+    }
+    ConvertRowTail(ROW_CONVERTER_ALPHA_TO_RGBA, src, dst, pixels, i);
+}
+
+/// SSSE3 converters
+
+TARGET_SSSE3 static void
+ConvertRowRGBToRGBA_SSSE3(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha   = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    // 16 pixels (48 bytes) per iteration, so that no load reads past the row
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        const __m128i *in  = reinterpret_cast<const __m128i *>(src + i * 3);
+              __m128i *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        __m128i v0 = _mm_loadu_si128(in);
+        __m128i v1 = _mm_loadu_si128(in + 1);
+        __m128i v2 = _mm_loadu_si128(in + 2);
+
+        _mm_storeu_si128(out,     _mm_or_si128(_mm_shuffle_epi8(v0,                          shuffle), alpha));
+        _mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(v1, v0, 12), shuffle), alpha));
+        _mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(v2, v1,  8), shuffle), alpha));
+        _mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(v2, 4),       shuffle), alpha));
+    }
+    ConvertRowTail(ROW_CONVERTER_RGB_TO_RGBA, src, dst, pixels, i);
+}
+
+/// AVX2 converters
+///
+/// _mm256_unpack* interleaves within 128-bit lanes, so the two results
+/// are recombined with _mm256_permute2x128_si256 to restore pixel order.
+
+TARGET_AVX2 static inline __m256i
+Expand5To8_AVX2(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi16(x, 3), _mm256_srli_epi16(x, 2));
+}
+
+TARGET_AVX2 static inline void
+Unpack565_AVX2(__m256i v, __m256i *rg, __m256i *ba)
+{
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    const __m256i mask6 = _mm256_set1_epi16(0x3F);
+
+    __m256i r = Expand5To8_AVX2(_mm256_srli_epi16(v, 11));
+    __m256i g = _mm256_and_si256(_mm256_srli_epi16(v, 5), mask6);
+    __m256i b = Expand5To8_AVX2(_mm256_and_si256(v, mask5));
+    g = _mm256_or_si256(_mm256_slli_epi16(g, 2), _mm256_srli_epi16(g, 4));
+
+    *rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+    *ba = _mm256_or_si256(b, _mm256_set1_epi16(static_cast<short>(0xFF00)));
+}
+
+TARGET_AVX2 static inline void
+Unpack4444_AVX2(__m256i v, __m256i *rg, __m256i *ba)
+{
+    const __m256i mask  = _mm256_set1_epi16(0x0F);
+    const __m256i scale = _mm256_set1_epi16(0x11);
+
+    __m256i rgNibbles = _mm256_or_si256(_mm256_srli_epi16(v, 12), _mm256_and_si256(v, _mm256_set1_epi16(0x0F00)));
+    __m256i baNibbles = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 4), mask), _mm256_slli_epi16(_mm256_and_si256(v, mask), 8));
+
+    *rg = _mm256_mullo_epi16(rgNibbles, scale);
+    *ba = _mm256_mullo_epi16(baNibbles, scale);
+}
+
+TARGET_AVX2 static inline void
+Unpack5551_AVX2(__m256i v, __m256i *rg, __m256i *ba)
+{
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+
+    __m256i r = Expand5To8_AVX2(_mm256_srli_epi16(v, 11));
+    __m256i g = Expand5To8_AVX2(_mm256_and_si256(_mm256_srli_epi16(v, 6), mask5));
+    __m256i b = Expand5To8_AVX2(_mm256_and_si256(_mm256_srli_epi16(v, 1), mask5));
+    __m256i a = _mm256_sub_epi16(_mm256_setzero_si256(), _mm256_and_si256(v, _mm256_set1_epi16(0x1)));
+
+    *rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+    *ba = _mm256_or_si256(b, _mm256_and_si256(a, _mm256_set1_epi16(static_cast<short>(0xFF00))));
+}
+
+template<void (*Unpack)(__m256i, __m256i*, __m256i*), rowConverter_e type>
+TARGET_AVX2 static void
+ConvertRowPacked16_AVX2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        __m256i rg, ba;
+        Unpack(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 2)), &rg, &ba);
+        __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+        __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4),      _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    ConvertRowTail(type, src, dst, pixels, i);
+}
+
+TARGET_AVX2 static void
+ConvertRowBGRAToRGBA_AVX2(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                             2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    uint32_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), _mm256_shuffle_epi8(v, shuffle));
+    }
+    ConvertRowTail(ROW_CONVERTER_BGRA_TO_RGBA, src, dst, pixels, i);
+}
+
+#endif // GLOVE_ROW_CONVERTERS_X86
+
+#ifdef GLOVE_ROW_CONVERTERS_NEON
+
+/// NEON converters
+///
+/// The interleaving loads/stores (vld2/vld3/vld4, vst4) do most of the work.
+
+static void
+ConvertRowRGBToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_RGB_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRowBGRAToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t bgra = vld4q_u8(src + i * 4);
+        uint8x16_t   tmp  = bgra.val[0];
+        bgra.val[0] = bgra.val[2];
+        bgra.val[2] = tmp;
+        vst4q_u8(dst + i * 4, bgra);
+    }
+    ConvertRowTail(ROW_CONVERTER_BGRA_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRow565ToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        uint16x8_t  v = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i * 2));
+        uint8x8_t   r = vand_u8(vshrn_n_u16(v, 8), vdup_n_u8(0xF8));
+        uint8x8_t   g = vand_u8(vshrn_n_u16(v, 3), vdup_n_u8(0xFC));
+        uint8x8_t   b = vmovn_u16(vshlq_n_u16(v, 3));
+        uint8x8x4_t rgba;
+        rgba.val[0] = vorr_u8(r, vshr_n_u8(r, 5));
+        rgba.val[1] = vorr_u8(g, vshr_n_u8(g, 6));
+        rgba.val[2] = vorr_u8(b, vshr_n_u8(b, 5));
+        rgba.val[3] = vdup_n_u8(0xFF);
+        vst4_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_565_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRow4444ToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        uint16x8_t  v  = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i * 2));
+        uint8x8_t   hi = vshrn_n_u16(v, 8);
+        uint8x8_t   lo = vmovn_u16(v);
+        uint8x8_t   r  = vshr_n_u8(hi, 4);
+        uint8x8_t   g  = vand_u8(hi, vdup_n_u8(0x0F));
+        uint8x8_t   b  = vshr_n_u8(lo, 4);
+        uint8x8_t   a  = vand_u8(lo, vdup_n_u8(0x0F));
+        uint8x8x4_t rgba;
+        rgba.val[0] = vorr_u8(r, vshl_n_u8(r, 4));
+        rgba.val[1] = vorr_u8(g, vshl_n_u8(g, 4));
+        rgba.val[2] = vorr_u8(b, vshl_n_u8(b, 4));
+        rgba.val[3] = vorr_u8(a, vshl_n_u8(a, 4));
+        vst4_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_4444_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRow5551ToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 8 <= pixels; i += 8) {
+        uint16x8_t  v = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i * 2));
+        uint8x8_t   r = vand_u8(vshrn_n_u16(v, 8), vdup_n_u8(0xF8));
+        uint8x8_t   g = vand_u8(vshrn_n_u16(v, 3), vdup_n_u8(0xF8));
+        uint8x8_t   b = vand_u8(vmovn_u16(vshlq_n_u16(v, 2)), vdup_n_u8(0xF8));
+        uint8x8x4_t rgba;
+        rgba.val[0] = vorr_u8(r, vshr_n_u8(r, 5));
+        rgba.val[1] = vorr_u8(g, vshr_n_u8(g, 5));
+        rgba.val[2] = vorr_u8(b, vshr_n_u8(b, 5));
+        rgba.val[3] = vmovn_u16(vtstq_u16(v, vdupq_n_u16(0x1)));
+        vst4_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_5551_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRowLuminanceToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16_t   l = vld1q_u8(src + i);
+        uint8x16x4_t rgba;
+        rgba.val[0] = l;
+        rgba.val[1] = l;
+        rgba.val[2] = l;
+        rgba.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_LUMINANCE_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRowLuminanceAlphaToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16x2_t la = vld2q_u8(src + i * 2);
+        uint8x16x4_t rgba;
+        rgba.val[0] = la.val[0];
+        rgba.val[1] = la.val[0];
+        rgba.val[2] = la.val[0];
+        rgba.val[3] = la.val[1];
+        vst4q_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_LUMINANCE_ALPHA_TO_RGBA, src, dst, pixels, i);
+}
+
+static void
+ConvertRowAlphaToRGBA_NEON(const uint8_t *src, uint8_t *dst, uint32_t pixels)
+{
+    uint32_t i = 0;
+    for(; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t rgba;
+        rgba.val[0] = vdupq_n_u8(0x0);
+        rgba.val[1] = vdupq_n_u8(0x0);
+        rgba.val[2] = vdupq_n_u8(0x0);
+        rgba.val[3] = vld1q_u8(src + i);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+    ConvertRowTail(ROW_CONVERTER_ALPHA_TO_RGBA, src, dst, pixels, i);
+}
+
+#endif // GLOVE_ROW_CONVERTERS_NEON
+
+/// Runtime selection
+
+typedef struct rowConverterTable_t {
+    RowConverterFunPtr      converters[ROW_CONVERTER_MAX];
+    rowConverterIsa_e       isa[ROW_CONVERTER_MAX];
+
+    rowConverterTable_t()
+    {
+        for(uint32_t i = 0; i < ROW_CONVERTER_MAX; ++i) {
+            converters[i] = scalarRowConverters[i];
+            isa[i]        = ROW_CONVERTER_ISA_SCALAR;
+        }
+
+#ifdef GLOVE_ROW_CONVERTERS_X86
+        __builtin_cpu_init();
+
+        if(__builtin_cpu_supports("sse2")) {
+            Set(ROW_CONVERTER_BGRA_TO_RGBA,            ConvertRowBGRAToRGBA_SSE2,                                                    ROW_CONVERTER_ISA_SSE2);
+            Set(ROW_CONVERTER_565_TO_RGBA,             ConvertRowPacked16_SSE2<Unpack565_SSE2,  ROW_CONVERTER_565_TO_RGBA>,          ROW_CONVERTER_ISA_SSE2);
+            Set(ROW_CONVERTER_4444_TO_RGBA,            ConvertRowPacked16_SSE2<Unpack4444_SSE2, ROW_CONVERTER_4444_TO_RGBA>,         ROW_CONVERTER_ISA_SSE2);
+            Set(ROW_CONVERTER_5551_TO_RGBA,            ConvertRowPacked16_SSE2<Unpack5551_SSE2, ROW_CONVERTER_5551_TO_RGBA>,         ROW_CONVERTER_ISA_SSE2);
+            Set(ROW_CONVERTER_LUMINANCE_TO_RGBA,       ConvertRowLuminanceToRGBA_SSE2,                                               ROW_CONVERTER_ISA_SSE2);
+            Set(ROW_CONVERTER_LUMINANCE_ALPHA_TO_RGBA, ConvertRowLuminanceAlphaToRGBA_SSE2,                                          ROW_CONVERTER_ISA_SSE2);
+            Set(ROW_CONVERTER_ALPHA_TO_RGBA,           ConvertRowAlphaToRGBA_SSE2,                                                   ROW_CONVERTER_ISA_SSE2);
+        }
+
+        if(__builtin_cpu_supports("ssse3")) {
+            Set(ROW_CONVERTER_RGB_TO_RGBA,             ConvertRowRGBToRGBA_SSSE3,                                                    ROW_CONVERTER_ISA_SSSE3);
+        }
+
+        if(__builtin_cpu_supports("avx2")) {
+            Set(ROW_CONVERTER_BGRA_TO_RGBA,            ConvertRowBGRAToRGBA_AVX2,                                                    ROW_CONVERTER_ISA_AVX2);
+            Set(ROW_CONVERTER_565_TO_RGBA,             ConvertRowPacked16_AVX2<Unpack565_AVX2,  ROW_CONVERTER_565_TO_RGBA>,          ROW_CONVERTER_ISA_AVX2);
+            Set(ROW_CONVERTER_4444_TO_RGBA,            ConvertRowPacked16_AVX2<Unpack4444_AVX2, ROW_CONVERTER_4444_TO_RGBA>,         ROW_CONVERTER_ISA_AVX2);
+            Set(ROW_CONVERTER_5551_TO_RGBA,            ConvertRowPacked16_AVX2<Unpack5551_AVX2, ROW_CONVERTER_5551_TO_RGBA>,         ROW_CONVERTER_ISA_AVX2);
+        }
+#endif // GLOVE_ROW_CONVERTERS_X86
+
+#ifdef GLOVE_ROW_CONVERTERS_NEON
+        Set(ROW_CONVERTER_RGB_TO_RGBA,             ConvertRowRGBToRGBA_NEON,             ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_BGRA_TO_RGBA,            ConvertRowBGRAToRGBA_NEON,            ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_565_TO_RGBA,             ConvertRow565ToRGBA_NEON,             ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_4444_TO_RGBA,            ConvertRow4444ToRGBA_NEON,            ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_5551_TO_RGBA,            ConvertRow5551ToRGBA_NEON,            ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_LUMINANCE_TO_RGBA,       ConvertRowLuminanceToRGBA_NEON,       ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_LUMINANCE_ALPHA_TO_RGBA, ConvertRowLuminanceAlphaToRGBA_NEON,  ROW_CONVERTER_ISA_NEON);
+        Set(ROW_CONVERTER_ALPHA_TO_RGBA,           ConvertRowAlphaToRGBA_NEON,           ROW_CONVERTER_ISA_NEON);
+#endif // GLOVE_ROW_CONVERTERS_NEON
+    }
+
+    void Set(rowConverter_e type, RowConverterFunPtr converter, rowConverterIsa_e converterIsa)
+    {
+        converters[type] = converter;
+        isa[type]        = converterIsa;
+    }
+} rowConverterTable_t;
+
+static const rowConverterTable_t &
+GetRowConverterTable(void)
+{
+    static const rowConverterTable_t table;
+    return table;
+}
+
+RowConverterFunPtr
+GetRowConverter(rowConverter_e type)
+{
+    return GetRowConverterTable().converters[type];
+}
+
+RowConverterFunPtr
+GetScalarRowConverter(rowConverter_e type)
+{
+    return scalarRowConverters[type];
+}
+
+rowConverterIsa_e
+GetRowConverterIsa(rowConverter_e type)
+{
+    return GetRowConverterTable().isa[type];
+}
+
+const char *
+GetRowConverterIsaName(rowConverterIsa_e isa)
+{
+    switch(isa) {
+    case ROW_CONVERTER_ISA_SSE2:    return "SSE2";
+    case ROW_CONVERTER_ISA_SSSE3:   return "SSSE3";
+    case ROW_CONVERTER_ISA_AVX2:    return "AVX2";
+    case ROW_CONVERTER_ISA_NEON:    return "NEON";
+    default:                        return "scalar";
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pixelConverters.h
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Vectorized row converters for common pixel format pairs
+ *
+ */
+
+#ifndef __PIXELCONVERTERS_H__
+#define __PIXELCONVERTERS_H__
+
+#include <stdint.h>
+
+typedef enum {
+    ROW_CONVERTER_RGB_TO_RGBA = 0,
+    ROW_CONVERTER_BGRA_TO_RGBA,
+    ROW_CONVERTER_565_TO_RGBA,
+    ROW_CONVERTER_4444_TO_RGBA,
+    ROW_CONVERTER_5551_TO_RGBA,
+    ROW_CONVERTER_LUMINANCE_TO_RGBA,
+    ROW_CONVERTER_LUMINANCE_ALPHA_TO_RGBA,
+    ROW_CONVERTER_ALPHA_TO_RGBA,
+    ROW_CONVERTER_MAX
+} rowConverter_e;
+
+typedef enum {
+    ROW_CONVERTER_ISA_SCALAR = 0,
+    ROW_CONVERTER_ISA_SSE2,
+    ROW_CONVERTER_ISA_SSSE3,
+    ROW_CONVERTER_ISA_AVX2,
+    ROW_CONVERTER_ISA_NEON
+} rowConverterIsa_e;
+
+/// Converts 'pixels' tightly packed pixels from 'src' to 'dst'.
+/// Output is bit-exact with the matching Color::FromXXX/ConvertToRGBA pair.
+typedef void (*RowConverterFunPtr)(const uint8_t *src, uint8_t *dst, uint32_t pixels);
+
+/// Returns the fastest converter supported by the running CPU
+RowConverterFunPtr      GetRowConverter(rowConverter_e type);
+/// Returns the portable C++ converter, used as a fallback and as a reference
+RowConverterFunPtr      GetScalarRowConverter(rowConverter_e type);
+/// Returns the instruction set selected at runtime for the given converter
+rowConverterIsa_e       GetRowConverterIsa(rowConverter_e type);
+const char *            GetRowConverterIsaName(rowConverterIsa_e isa);
+
+#endif // __PIXELCONVERTERS_H__
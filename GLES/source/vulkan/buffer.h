@@ -60,6 +60,7 @@ public:
     inline VkDescriptorBufferInfo*    GetVkDescriptorBufferInfo(void)           { FUN_ENTRY(GL_LOG_TRACE); return &mVkDescriptorBufferInfo; }
     inline VkDeviceSize               GetSize(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return mVkSize;                  }
     inline VkBufferUsageFlags         GetFlags(void)                    const   { FUN_ENTRY(GL_LOG_TRACE); return mVkBufferUsageFlags;      }
+    inline VkSharingMode              GetSharingMode(void)              const   { FUN_ENTRY(GL_LOG_TRACE); return mVkBufferSharingMode;     }
 
 // Set Functions
     inline void                       SetSize(VkDeviceSize size)                { FUN_ENTRY(GL_LOG_TRACE); mVkSize             = size;      }
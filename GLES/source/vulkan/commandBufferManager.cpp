@@ -32,12 +32,16 @@
  */
 
 #include "commandBufferManager.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace vulkanAPI {
 
 #define GLOVE_NO_BUFFER_TO_WAIT                         0x7FFFFFFF
 #define GLOVE_NUM_COMMAND_BUFFERS                       2
 #define GLOVE_FENCE_WAIT_TIMEOUT                        UINT64_MAX
+#define GLOVE_DEVICE_SERIAL_WAIT_SLICE                  static_cast<uint64_t>(1000000)
 
 CommandBufferManager::CommandBufferManager(const vkContext_t *context)
 : mVkContext(context)
@@ -46,10 +50,11 @@ CommandBufferManager::CommandBufferManager(const vkContext_t *context)
 
     mActiveCmdBuffer    = 0;
     mLastSubmittedBuffer= GLOVE_NO_BUFFER_TO_WAIT;
+    mSubmitSerial       = 0;
+    mCompletedSerial    = 0;
 
     mVkCmdPool          = VK_NULL_HANDLE;
     mVkAuxCommandBuffer = VK_NULL_HANDLE;
-    mVkAuxFence         = VK_NULL_HANDLE;
 
     if(!AllocateVkCmdPool()) {
         assert(false);
@@ -88,13 +93,19 @@ CommandBufferManager::DestroyVkCmdBuffers(void)
     FUN_ENTRY(GL_LOG_TRACE);
 
     for(uint32_t i = 0; i < mVkCommandBuffers.fence.size(); ++i) {
+        CompleteDeviceSerial(mVkCommandBuffers.deviceSerial[i]);
         mVkCommandBuffers.fence[i].Release();
     }
+    mVkAuxFence.Release();
 
     vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, mVkCommandBuffers.commandBuffer.size(), mVkCommandBuffers.commandBuffer.data());
     mVkCommandBuffers.commandBuffer.clear();
     mVkCommandBuffers.commandBufferState.clear();
     mVkCommandBuffers.fence.clear();
+    mVkCommandBuffers.submitSerial.clear();
+    mVkCommandBuffers.deviceSerial.clear();
+    // command buffers are only destroyed when idle, every submission has completed
+    mCompletedSerial = mSubmitSerial;
     memset(static_cast<void *>(&mVkCommandBuffers), 0, mVkCommandBuffers.commandBuffer.size()*sizeof(State));
 
     if(mVkAuxCommandBuffer != VK_NULL_HANDLE) {
@@ -188,6 +199,8 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
     mVkCommandBuffers.commandBuffer.resize(GLOVE_NUM_COMMAND_BUFFERS);
     mVkCommandBuffers.commandBufferState.resize(GLOVE_NUM_COMMAND_BUFFERS);
     mVkCommandBuffers.fence.resize(GLOVE_NUM_COMMAND_BUFFERS);
+    mVkCommandBuffers.submitSerial.resize(GLOVE_NUM_COMMAND_BUFFERS);
+    mVkCommandBuffers.deviceSerial.resize(GLOVE_NUM_COMMAND_BUFFERS);
 
     VkCommandBufferAllocateInfo cmdAllocInfo;
     cmdAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -213,6 +226,8 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
 
     for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
         mVkCommandBuffers.commandBufferState[i] = CMD_BUFFER_INITIAL_STATE;
+        mVkCommandBuffers.submitSerial[i]       = 0;
+        mVkCommandBuffers.deviceSerial[i]       = 0;
 
         mVkCommandBuffers.fence[i].SetContext(mVkContext);
         if(!mVkCommandBuffers.fence[i].Create(false)) {
@@ -220,6 +235,11 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
         }
     }
 
+    mVkAuxFence.SetContext(mVkContext);
+    if(!mVkAuxFence.Create(false)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -246,6 +266,7 @@ CommandBufferManager::BeginVkDrawCommandBuffer(void)
     }
 
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_RECORDING_STATE;
+    mVkCommandBuffers.deviceSerial[mActiveCmdBuffer]       = ReserveDeviceSerial();
 
     return true;
 }
@@ -313,11 +334,15 @@ CommandBufferManager::SubmitVkDrawCommandBuffer(void)
         return true;
     }
 
+    // the queue and the semaphore chain are shared by the contexts of all threads
+    std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+
     vector<VkSemaphore> pSems;
     vector<VkPipelineStageFlags> pFlags;
     if(mVkContext->vkSyncItems->acquireSemaphoreFlag) {
+        // the swapchain image leaves PRESENT_SRC at this stage, see Image::ModifyImageLayout
         pSems.push_back(mVkContext->vkSyncItems->vkAcquireSemaphore);
-        pFlags.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+        pFlags.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
     }
     if(mVkContext->vkSyncItems->drawSemaphoreFlag) {
         pSems.push_back(mVkContext->vkSyncItems->vkDrawSemaphore);
@@ -346,11 +371,19 @@ CommandBufferManager::SubmitVkDrawCommandBuffer(void)
     }
 
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_SUBMITED_STATE;
+    mVkCommandBuffers.submitSerial[mActiveCmdBuffer]       = ++mSubmitSerial;
+    SubmitDeviceSerial(mVkCommandBuffers.deviceSerial[mActiveCmdBuffer], mVkCommandBuffers.fence[mActiveCmdBuffer].GetFence());
 
     mLastSubmittedBuffer = mActiveCmdBuffer;
 
     mActiveCmdBuffer = (mActiveCmdBuffer + 1) % GLOVE_NUM_COMMAND_BUFFERS;
 
+    // the next command buffer may still be in flight if it was submitted
+    // without a subsequent WaitLastSubmition(), e.g., by glFlush()
+    if(!WaitVkDrawCommandBuffer(mActiveCmdBuffer)) {
+        return false;
+    }
+
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_INITIAL_STATE;
 
     return true;
@@ -363,10 +396,7 @@ CommandBufferManager::WaitLastSubmition(void)
 
     if(mLastSubmittedBuffer != GLOVE_NO_BUFFER_TO_WAIT) {
 
-        if(!mVkCommandBuffers.fence[mLastSubmittedBuffer].Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT))
-            return false;
-
-        if(!mVkCommandBuffers.fence[mLastSubmittedBuffer].Reset()) {
+        if(!WaitVkDrawCommandBuffer(mLastSubmittedBuffer)) {
             return false;
         }
 
@@ -379,6 +409,189 @@ CommandBufferManager::WaitLastSubmition(void)
     return false;
 }
 
+bool
+CommandBufferManager::WaitVkDrawCommandBuffer(uint32_t index)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mVkCommandBuffers.commandBufferState[index] != CMD_BUFFER_SUBMITED_STATE) {
+        return true;
+    }
+
+    if(!mVkCommandBuffers.fence[index].Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT)) {
+        return false;
+    }
+
+    // sync objects of other threads may wait on the fence for as long as its serial is pending
+    CompleteDeviceSerial(mVkCommandBuffers.deviceSerial[index]);
+    mVkCommandBuffers.deviceSerial[index] = 0;
+
+    if(!mVkCommandBuffers.fence[index].Reset()) {
+        return false;
+    }
+
+    mVkCommandBuffers.commandBufferState[index] = CMD_BUFFER_INITIAL_STATE;
+    mCompletedSerial = std::max(mCompletedSerial, mVkCommandBuffers.submitSerial[index]);
+
+    return true;
+}
+
+bool
+CommandBufferManager::WaitSubmitSerial(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
+        if(mVkCommandBuffers.submitSerial[i] <= serial && !WaitVkDrawCommandBuffer(i)) {
+            return false;
+        }
+    }
+
+    return IsSubmitSerialCompleted(serial);
+}
+
+bool
+CommandBufferManager::WaitDeviceSerial(uint64_t serial, uint64_t timeout, bool *completed)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// The serial may belong to the context of another thread, so none of the command buffer state is touched.
+    /// The fence of a pending serial is only reset once the serial is no longer pending, which is decided under
+    /// the same lock. The fence is therefore waited on with the lock held, in slices so as not to block the
+    /// other contexts for long
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for(;;) {
+        const uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        const uint64_t remaining = timeout > elapsed ? timeout - elapsed : 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mVkContext->vkDeviceSerialMutex);
+
+            std::map<uint64_t, VkFence>::iterator it = mVkContext->vkPendingDeviceSerials.find(serial);
+            if(it == mVkContext->vkPendingDeviceSerials.end()) {
+                *completed = true;
+                return true;
+            }
+
+            // a serial without a fence is still being recorded
+            if(it->second != VK_NULL_HANDLE) {
+                VkResult err = vkWaitForFences(mVkContext->vkDevice, 1, &it->second, VK_TRUE, std::min(remaining, GLOVE_DEVICE_SERIAL_WAIT_SLICE));
+                assert(err == VK_SUCCESS || err == VK_TIMEOUT);
+
+                if(err == VK_SUCCESS) {
+                    mVkContext->vkPendingDeviceSerials.erase(it);
+                    *completed = true;
+                    return true;
+                }
+
+                if(err != VK_TIMEOUT) {
+                    return false;
+                }
+            }
+        }
+
+        if(!remaining) {
+            *completed = false;
+            return true;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+bool
+CommandBufferManager::IsSubmitSerialCompleted(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(serial <= mCompletedSerial) {
+        return true;
+    }
+
+    // poll the fence of the submission, without resetting it
+    for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
+        if(mVkCommandBuffers.commandBufferState[i] == CMD_BUFFER_SUBMITED_STATE &&
+           mVkCommandBuffers.submitSerial[i] >= serial &&
+           mVkCommandBuffers.fence[i].GetStatus()) {
+            mCompletedSerial = std::max(mCompletedSerial, mVkCommandBuffers.submitSerial[i]);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64_t
+CommandBufferManager::ReserveDeviceSerial(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mVkContext->vkDeviceSerialMutex);
+    uint64_t serial = ++mVkContext->vkDeviceSerial;
+    mVkContext->vkPendingDeviceSerials[serial] = VK_NULL_HANDLE;
+
+    return serial;
+}
+
+void
+CommandBufferManager::SubmitDeviceSerial(uint64_t serial, VkFence fence)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mVkContext->vkDeviceSerialMutex);
+    std::map<uint64_t, VkFence>::iterator it = mVkContext->vkPendingDeviceSerials.find(serial);
+    if(it != mVkContext->vkPendingDeviceSerials.end()) {
+        it->second = fence;
+    }
+}
+
+void
+CommandBufferManager::CompleteDeviceSerial(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mVkContext->vkDeviceSerialMutex);
+    mVkContext->vkPendingDeviceSerials.erase(serial);
+}
+
+uint64_t
+CommandBufferManager::GetPendingDeviceSerial(void) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the command buffer being recorded is submitted after any earlier one of this context
+    if(mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] == CMD_BUFFER_RECORDING_STATE ||
+       mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] == CMD_BUFFER_EXECUTABLE_STATE) {
+        return mVkCommandBuffers.deviceSerial[mActiveCmdBuffer];
+    }
+
+    if(mLastSubmittedBuffer != GLOVE_NO_BUFFER_TO_WAIT &&
+       mVkCommandBuffers.commandBufferState[mLastSubmittedBuffer] == CMD_BUFFER_SUBMITED_STATE) {
+        return mVkCommandBuffers.deviceSerial[mLastSubmittedBuffer];
+    }
+
+    return 0;
+}
+
+bool
+CommandBufferManager::IsDeviceSerialCompleted(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the serial may belong to any context, only the submissions of this one can be polled.
+    // Those of other contexts are completed once their own context waits on them
+    for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
+        if(mVkCommandBuffers.commandBufferState[i] == CMD_BUFFER_SUBMITED_STATE &&
+           mVkCommandBuffers.fence[i].GetStatus()) {
+            CompleteDeviceSerial(mVkCommandBuffers.deviceSerial[i]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mVkContext->vkDeviceSerialMutex);
+    return mVkContext->vkPendingDeviceSerials.find(serial) == mVkContext->vkPendingDeviceSerials.end();
+}
+
 bool
 CommandBufferManager::BeginVkAuxCommandBuffer(void)
 {
@@ -418,7 +631,8 @@ CommandBufferManager::SubmitVkAuxCommandBuffer(void)
     info.commandBufferCount     = 1;
     info.pCommandBuffers        = &mVkAuxCommandBuffer;
 
-    VkResult err = vkQueueSubmit(mVkContext->vkQueue, 1, &info, mVkAuxFence);
+    std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+    VkResult err = vkQueueSubmit(mVkContext->vkQueue, 1, &info, mVkAuxFence.GetFence());
     assert(!err);
 
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_DEVICE_LOST);
@@ -429,10 +643,13 @@ CommandBufferManager::WaitVkAuxCommandBuffer(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkResult err = vkQueueWaitIdle(mVkContext->vkQueue);
-    assert(!err);
+    // only the auxiliary submission is waited for, so the queue stays
+    // available to the other contexts in the meantime
+    if(!mVkAuxFence.Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT)) {
+        return false;
+    }
 
-    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_DEVICE_LOST);
+    return mVkAuxFence.Reset();
 }
 
 }
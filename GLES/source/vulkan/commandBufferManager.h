@@ -45,6 +45,8 @@ private:
         std::vector<VkCommandBuffer>         commandBuffer;
         std::vector<cmdBufferState_t>        commandBufferState;
         std::vector<Fence>                   fence;
+        std::vector<uint64_t>                submitSerial;
+        std::vector<uint64_t>                deviceSerial;
 
         State()  { FUN_ENTRY(GL_LOG_TRACE); }
         ~State() { FUN_ENTRY(GL_LOG_TRACE); }
@@ -55,14 +57,20 @@ private:
 
     uint32_t                        mActiveCmdBuffer;
     int32_t                         mLastSubmittedBuffer;
+    uint64_t                        mSubmitSerial;
+    uint64_t                        mCompletedSerial;
 
     State                           mVkCommandBuffers;
 
     VkCommandBuffer                 mVkAuxCommandBuffer;
-    VkFence                         mVkAuxFence;
+    Fence                           mVkAuxFence;
     CommandBufferPool               mSecondaryCmdBufferPool;
 
     void FreeResources(void);
+    bool WaitVkDrawCommandBuffer(uint32_t index);
+    uint64_t ReserveDeviceSerial(void);
+    void SubmitDeviceSerial(uint64_t serial, VkFence fence);
+    void CompleteDeviceSerial(uint64_t serial);
 
 public:
 // Constructor
@@ -99,10 +107,18 @@ public:
 // Wait Functions
     bool WaitLastSubmition(void);
     bool WaitVkAuxCommandBuffer(void);
+    bool WaitSubmitSerial(uint64_t serial);
+    bool WaitDeviceSerial(uint64_t serial, uint64_t timeout, bool *completed);
+
+// Is Functions
+    bool IsSubmitSerialCompleted(uint64_t serial);
+    bool IsDeviceSerialCompleted(uint64_t serial);
 
 // Get Functions
     inline VkCommandBuffer GetActiveCommandBuffer(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mVkCommandBuffers.commandBuffer[mActiveCmdBuffer]; }
     inline VkCommandBuffer GetAuxCommandBuffer(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkAuxCommandBuffer; }
+    inline uint64_t        GetLastSubmitSerial(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mSubmitSerial; }
+    uint64_t               GetPendingDeviceSerial(void)                   const;
 };
 
 }
@@ -28,11 +28,20 @@
  */
 
 #include "context.h"
+#include "samplerCache.h"
+#include <algorithm>
+#include <cstdlib>
 
 namespace vulkanAPI {
 
 #define GLOVE_VK_VALIDATION_LAYERS                      false
 
+/// Environment variable selecting the physical device. It accepts a device type
+/// (discrete, integrated, virtual, cpu), a hexadecimal vendorID:[deviceID] pair,
+/// a bare hexadecimal vendorID with a 0x prefix, the index of the device in
+/// enumeration order or part of the device name
+#define GLOVE_VK_DEVICE_ENV                             "GLOVE_VK_DEVICE"
+
 #ifdef VK_USE_PLATFORM_XCB_KHR
 static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_XCB_SURFACE_EXTENSION_NAME};
@@ -55,7 +64,12 @@ static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFA
 
 static const std::vector<const char*> requiredDeviceExtensions   = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
-static const std::vector<const char*> usefulDeviceExtensions     = {"VK_KHR_maintenance1"};
+static const char *maintenanceDeviceExtension                    = "VK_KHR_maintenance1";
+static const char *extendedDynamicStateDeviceExtension           = "VK_EXT_extended_dynamic_state";
+static const char *extendedDynamicState2DeviceExtension          = "VK_EXT_extended_dynamic_state2";
+
+// needed to query the features of the extended dynamic state extensions
+static const char *physicalDeviceProperties2InstanceExtension    = "VK_KHR_get_physical_device_properties2";
 
 static       char **enabledInstanceLayers           = nullptr;
 
@@ -64,13 +78,20 @@ vkContext_t GloveVkContext;
 bool InitVkLayers(uint32_t* nLayers);
 bool CheckVkInstanceExtensions(void);
 bool CheckVkDeviceExtensions(void);
+void CheckVkExtendedDynamicStateFeatures(void);
 bool CreateVkInstance(void);
 bool EnumerateVkGpus(void);
+bool IsVkGpuUsable(VkPhysicalDevice gpu);
+bool IsVkGpuSelected(const char *selection, uint32_t index, const VkPhysicalDeviceProperties &properties);
+uint32_t GetVkGpuTypeRank(VkPhysicalDeviceType type);
+VkDeviceSize GetVkGpuLocalMemorySize(VkPhysicalDevice gpu);
+void SelectVkGpu(void);
 bool InitVkQueueFamilyIndex(void);
 bool CreateVkDevice(void);
 bool CreateVkCommandPool(void);
 bool CreateVkSemaphores(void);
 void InitVkQueue(void);
+void InitVkExtendedDynamicState(void);
 
 bool
 InitVkLayers(uint32_t* nLayers)
@@ -148,6 +169,14 @@ CheckVkInstanceExtensions(void)
         }
     }
 
+    GetContext()->mIsPhysicalDeviceProperties2Supported = false;
+    for(uint32_t i = 0; i < extensionCount; ++i) {
+        if(!strcmp(physicalDeviceProperties2InstanceExtension, vkExtensionProperties[i].extensionName)) {
+            GetContext()->mIsPhysicalDeviceProperties2Supported = true;
+            break;
+        }
+    }
+
     if(vkExtensionProperties) {
         free(vkExtensionProperties);
         vkExtensionProperties = nullptr;
@@ -196,15 +225,19 @@ CheckVkDeviceExtensions(void)
         }
     }
 
-    GetContext()->mIsMaintenanceExtSupported = false;
+    GetContext()->mIsMaintenanceExtSupported        = false;
+    GetContext()->mIsExtendedDynamicStateSupported  = false;
+    GetContext()->mIsExtendedDynamicState2Supported = false;
     for(uint32_t i = 0; i < extensionCount; ++i) {
-        for(uint32_t j = 0; j < usefulDeviceExtensions.size(); ++j) {
-            if(!strcmp(usefulDeviceExtensions[j], vkExtensionProperties[i].extensionName)) {
-                GetContext()->mIsMaintenanceExtSupported = true;
-                break;
-            }
+        if(!strcmp(maintenanceDeviceExtension, vkExtensionProperties[i].extensionName)) {
+            GetContext()->mIsMaintenanceExtSupported = true;
+        } else if(!strcmp(extendedDynamicStateDeviceExtension, vkExtensionProperties[i].extensionName)) {
+            GetContext()->mIsExtendedDynamicStateSupported = true;
+        } else if(!strcmp(extendedDynamicState2DeviceExtension, vkExtensionProperties[i].extensionName)) {
+            GetContext()->mIsExtendedDynamicState2Supported = true;
         }
     }
+    CheckVkExtendedDynamicStateFeatures();
 
     if(vkExtensionProperties) {
         free(vkExtensionProperties);
@@ -222,6 +255,53 @@ CheckVkDeviceExtensions(void)
     return true;
 }
 
+void
+CheckVkExtendedDynamicStateFeatures(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// The extensions are only used if the loader headers know them and the device exposes the features
+    bool extendedDynamicState  = false;
+    bool extendedDynamicState2 = false;
+
+#if defined(VK_EXT_extended_dynamic_state) && defined(VK_KHR_get_physical_device_properties2)
+    PFN_vkGetPhysicalDeviceFeatures2KHR getPhysicalDeviceFeatures2 = nullptr;
+    if(GetContext()->mIsPhysicalDeviceProperties2Supported) {
+        getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+                                     vkGetInstanceProcAddr(GloveVkContext.vkInstance, "vkGetPhysicalDeviceFeatures2KHR"));
+    }
+
+    if(getPhysicalDeviceFeatures2) {
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures;
+        memset(static_cast<void *>(&extendedDynamicStateFeatures), 0, sizeof(extendedDynamicStateFeatures));
+        extendedDynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+
+        VkPhysicalDeviceFeatures2KHR features;
+        memset(static_cast<void *>(&features), 0, sizeof(features));
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        features.pNext = &extendedDynamicStateFeatures;
+
+#ifdef VK_EXT_extended_dynamic_state2
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT extendedDynamicState2Features;
+        memset(static_cast<void *>(&extendedDynamicState2Features), 0, sizeof(extendedDynamicState2Features));
+        extendedDynamicState2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+        extendedDynamicStateFeatures.pNext  = &extendedDynamicState2Features;
+#endif
+
+        getPhysicalDeviceFeatures2(GloveVkContext.vkGpus[0], &features);
+
+        extendedDynamicState  = GetContext()->mIsExtendedDynamicStateSupported && extendedDynamicStateFeatures.extendedDynamicState;
+#ifdef VK_EXT_extended_dynamic_state2
+        extendedDynamicState2 = extendedDynamicState && GetContext()->mIsExtendedDynamicState2Supported &&
+                                extendedDynamicState2Features.extendedDynamicState2;
+#endif
+    }
+#endif
+
+    GetContext()->mIsExtendedDynamicStateSupported  = extendedDynamicState;
+    GetContext()->mIsExtendedDynamicState2Supported = extendedDynamicState2;
+}
+
 bool
 CreateVkInstance(void)
 {
@@ -251,8 +331,13 @@ CreateVkInstance(void)
     instanceInfo.pApplicationInfo         = &applicationInfo;
     instanceInfo.enabledLayerCount        = enabledLayerCount;
     instanceInfo.ppEnabledLayerNames      = enabledInstanceLayers;
-    instanceInfo.enabledExtensionCount    = static_cast<uint32_t>(requiredInstanceExtensions.size());
-    instanceInfo.ppEnabledExtensionNames  = requiredInstanceExtensions.data();
+    std::vector<const char*> enabledExtensions(requiredInstanceExtensions);
+    if(GetContext()->mIsPhysicalDeviceProperties2Supported) {
+        enabledExtensions.push_back(physicalDeviceProperties2InstanceExtension);
+    }
+
+    instanceInfo.enabledExtensionCount    = static_cast<uint32_t>(enabledExtensions.size());
+    instanceInfo.ppEnabledExtensionNames  = enabledExtensions.data();
 
     VkResult err = vkCreateInstance(&instanceInfo, nullptr, &GloveVkContext.vkInstance);
     assert(!err);
@@ -285,15 +370,185 @@ EnumerateVkGpus(void)
     err = vkEnumeratePhysicalDevices(GloveVkContext.vkInstance, &gpuCount, GloveVkContext.vkGpus.data());
     assert(!err);
 
-    if(err != VK_SUCCESS) {
+    if(err != VK_SUCCESS || !gpuCount) {
         return false;
     }
 
+    SelectVkGpu();
+
     vkGetPhysicalDeviceMemoryProperties(GloveVkContext.vkGpus[0], &GloveVkContext.vkDeviceMemoryProperties);
 
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(GloveVkContext.vkGpus[0], &properties);
+    GloveVkContext.vkNonCoherentAtomSize = properties.limits.nonCoherentAtomSize;
+
+    return true;
+}
+
+bool
+IsVkGpuUsable(VkPhysicalDevice gpu)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueProperties(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queueFamilyCount, queueProperties.data());
+
+    bool hasGraphicsQueue = false;
+    for(const auto &properties : queueProperties) {
+        hasGraphicsQueue |= (properties.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+    }
+    if(!hasGraphicsQueue) {
+        return false;
+    }
+
+    uint32_t extensionCount = 0;
+    if(vkEnumerateDeviceExtensionProperties(gpu, nullptr, &extensionCount, nullptr) != VK_SUCCESS) {
+        return false;
+    }
+    std::vector<VkExtensionProperties> extensionProperties(extensionCount);
+    if(vkEnumerateDeviceExtensionProperties(gpu, nullptr, &extensionCount, extensionProperties.data()) != VK_SUCCESS) {
+        return false;
+    }
+
+    for(const auto requiredExtension : requiredDeviceExtensions) {
+        bool found = false;
+        for(uint32_t i = 0; i < extensionCount && !found; ++i) {
+            found = !strcmp(requiredExtension, extensionProperties[i].extensionName);
+        }
+        if(!found) {
+            return false;
+        }
+    }
+
     return true;
 }
 
+bool
+IsVkGpuSelected(const char *selection, uint32_t index, const VkPhysicalDeviceProperties &properties)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!selection || !*selection) {
+        return false;
+    }
+
+    if(!strcmp(selection, "discrete")) {
+        return properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+    }
+    if(!strcmp(selection, "integrated")) {
+        return properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
+    }
+    if(!strcmp(selection, "virtual")) {
+        return properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU;
+    }
+    if(!strcmp(selection, "cpu")) {
+        return properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+    }
+
+    // vendorID:[deviceID], e.g. 1002:687f or 10de:, or a bare vendorID with a 0x
+    // prefix, e.g. 0x10de. Without either, a number is taken as a device index
+    char *end = nullptr;
+    const bool hexPrefix = selection[0] == '0' && (selection[1] == 'x' || selection[1] == 'X');
+    const unsigned long vendorID = strtoul(selection, &end, 16);
+    if(end != selection && (*end == ':' || (*end == '\0' && hexPrefix))) {
+        if(vendorID != properties.vendorID) {
+            return false;
+        }
+        const char *deviceSelection = *end ? end + 1 : end;
+        return !*deviceSelection || strtoul(deviceSelection, nullptr, 16) == properties.deviceID;
+    }
+
+    // a plain decimal number is the index of the device in enumeration order
+    const unsigned long selectedIndex = strtoul(selection, &end, 10);
+    if(end != selection && *end == '\0') {
+        return selectedIndex == index;
+    }
+
+    return strstr(properties.deviceName, selection) != nullptr;
+}
+
+uint32_t
+GetVkGpuTypeRank(VkPhysicalDeviceType type)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    switch(type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return 4;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return 3;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       return 2;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:               return 1;
+    default:                                        return 0;
+    }
+}
+
+VkDeviceSize
+GetVkGpuLocalMemorySize(VkPhysicalDevice gpu)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(gpu, &memoryProperties);
+
+    VkDeviceSize size = 0;
+    for(uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+        if(memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            size += memoryProperties.memoryHeaps[i].size;
+        }
+    }
+
+    return size;
+}
+
+void
+SelectVkGpu(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    typedef struct gpuCandidate_t {
+        VkPhysicalDevice                gpu;
+        bool                            usable;
+        bool                            selected;
+        uint32_t                        typeRank;
+        VkDeviceSize                    localMemorySize;
+    } gpuCandidate_t;
+
+    const char *selection = getenv(GLOVE_VK_DEVICE_ENV);
+
+    std::vector<gpuCandidate_t> candidates;
+    for(uint32_t i = 0; i < GloveVkContext.vkGpus.size(); ++i) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(GloveVkContext.vkGpus[i], &properties);
+
+        gpuCandidate_t candidate;
+        candidate.gpu             = GloveVkContext.vkGpus[i];
+        candidate.usable          = IsVkGpuUsable(GloveVkContext.vkGpus[i]);
+        candidate.selected        = IsVkGpuSelected(selection, i, properties);
+        candidate.typeRank        = GetVkGpuTypeRank(properties.deviceType);
+        candidate.localMemorySize = GetVkGpuLocalMemorySize(GloveVkContext.vkGpus[i]);
+        candidates.push_back(candidate);
+    }
+
+    // devices that can render and present come first, then the requested ones, then the
+    // most capable ones. Ties keep the enumeration order of the loader
+    std::stable_sort(candidates.begin(), candidates.end(), [](const gpuCandidate_t &a, const gpuCandidate_t &b) {
+        if(a.usable   != b.usable)   { return a.usable; }
+        if(a.selected != b.selected) { return a.selected; }
+        if(a.typeRank != b.typeRank) { return a.typeRank > b.typeRank; }
+        return a.localMemorySize > b.localMemorySize;
+    });
+
+    if(selection && *selection && !candidates[0].selected) {
+        GLOVE_PRINT_ERR("%s=%s does not match any usable Vulkan device, falling back to the default selection\n", GLOVE_VK_DEVICE_ENV, selection);
+    }
+
+    /// the rest of GLOVE and the EGL platform layer use the first device, so it is the selected one
+    for(uint32_t i = 0; i < candidates.size(); ++i) {
+        GloveVkContext.vkGpus[i] = candidates[i].gpu;
+    }
+}
+
 bool
 InitVkQueueFamilyIndex(void)
 {
@@ -338,12 +593,36 @@ CreateVkDevice(void)
     std::vector<const char*> enabledExtensions(requiredDeviceExtensions);
 
     if(true == GetContext()->mIsMaintenanceExtSupported) {
-        enabledExtensions.insert(enabledExtensions.end(), usefulDeviceExtensions.begin(), usefulDeviceExtensions.end());
+        enabledExtensions.push_back(maintenanceDeviceExtension);
+    }
+
+    const void *deviceInfoNext = nullptr;
+#ifdef VK_EXT_extended_dynamic_state
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures;
+    memset(static_cast<void *>(&extendedDynamicStateFeatures), 0, sizeof(extendedDynamicStateFeatures));
+    extendedDynamicStateFeatures.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+    extendedDynamicStateFeatures.extendedDynamicState = VK_TRUE;
+    if(GetContext()->mIsExtendedDynamicStateSupported) {
+        enabledExtensions.push_back(extendedDynamicStateDeviceExtension);
+        extendedDynamicStateFeatures.pNext = const_cast<void *>(deviceInfoNext);
+        deviceInfoNext = &extendedDynamicStateFeatures;
+    }
+#endif
+#ifdef VK_EXT_extended_dynamic_state2
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT extendedDynamicState2Features;
+    memset(static_cast<void *>(&extendedDynamicState2Features), 0, sizeof(extendedDynamicState2Features));
+    extendedDynamicState2Features.sType                 = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+    extendedDynamicState2Features.extendedDynamicState2 = VK_TRUE;
+    if(GetContext()->mIsExtendedDynamicState2Supported) {
+        enabledExtensions.push_back(extendedDynamicState2DeviceExtension);
+        extendedDynamicState2Features.pNext = const_cast<void *>(deviceInfoNext);
+        deviceInfoNext = &extendedDynamicState2Features;
     }
+#endif
 
     VkDeviceCreateInfo deviceInfo;
     deviceInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    deviceInfo.pNext                   = nullptr;
+    deviceInfo.pNext                   = deviceInfoNext;
     deviceInfo.flags                   = 0;
     deviceInfo.queueCreateInfoCount    = 1;
     deviceInfo.pQueueCreateInfos       = &queueInfo;
@@ -404,6 +683,41 @@ InitVkQueue(void)
                      &GloveVkContext.vkQueue);
 }
 
+void
+InitVkExtendedDynamicState(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+#ifdef VK_EXT_extended_dynamic_state
+    if(GloveVkContext.mIsExtendedDynamicStateSupported) {
+        GloveVkContext.vkCmdSetCullModeEXT          = reinterpret_cast<PFN_vkCmdSetCullModeEXT>         (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetCullModeEXT"));
+        GloveVkContext.vkCmdSetFrontFaceEXT         = reinterpret_cast<PFN_vkCmdSetFrontFaceEXT>        (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetFrontFaceEXT"));
+        GloveVkContext.vkCmdSetDepthTestEnableEXT   = reinterpret_cast<PFN_vkCmdSetDepthTestEnableEXT>  (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetDepthTestEnableEXT"));
+        GloveVkContext.vkCmdSetDepthWriteEnableEXT  = reinterpret_cast<PFN_vkCmdSetDepthWriteEnableEXT> (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetDepthWriteEnableEXT"));
+        GloveVkContext.vkCmdSetDepthCompareOpEXT    = reinterpret_cast<PFN_vkCmdSetDepthCompareOpEXT>   (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetDepthCompareOpEXT"));
+        GloveVkContext.vkCmdSetStencilTestEnableEXT = reinterpret_cast<PFN_vkCmdSetStencilTestEnableEXT>(vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetStencilTestEnableEXT"));
+        GloveVkContext.vkCmdSetStencilOpEXT         = reinterpret_cast<PFN_vkCmdSetStencilOpEXT>        (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetStencilOpEXT"));
+
+        GloveVkContext.mIsExtendedDynamicStateSupported = GloveVkContext.vkCmdSetCullModeEXT          &&
+                                                          GloveVkContext.vkCmdSetFrontFaceEXT         &&
+                                                          GloveVkContext.vkCmdSetDepthTestEnableEXT   &&
+                                                          GloveVkContext.vkCmdSetDepthWriteEnableEXT  &&
+                                                          GloveVkContext.vkCmdSetDepthCompareOpEXT    &&
+                                                          GloveVkContext.vkCmdSetStencilTestEnableEXT &&
+                                                          GloveVkContext.vkCmdSetStencilOpEXT;
+    }
+#endif
+
+#ifdef VK_EXT_extended_dynamic_state2
+    if(GloveVkContext.mIsExtendedDynamicState2Supported) {
+        GloveVkContext.vkCmdSetDepthBiasEnableEXT   = reinterpret_cast<PFN_vkCmdSetDepthBiasEnableEXT>  (vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vkCmdSetDepthBiasEnableEXT"));
+
+        GloveVkContext.mIsExtendedDynamicState2Supported = GloveVkContext.mIsExtendedDynamicStateSupported &&
+                                                           GloveVkContext.vkCmdSetDepthBiasEnableEXT;
+    }
+#endif
+}
+
 vkContext_t *
 GetContext()
 {
@@ -421,8 +735,13 @@ ResetContextResources()
     GloveVkContext.vkGraphicsQueueNodeIndex     = 0;
     GloveVkContext.vkDevice                     = VK_NULL_HANDLE;
     GloveVkContext.vkSyncItems                  = nullptr;
+    GloveVkContext.vkSamplerCache               = nullptr;
     GloveVkContext.mIsMaintenanceExtSupported   = false;
+    GloveVkContext.mIsPhysicalDeviceProperties2Supported = false;
+    GloveVkContext.mIsExtendedDynamicStateSupported  = false;
+    GloveVkContext.mIsExtendedDynamicState2Supported = false;
     GloveVkContext.mInitialized                 = false;
+    GloveVkContext.vkNonCoherentAtomSize        = 1;
     memset(static_cast<void*>(&GloveVkContext.vkDeviceMemoryProperties), 0,
            sizeof(VkPhysicalDeviceMemoryProperties));
 }
@@ -450,6 +769,9 @@ InitContext()
         return false;
     }
     InitVkQueue();
+    InitVkExtendedDynamicState();
+
+    GloveVkContext.vkSamplerCache = new SamplerCache(&GloveVkContext);
 
     GloveVkContext.mInitialized = true;
 
@@ -477,6 +799,7 @@ TerminateContext()
 
     if(GloveVkContext.vkDevice != VK_NULL_HANDLE ) {
         vkDeviceWaitIdle(GloveVkContext.vkDevice);
+        SafeDelete(GloveVkContext.vkSamplerCache);
         vkDestroyDevice(GloveVkContext.vkDevice, nullptr);
         vkDestroyInstance(GloveVkContext.vkInstance, nullptr);
     }
@@ -26,6 +26,7 @@
 
 #include <map>
 #include <vector>
+#include <mutex>
 #include "utils/glLogger.h"
 #include "vulkan/vulkan.h"
 #include "rendering_api_interface.h"
@@ -34,6 +35,8 @@ using namespace std;
 
 namespace vulkanAPI {
 
+    class SamplerCache;
+
     typedef struct vkContext_t {
         vkContext_t() {
             vkInstance            = VK_NULL_HANDLE;
@@ -42,8 +45,14 @@ namespace vulkanAPI {
             vkGraphicsQueueNodeIndex = 0;
             vkDevice = VK_NULL_HANDLE;
             vkSyncItems             = nullptr;
+            vkSamplerCache          = nullptr;
             mIsMaintenanceExtSupported = false;
+            mIsPhysicalDeviceProperties2Supported = false;
+            mIsExtendedDynamicStateSupported  = false;
+            mIsExtendedDynamicState2Supported = false;
             mInitialized            = false;
+            vkDeviceSerial          = 0;
+            vkNonCoherentAtomSize   = 1;
             memset(static_cast<void*>(&vkDeviceMemoryProperties), 0,
                    sizeof(VkPhysicalDeviceMemoryProperties));
         }
@@ -54,9 +63,34 @@ namespace vulkanAPI {
         uint32_t                                            vkGraphicsQueueNodeIndex;
         VkDevice                                            vkDevice;
         VkPhysicalDeviceMemoryProperties                    vkDeviceMemoryProperties;
+        // flushed/invalidated ranges of non coherent memory are aligned to it
+        VkDeviceSize                                        vkNonCoherentAtomSize;
         vkSyncItems_t                                       *vkSyncItems;
+        SamplerCache                                        *vkSamplerCache;
         bool                                                mIsMaintenanceExtSupported;
+        bool                                                mIsPhysicalDeviceProperties2Supported;
+        bool                                                mIsExtendedDynamicStateSupported;
+        bool                                                mIsExtendedDynamicState2Supported;
         bool                                                mInitialized;
+        mutable std::mutex                                  vkQueueMutex;
+        // serials of the draw command buffers of all contexts that are recorded or in flight,
+        // with the fence of their submission. The fence is VK_NULL_HANDLE while recording
+        mutable std::mutex                                  vkDeviceSerialMutex;
+        mutable uint64_t                                    vkDeviceSerial;
+        mutable std::map<uint64_t, VkFence>                 vkPendingDeviceSerials;
+
+#ifdef VK_EXT_extended_dynamic_state
+        PFN_vkCmdSetCullModeEXT                             vkCmdSetCullModeEXT;
+        PFN_vkCmdSetFrontFaceEXT                            vkCmdSetFrontFaceEXT;
+        PFN_vkCmdSetDepthTestEnableEXT                      vkCmdSetDepthTestEnableEXT;
+        PFN_vkCmdSetDepthWriteEnableEXT                     vkCmdSetDepthWriteEnableEXT;
+        PFN_vkCmdSetDepthCompareOpEXT                       vkCmdSetDepthCompareOpEXT;
+        PFN_vkCmdSetStencilTestEnableEXT                    vkCmdSetStencilTestEnableEXT;
+        PFN_vkCmdSetStencilOpEXT                            vkCmdSetStencilOpEXT;
+#endif
+#ifdef VK_EXT_extended_dynamic_state2
+        PFN_vkCmdSetDepthBiasEnableEXT                      vkCmdSetDepthBiasEnableEXT;
+#endif
     } vkContext_t;
 
     vkContext_t *                     GetContext();
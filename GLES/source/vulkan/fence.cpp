@@ -81,6 +81,17 @@ Fence::Wait(VkBool32 waitAll, uint64_t timeout)
     return true;
 }
 
+bool
+Fence::GetStatus(void) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkResult err = vkGetFenceStatus(mVkContext->vkDevice, mVkFence);
+    assert(err == VK_SUCCESS || err == VK_NOT_READY);
+
+    return (err == VK_SUCCESS);
+}
+
 bool
 Fence::Create(bool signaled)
 {
@@ -57,6 +57,7 @@ public:
     bool                              Wait(VkBool32  waitAll, uint64_t timeout);
 
 // Get Functions
+    bool                              GetStatus(void)                     const;
     inline VkFence                    GetFence(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkFence; }
 
 // Set Functions
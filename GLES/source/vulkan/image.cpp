@@ -84,7 +84,8 @@ Image::SetImageTiling(void)
         flagbits = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;
     }
 
-    if      (props.linearTilingFeatures  & flagbits) {
+    // Multisampled images can only be created with optimal tiling
+    if      (mVkSampleCount == VK_SAMPLE_COUNT_1_BIT && (props.linearTilingFeatures & flagbits)) {
         mVkImageTiling = VK_IMAGE_TILING_LINEAR;
     }
     else if (props.optimalTilingFeatures & flagbits) {
@@ -224,140 +225,89 @@ Image::ModifyImageSubresourceRange(uint32_t baseMipLevel, uint32_t levelCount, u
     mVkImageSubresourceRange.layerCount      = layerCount;
 }
 
-void
-Image::ModifyImageLayout(VkCommandBuffer *activeCmdBuffer, VkImageLayout newImageLayout)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    VkImageLayout oldImageLayout = mVkImageLayout;
+/// Pipeline stages and memory accesses that an image performs while in a layout
+typedef struct imageLayoutUsage_t {
+    VkPipelineStageFlags              stages;
+    VkAccessFlags                     readAccess;
+    VkAccessFlags                     writeAccess;
+} imageLayoutUsage_t;
 
-    VkImageMemoryBarrier imageMemoryBarrier;
-    imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    imageMemoryBarrier.pNext                = nullptr;
-    imageMemoryBarrier.srcAccessMask        = 0;
-    imageMemoryBarrier.dstAccessMask        = 0;
-    imageMemoryBarrier.oldLayout            = oldImageLayout;
-    imageMemoryBarrier.newLayout            = newImageLayout;
-    imageMemoryBarrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
-    imageMemoryBarrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
-    imageMemoryBarrier.image                = mVkImage;
-    imageMemoryBarrier.subresourceRange     = mVkImageSubresourceRange;
+static imageLayoutUsage_t
+GetImageLayoutUsage(VkImageLayout layout)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-    VkPipelineStageFlags srcStages  = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    VkPipelineStageFlags destStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    switch(layout) {
+    case VK_IMAGE_LAYOUT_UNDEFINED:
+        // contents are discarded, nothing to wait for
+        return { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0 };
 
-    // Source layouts (old)
-    // Source access mask controls actions that have to be finished on the old layout
-    // before it will be transitioned to the new layout
-    switch(oldImageLayout) {
     case VK_IMAGE_LAYOUT_PREINITIALIZED:
-            // Image is preinitialized
-            // Only valid as initial layout for linear images, preserves memory contents
-            // Make sure host writes have been finished
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
-            srcStages = VK_PIPELINE_STAGE_HOST_BIT;
-            break;
+        // linear images written by the host before their first use
+        return { VK_PIPELINE_STAGE_HOST_BIT, 0, VK_ACCESS_HOST_WRITE_BIT };
 
     case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-            // Image is a color attachment
-            // Make sure any writes to the color buffer have been finished
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            srcStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            break;
+        // loaded and blended as well as written by the render pass
+        return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                 VK_ACCESS_COLOR_ATTACHMENT_READ_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
 
     case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-            // Image is a depth/stencil attachment
-            // Make sure any writes to the depth/stencil buffer have been finished
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            srcStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-            break;
+        return { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+        // GLSL ES allows texture lookups in vertex shaders too
+        return { VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                 VK_ACCESS_SHADER_READ_BIT, 0 };
 
     case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
-            // Image is a transfer source
-            // Make sure any reads from the image have been finished
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-            srcStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            break;
+        return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, 0 };
 
     case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-            // Image is a transfer destination
-            // Make sure any writes to the image have been finished
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            break;
+        return { VK_PIPELINE_STAGE_TRANSFER_BIT, 0, VK_ACCESS_TRANSFER_WRITE_BIT };
 
-    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-            // Image is read by a shader
-            // Make sure any shader reads from the image have been finished
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-            srcStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            break;
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+        // the presentation engine is synchronized through the acquire semaphore,
+        // whose wait is tied to the color attachment output stage
+        return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0 };
 
-    case VK_IMAGE_LAYOUT_UNDEFINED:
+    case VK_IMAGE_LAYOUT_GENERAL:
     default:
-            // Image layout is undefined (or does not matter)
-            // Only valid as initial layout
-            // No flags required, listed only for completeness
-            imageMemoryBarrier.srcAccessMask = 0;
-            break;
+        // layout supports all operations, the image may be used by any of them
+        return { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                 VK_ACCESS_MEMORY_READ_BIT, VK_ACCESS_MEMORY_WRITE_BIT };
     }
+}
 
+void
+Image::ModifyImageLayout(VkCommandBuffer *activeCmdBuffer, VkImageLayout newImageLayout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
-    // Target layouts (new)
-    // Destination access mask controls the dependency for the new image layout
-    switch(newImageLayout) {
-    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-        // Image will be used as a transfer destination
-        // Make sure any writes to the image have been finished
-        imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        destStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        break;
-
-    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
-        // Image will be used as a transfer source
-        // Make sure any reads from and writes to the image have been finished
-        imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        destStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        break;
-
-    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-        // Image will be used as a color attachment
-        // Make sure any writes to the color buffer have been finished
-        imageMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        destStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        break;
-
-    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-        // Image layout will be used as a depth/stencil attachment
-        // Make sure any writes to depth/stencil buffer have been finished
-        imageMemoryBarrier.dstAccessMask = imageMemoryBarrier.dstAccessMask | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-        destStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-        break;
-
-    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-        // Image will be read in a shader (sampler, input attachment)
-        // Make sure any writes to the image have been finished
-        if(imageMemoryBarrier.srcAccessMask == 0) {
-            imageMemoryBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
-            srcStages = VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
-        }
-        imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        destStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-        break;
+    VkImageLayout oldImageLayout = mVkImageLayout;
 
-    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
-        imageMemoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-        break;
+    const imageLayoutUsage_t srcUsage = GetImageLayoutUsage(oldImageLayout);
+    const imageLayoutUsage_t dstUsage = GetImageLayoutUsage(newImageLayout);
 
-    case VK_IMAGE_LAYOUT_GENERAL:
-        // Image layout supports all operations
-        imageMemoryBarrier.dstAccessMask = 0;
-        break;
+    VkImageMemoryBarrier imageMemoryBarrier;
+    imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageMemoryBarrier.pNext                = nullptr;
+    // only writes of the previous usage need to be made available, reads are
+    // ordered against the new usage by the execution dependency alone
+    imageMemoryBarrier.srcAccessMask        = srcUsage.writeAccess;
+    // the layout transition writes the image, so every access of the new usage waits for it
+    imageMemoryBarrier.dstAccessMask        = dstUsage.readAccess | dstUsage.writeAccess;
+    imageMemoryBarrier.oldLayout            = oldImageLayout;
+    imageMemoryBarrier.newLayout            = newImageLayout;
+    imageMemoryBarrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+    imageMemoryBarrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+    imageMemoryBarrier.image                = mVkImage;
+    imageMemoryBarrier.subresourceRange     = mVkImageSubresourceRange;
 
-    default:
-        NOT_REACHED();
-        break;
-    }
+    // images leave for presentation at the end of the queue, the present waits on a semaphore
+    const VkPipelineStageFlags srcStages  = srcUsage.stages;
+    const VkPipelineStageFlags destStages = newImageLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR ?
+                                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : dstUsage.stages;
 
     vkCmdPipelineBarrier(*activeCmdBuffer, srcStages, destStages, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
 
@@ -393,4 +343,21 @@ Image::FindSupportedVkColorFormat(VkFormat format)
     return VK_FORMAT_R8G8B8A8_UNORM;
 }
 
+VkFormat
+Image::FindSupportedVkCompressedFormat(VkFormat format)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    //Check if the selected block format can be sampled from an optimally tiled image
+    VkFormatProperties formatDeviceProps;
+    vkGetPhysicalDeviceFormatProperties(mVkContext->vkGpus[0], format, &formatDeviceProps);
+
+    if(formatDeviceProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) {
+        return format;
+    }
+
+    // the blocks are decoded on the host instead
+    return VK_FORMAT_R8G8B8A8_UNORM;
+}
+
 } 
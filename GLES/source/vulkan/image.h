@@ -99,10 +99,13 @@ public:
     inline VkFormat                   GetFormat(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mVkFormat;         }
     inline VkImageTarget              GetImageTarget(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageTarget;    }
     inline VkImageLayout              GetImageLayout(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageLayout;    }
+    inline VkImageUsageFlagBits       GetImageUsage(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageUsage;     }
+    inline VkImageTiling              GetImageTiling(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageTiling;    }
     inline VkBufferImageCopy *        GetBufferImageCopy(void)                  { FUN_ENTRY(GL_LOG_TRACE); return &mVkBufferImageCopy;      }
     inline VkImageSubresourceRange    GetImageSubresourceRange(void)      const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageSubresourceRange; }
     inline uint32_t                   GetMipLevels(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mMipLevels;        }
     inline uint32_t                   GetLayers(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mLayers;           }
+    inline VkSampleCountFlagBits      GetSampleCount(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mVkSampleCount;    }
 
 // Set Functions
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext     = vkContext; }
@@ -118,9 +121,11 @@ public:
     inline void                       SetWidth(uint32_t width)                  { FUN_ENTRY(GL_LOG_TRACE); mWidth         = width;     }
     inline void                       SetHeight(uint32_t height)                { FUN_ENTRY(GL_LOG_TRACE); mHeight        = height;    }
     inline void                       SetMipLevels(uint32_t levels)             { FUN_ENTRY(GL_LOG_TRACE); mMipLevels     = levels;    }
+    inline void                       SetSampleCount(VkSampleCountFlagBits samples) { FUN_ENTRY(GL_LOG_TRACE); mVkSampleCount = samples; }
 
 // Find Functions
     VkFormat                          FindSupportedVkColorFormat(VkFormat format);
+    VkFormat                          FindSupportedVkCompressedFormat(VkFormat format);
 };
 
 }
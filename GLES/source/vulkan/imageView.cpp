@@ -35,7 +35,8 @@
 namespace vulkanAPI {
 
 ImageView::ImageView(const vkContext_t *vkContext)
-: mVkContext(vkContext), mVkImageView(VK_NULL_HANDLE)
+: mVkContext(vkContext), mVkImageView(VK_NULL_HANDLE),
+mVkComponentMapping({VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A})
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -70,10 +71,7 @@ ImageView::Create(vulkanAPI::Image *image)
     info.viewType         = (image->GetImageTarget() == Image::VK_IMAGE_TARGET_2D) ? VK_IMAGE_VIEW_TYPE_2D : VK_IMAGE_VIEW_TYPE_CUBE;
     info.image            = image->GetImage();
     info.format           = image->GetFormat();
-    info.components.r     = VK_COMPONENT_SWIZZLE_R;
-    info.components.g     = VK_COMPONENT_SWIZZLE_G;
-    info.components.b     = VK_COMPONENT_SWIZZLE_B;
-    info.components.a     = VK_COMPONENT_SWIZZLE_A;
+    info.components       = mVkComponentMapping;
     info.subresourceRange = image->GetImageSubresourceRange();
 
     VkResult err = vkCreateImageView(mVkContext->vkDevice, &info, nullptr, &mVkImageView);
@@ -36,6 +36,7 @@ private:
     vkContext_t *                     mVkContext;
 
     VkImageView                       mVkImageView;
+    VkComponentMapping                mVkComponentMapping;
 
 public:
 // Constructor
@@ -55,6 +56,8 @@ public:
 
 // Set Functions
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
+    inline void                       SetComponentMapping(const VkComponentMapping &mapping)
+                                                                                { FUN_ENTRY(GL_LOG_TRACE); mVkComponentMapping = mapping; }
 };
 
 }
@@ -33,7 +33,8 @@
 namespace vulkanAPI {
 
 Memory::Memory(const vkContext_t *vkContext, VkFlags flags)
-: mVkContext(vkContext), mVkMemory (VK_NULL_HANDLE), mVkMemoryFlags(0), mVkFlags(flags)
+: mVkContext(vkContext), mVkMemory (VK_NULL_HANDLE), mVkMemoryFlags(0), mVkFlags(flags), mVkPropertyFlags(0),
+  mMappedData(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -50,17 +51,104 @@ Memory::Release(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    Unmap();
+
     if(mVkMemory != VK_NULL_HANDLE) {
         vkFreeMemory(mVkContext->vkDevice, mVkMemory, nullptr);
         mVkMemory = VK_NULL_HANDLE;
     }
 }
 
+void *
+Memory::Map(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the whole allocation stays mapped until Unmap() or Release()
+    if(mMappedData == nullptr) {
+        VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, 0, VK_WHOLE_SIZE, mVkMemoryFlags, &mMappedData);
+        assert(!err);
+
+        if(err != VK_SUCCESS) {
+            mMappedData = nullptr;
+        }
+    }
+
+    return mMappedData;
+}
+
+void
+Memory::Unmap(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mMappedData != nullptr) {
+        vkUnmapMemory(mVkContext->vkDevice, mVkMemory);
+        mMappedData = nullptr;
+    }
+}
+
+bool
+Memory::FlushMappedData(VkDeviceSize offset, VkDeviceSize size)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mMappedData == nullptr || size == 0 || (mVkPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+        return true;
+    }
+
+    // the range is widened to multiples of nonCoherentAtomSize,
+    // unless it reaches the end of the allocation
+    const VkDeviceSize atomSize = mVkContext->vkNonCoherentAtomSize;
+    const VkDeviceSize begin    = offset - offset % atomSize;
+    const VkDeviceSize end      = (offset + size + atomSize - 1) / atomSize * atomSize;
+
+    VkMappedMemoryRange range;
+    range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.pNext  = nullptr;
+    range.memory = mVkMemory;
+    range.offset = begin;
+    range.size   = end >= mVkRequirements.size ? VK_WHOLE_SIZE : end - begin;
+
+    VkResult err = vkFlushMappedMemoryRanges(mVkContext->vkDevice, 1, &range);
+    assert(!err);
+
+    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
+}
+
+bool
+Memory::InvalidateMappedData(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mMappedData == nullptr || (mVkPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+        return true;
+    }
+
+    VkMappedMemoryRange range;
+    range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.pNext  = nullptr;
+    range.memory = mVkMemory;
+    range.offset = 0;
+    range.size   = VK_WHOLE_SIZE;
+
+    VkResult err = vkInvalidateMappedMemoryRanges(mVkContext->vkDevice, 1, &range);
+    assert(!err);
+
+    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
+}
+
 bool
 Memory::GetData(VkDeviceSize size, VkDeviceSize offset, void *data) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    // memory cannot be mapped twice, reuse the persistent mapping
+    if(mMappedData != nullptr) {
+        memcpy(data, static_cast<const uint8_t *>(mMappedData) + offset, size);
+        return true;
+    }
+
     void *pData;
     VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, offset, size, mVkMemoryFlags, &pData);
     assert(!err);
@@ -90,6 +178,17 @@ Memory::SetData(VkDeviceSize size, VkDeviceSize offset, const void *data)
 
     void *pData = nullptr;
 
+    // memory cannot be mapped twice, reuse the persistent mapping
+    if(mMappedData != nullptr) {
+        pData = static_cast<uint8_t *>(mMappedData) + offset;
+        if(data) {
+            memcpy(pData, data, size);
+        } else {
+            memset(pData, 0x0, size);
+        }
+        return FlushMappedData();
+    }
+
     VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, offset, size ? size : mVkRequirements.size, mVkMemoryFlags, &pData);
     assert(!err);
 
@@ -200,6 +299,8 @@ Memory::Create()
     err = vkAllocateMemory(mVkContext->vkDevice, &allocInfo, nullptr, &mVkMemory);
     assert(!err);
 
+    mVkPropertyFlags = mVkContext->vkDeviceMemoryProperties.memoryTypes[allocInfo.memoryTypeIndex].propertyFlags;
+
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
 }
 
@@ -41,7 +41,9 @@ private:
     const
     VkMemoryMapFlags                  mVkMemoryFlags;
     VkFlags                           mVkFlags;
+    VkMemoryPropertyFlags             mVkPropertyFlags;
     VkMemoryRequirements              mVkRequirements;
+    void *                            mMappedData;
 
 public:
 // Constructor
@@ -56,6 +58,12 @@ public:
 // Release Functions
     void                              Release(void);
 
+// Map Functions
+    void *                            Map(void);
+    void                              Unmap(void);
+    bool                              FlushMappedData(VkDeviceSize offset, VkDeviceSize size);
+    bool                              InvalidateMappedData(void);
+
 // Bind Functions
     bool                              BindBufferMemory(VkBuffer &buffer);
     bool                              BindImageMemory(VkImage &image);
@@ -70,6 +78,8 @@ public:
     bool                              SetData(VkDeviceSize size, VkDeviceSize offset, const void *data);
     void                              UpdateData(VkDeviceSize size, VkDeviceSize offset, const void *data);
 
+    inline VkFlags                    GetFlags(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkFlags; }
+    inline bool                       IsMapped(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mMappedData != nullptr; }
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
 };
 
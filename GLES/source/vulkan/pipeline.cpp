@@ -33,19 +33,12 @@ namespace vulkanAPI {
 Pipeline::Pipeline(const vkContext_t *vkContext)
 : mVkContext(vkContext), mVkPipeline(VK_NULL_HANDLE), mVkPipelineLayout(VK_NULL_HANDLE),
   mVkPipelineCache(VK_NULL_HANDLE), mVkPipelineVertexInputState(VK_NULL_HANDLE),
-  mVkPipelineShaderStageCount(0), mCacheManager(nullptr)
+  mDynamicStates(0), mVkPipelineShaderStageCount(0), mDirtyState(DIRTY_ALL), mCacheManager(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
     mVkPipelineShaderStageIDs[0]  = -1;
     mVkPipelineShaderStageIDs[1]  = -1;
-
-    mUpdateState.VertexAttribVBOs = true;
-    mUpdateState.IndexBuffer      = false;
-    mUpdateState.Viewport         = true;
-    mUpdateState.Pipeline         = true;
-
-    mEnabledDynamicStatesList.resize(VK_DYNAMIC_STATE_RANGE_SIZE);
 }
 
 Pipeline::~Pipeline()
@@ -291,27 +284,52 @@ Pipeline::CreateMultisampleState(VkBool32 alphaToOneEnable, VkBool32 alphaToCove
     SetMultisampleAlphaToCoverage(alphaToCoverageEnable);
 }
 
+uint32_t
+Pipeline::GetDynamicBit(VkDynamicState state)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    switch(state) {
+    case VK_DYNAMIC_STATE_VIEWPORT:                 return DYNAMIC_VIEWPORT;
+    case VK_DYNAMIC_STATE_SCISSOR:                  return DYNAMIC_SCISSOR;
+    case VK_DYNAMIC_STATE_LINE_WIDTH:               return DYNAMIC_LINE_WIDTH;
+    case VK_DYNAMIC_STATE_DEPTH_BIAS:               return DYNAMIC_DEPTH_BIAS;
+    case VK_DYNAMIC_STATE_BLEND_CONSTANTS:          return DYNAMIC_BLEND_CONSTANTS;
+    case VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK:     return DYNAMIC_STENCIL_COMPARE_MASK;
+    case VK_DYNAMIC_STATE_STENCIL_WRITE_MASK:       return DYNAMIC_STENCIL_WRITE_MASK;
+    case VK_DYNAMIC_STATE_STENCIL_REFERENCE:        return DYNAMIC_STENCIL_REFERENCE;
+#ifdef VK_EXT_extended_dynamic_state
+    case VK_DYNAMIC_STATE_CULL_MODE_EXT:            return DYNAMIC_CULL_MODE;
+    case VK_DYNAMIC_STATE_FRONT_FACE_EXT:           return DYNAMIC_FRONT_FACE;
+    case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT:    return DYNAMIC_DEPTH_TEST_ENABLE;
+    case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT:   return DYNAMIC_DEPTH_WRITE_ENABLE;
+    case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT:     return DYNAMIC_DEPTH_COMPARE_OP;
+    case VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT:  return DYNAMIC_STENCIL_TEST_ENABLE;
+    case VK_DYNAMIC_STATE_STENCIL_OP_EXT:           return DYNAMIC_STENCIL_OP;
+#endif
+#ifdef VK_EXT_extended_dynamic_state2
+    case VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT:    return DYNAMIC_DEPTH_BIAS_ENABLE;
+#endif
+    default: { NOT_REACHED(); return 0; }
+    }
+}
+
 void
 Pipeline::CreateDynamicState(const std::vector<VkDynamicState>& states)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
-    assert(states.size() <= VK_DYNAMIC_STATE_RANGE_SIZE);
-    for(size_t index = 0; index < mEnabledDynamicStatesList.size(); ++index) {
-        mEnabledDynamicStatesList[index] = false;
-    }
-    memset(mVkPipelineDynamicStateEnables, 0, sizeof(mVkPipelineDynamicStateEnables));
 
-    for(size_t stateIndex = 0; stateIndex < states.size(); ++stateIndex) {
-        VkDynamicState state = states[stateIndex];
-        mVkPipelineDynamicStateEnables[stateIndex] = state;
-        mEnabledDynamicStatesList[state] = true;
+    mDynamicStates = 0;
+    for(auto state : states) {
+        mDynamicStates |= GetDynamicBit(state);
     }
+    mVkPipelineDynamicStateEnables = states;
 
     memset(static_cast<void *>(&mVkPipelineDynamicState), 0, sizeof(mVkPipelineDynamicState));
     mVkPipelineDynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
     mVkPipelineDynamicState.pNext             = nullptr;
-    mVkPipelineDynamicState.dynamicStateCount = static_cast<uint32_t>(states.size());
-    mVkPipelineDynamicState.pDynamicStates    = mVkPipelineDynamicStateEnables;
+    mVkPipelineDynamicState.dynamicStateCount = static_cast<uint32_t>(mVkPipelineDynamicStateEnables.size());
+    mVkPipelineDynamicState.pDynamicStates    = mVkPipelineDynamicStateEnables.data();
 }
 
 void
@@ -319,23 +337,67 @@ Pipeline::UpdateDynamicState(const VkCommandBuffer *CmdBuffer, float lineWidth)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mEnabledDynamicStatesList[VK_DYNAMIC_STATE_VIEWPORT]) {
+    if(mDynamicStates & DYNAMIC_VIEWPORT) {
         vkCmdSetViewport  (*CmdBuffer, 0, mVkPipelineViewportState.viewportCount, &mVkViewport);
     }
-    if(mEnabledDynamicStatesList[VK_DYNAMIC_STATE_SCISSOR]) {
+    if(mDynamicStates & DYNAMIC_SCISSOR) {
         vkCmdSetScissor   (*CmdBuffer, 0, mVkPipelineViewportState.scissorCount , &mVkScissorRect);
     }
-    if(mEnabledDynamicStatesList[VK_DYNAMIC_STATE_LINE_WIDTH]) {
+    if(mDynamicStates & DYNAMIC_LINE_WIDTH) {
         vkCmdSetLineWidth (*CmdBuffer, lineWidth);
     }
-    /*
-    TODO:: fill the remaining dynamic states
-    VK_DYNAMIC_STATE_BLEND_CONSTANTS
-    VK_DYNAMIC_STATE_DEPTH_BOUNDS
-    VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK
-    VK_DYNAMIC_STATE_STENCIL_WRITE_MASK
-    VK_DYNAMIC_STATE_STENCIL_REFERENCE
-    */
+    if(mDynamicStates & DYNAMIC_DEPTH_BIAS) {
+        vkCmdSetDepthBias (*CmdBuffer, mVkPipelineRasterizationState.depthBiasConstantFactor,
+                                       mVkPipelineRasterizationState.depthBiasClamp,
+                                       mVkPipelineRasterizationState.depthBiasSlopeFactor);
+    }
+    if(mDynamicStates & DYNAMIC_BLEND_CONSTANTS) {
+        vkCmdSetBlendConstants(*CmdBuffer, mVkPipelineColorBlendState.blendConstants);
+    }
+    if(mDynamicStates & DYNAMIC_STENCIL_COMPARE_MASK) {
+        vkCmdSetStencilCompareMask(*CmdBuffer, VK_STENCIL_FACE_FRONT_BIT, mVkPipelineDepthStencilState.front.compareMask);
+        vkCmdSetStencilCompareMask(*CmdBuffer, VK_STENCIL_FACE_BACK_BIT,  mVkPipelineDepthStencilState.back.compareMask);
+    }
+    if(mDynamicStates & DYNAMIC_STENCIL_WRITE_MASK) {
+        vkCmdSetStencilWriteMask  (*CmdBuffer, VK_STENCIL_FACE_FRONT_BIT, mVkPipelineDepthStencilState.front.writeMask);
+        vkCmdSetStencilWriteMask  (*CmdBuffer, VK_STENCIL_FACE_BACK_BIT,  mVkPipelineDepthStencilState.back.writeMask);
+    }
+    if(mDynamicStates & DYNAMIC_STENCIL_REFERENCE) {
+        vkCmdSetStencilReference  (*CmdBuffer, VK_STENCIL_FACE_FRONT_BIT, mVkPipelineDepthStencilState.front.reference);
+        vkCmdSetStencilReference  (*CmdBuffer, VK_STENCIL_FACE_BACK_BIT,  mVkPipelineDepthStencilState.back.reference);
+    }
+
+#ifdef VK_EXT_extended_dynamic_state
+    if(mDynamicStates & DYNAMIC_CULL_MODE) {
+        mVkContext->vkCmdSetCullModeEXT         (*CmdBuffer, mVkPipelineRasterizationState.cullMode);
+    }
+    if(mDynamicStates & DYNAMIC_FRONT_FACE) {
+        mVkContext->vkCmdSetFrontFaceEXT        (*CmdBuffer, mVkPipelineRasterizationState.frontFace);
+    }
+    if(mDynamicStates & DYNAMIC_DEPTH_TEST_ENABLE) {
+        mVkContext->vkCmdSetDepthTestEnableEXT  (*CmdBuffer, mVkPipelineDepthStencilState.depthTestEnable);
+    }
+    if(mDynamicStates & DYNAMIC_DEPTH_WRITE_ENABLE) {
+        mVkContext->vkCmdSetDepthWriteEnableEXT (*CmdBuffer, mVkPipelineDepthStencilState.depthWriteEnable);
+    }
+    if(mDynamicStates & DYNAMIC_DEPTH_COMPARE_OP) {
+        mVkContext->vkCmdSetDepthCompareOpEXT   (*CmdBuffer, mVkPipelineDepthStencilState.depthCompareOp);
+    }
+    if(mDynamicStates & DYNAMIC_STENCIL_TEST_ENABLE) {
+        mVkContext->vkCmdSetStencilTestEnableEXT(*CmdBuffer, mVkPipelineDepthStencilState.stencilTestEnable);
+    }
+    if(mDynamicStates & DYNAMIC_STENCIL_OP) {
+        const VkStencilOpState &front = mVkPipelineDepthStencilState.front;
+        const VkStencilOpState &back  = mVkPipelineDepthStencilState.back;
+        mVkContext->vkCmdSetStencilOpEXT(*CmdBuffer, VK_STENCIL_FACE_FRONT_BIT, front.failOp, front.passOp, front.depthFailOp, front.compareOp);
+        mVkContext->vkCmdSetStencilOpEXT(*CmdBuffer, VK_STENCIL_FACE_BACK_BIT,  back.failOp,  back.passOp,  back.depthFailOp,  back.compareOp);
+    }
+#endif
+#ifdef VK_EXT_extended_dynamic_state2
+    if(mDynamicStates & DYNAMIC_DEPTH_BIAS_ENABLE) {
+        mVkContext->vkCmdSetDepthBiasEnableEXT  (*CmdBuffer, mVkPipelineRasterizationState.depthBiasEnable);
+    }
+#endif
 }
 
 void
@@ -363,7 +425,7 @@ Pipeline::Create(const VkRenderPass *renderpass)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mUpdateState.Pipeline) {
+    if(mDirtyState & DIRTY_PIPELINE) {
         SetInfo(renderpass);
         return CreateGraphicsPipeline();
     }
@@ -380,10 +442,15 @@ Pipeline::CreateGraphicsPipeline(void)
 
     VkResult err = vkCreateGraphicsPipelines(mVkContext->vkDevice, mVkPipelineCache, 1, &mVkPipelineInfo, nullptr, &mVkPipeline);
     assert(!err);
-    
-    mUpdateState.Pipeline = false;
 
-    return (err == VK_SUCCESS);
+    // the state stays dirty for the next attempt if the pipeline could not be created
+    if(err != VK_SUCCESS) {
+        return false;
+    }
+
+    mDirtyState &= ~DIRTY_PIPELINE;
+
+    return true;
 }
 
 }
@@ -30,7 +30,48 @@
 namespace vulkanAPI {
 
 class Pipeline {
+public:
+    /// State groups tracked between draws. Only the groups that changed
+    /// since the previous draw are revalidated.
+    typedef enum DirtyBits {
+        DIRTY_BLEND             = 1 << 0,
+        DIRTY_DEPTH_STENCIL     = 1 << 1,
+        DIRTY_RASTER            = 1 << 2,
+        DIRTY_VERTEX_INPUT      = 1 << 3,
+        DIRTY_VIEWPORT_SCISSOR  = 1 << 4,
+        DIRTY_DESCRIPTORS       = 1 << 5,
+        DIRTY_PROGRAM           = 1 << 6,
+        DIRTY_INPUT_ASSEMBLY    = 1 << 7,
+        DIRTY_MULTISAMPLE       = 1 << 8,
+        DIRTY_RENDER_PASS       = 1 << 9,
+        DIRTY_INDEX_BUFFER      = 1 << 10,
+
+        /// groups that are baked into the VkPipeline object
+        DIRTY_PIPELINE          = DIRTY_BLEND | DIRTY_DEPTH_STENCIL | DIRTY_RASTER | DIRTY_VERTEX_INPUT |
+                                  DIRTY_PROGRAM | DIRTY_INPUT_ASSEMBLY | DIRTY_MULTISAMPLE | DIRTY_RENDER_PASS,
+        DIRTY_ALL               = DIRTY_PIPELINE | DIRTY_VIEWPORT_SCISSOR | DIRTY_DESCRIPTORS | DIRTY_INDEX_BUFFER
+    } DirtyBits;
+
 private:
+    /// State that is set in the command buffer instead of being baked into the VkPipeline
+    typedef enum DynamicBits {
+        DYNAMIC_VIEWPORT                = 1 << 0,
+        DYNAMIC_SCISSOR                 = 1 << 1,
+        DYNAMIC_LINE_WIDTH              = 1 << 2,
+        DYNAMIC_DEPTH_BIAS              = 1 << 3,
+        DYNAMIC_BLEND_CONSTANTS         = 1 << 4,
+        DYNAMIC_STENCIL_COMPARE_MASK    = 1 << 5,
+        DYNAMIC_STENCIL_WRITE_MASK      = 1 << 6,
+        DYNAMIC_STENCIL_REFERENCE       = 1 << 7,
+        DYNAMIC_CULL_MODE               = 1 << 8,
+        DYNAMIC_FRONT_FACE              = 1 << 9,
+        DYNAMIC_DEPTH_TEST_ENABLE       = 1 << 10,
+        DYNAMIC_DEPTH_WRITE_ENABLE      = 1 << 11,
+        DYNAMIC_DEPTH_COMPARE_OP        = 1 << 12,
+        DYNAMIC_STENCIL_TEST_ENABLE     = 1 << 13,
+        DYNAMIC_STENCIL_OP              = 1 << 14,
+        DYNAMIC_DEPTH_BIAS_ENABLE       = 1 << 15
+    } DynamicBits;
 
     const
     vkContext_t *                               mVkContext;
@@ -52,23 +93,21 @@ private:
     VkPipelineVertexInputStateCreateInfo       *mVkPipelineVertexInputState;
     VkPipelineMultisampleStateCreateInfo        mVkPipelineMultisampleState;
 
-    std::vector<bool>                           mEnabledDynamicStatesList;
-    VkDynamicState                              mVkPipelineDynamicStateEnables[VK_DYNAMIC_STATE_RANGE_SIZE];
+    uint32_t                                    mDynamicStates;
+    std::vector<VkDynamicState>                 mVkPipelineDynamicStateEnables;
     VkPipelineDynamicStateCreateInfo            mVkPipelineDynamicState;
 
     int                                         mVkPipelineShaderStageIDs[2];
     uint32_t                                    mVkPipelineShaderStageCount;
     VkPipelineShaderStageCreateInfo             mVkPipelineShaderStages[2];
 
-    struct {
-    VkBool32                                    Pipeline;
-    VkBool32                                    VertexAttribVBOs;
-    VkBool32                                    IndexBuffer;
-    VkBool32                                    Viewport;
-    }                                           mUpdateState;
+    uint32_t                                    mDirtyState;
 
     CacheManager                               *mCacheManager;
 
+    inline void SetStateDirty(uint32_t dirty, uint32_t dynamic)                 { FUN_ENTRY(GL_LOG_TRACE); if(!(mDynamicStates & dynamic)) { mDirtyState |= dirty; } }
+    static uint32_t                             GetDynamicBit(VkDynamicState state);
+
     bool                                        CreateGraphicsPipeline(void);
     void                                        MoveToCache(void);
     void                                        Release(void);
@@ -86,74 +125,72 @@ public:
     inline uint32_t & GetShaderStageCountRef(void)                              { FUN_ENTRY(GL_LOG_TRACE); return mVkPipelineShaderStageCount; }
     inline VkPipelineShaderStageCreateInfo * GetShaderStages(void)              { FUN_ENTRY(GL_LOG_TRACE); return mVkPipelineShaderStages; }
 
-    inline bool GetUpdatePipelineState(void)                              const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.Pipeline; }
-    inline bool GetUpdateViewportState(void)                              const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.Viewport; }
-    inline bool GetUpdateVertexAttribVBOs(void)                           const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.VertexAttribVBOs; }
-    inline bool GetUpdateIndexBuffer(void)                                const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.IndexBuffer; }
+    inline bool IsDirty(uint32_t bits)                                    const { FUN_ENTRY(GL_LOG_TRACE); return (mDirtyState & bits) != 0; }
 
 // Set Functions
-    inline void SetUpdateIndexBuffer(VkBool32 enable)                           { FUN_ENTRY(GL_LOG_TRACE); mUpdateState.IndexBuffer      = enable; }
-    inline void SetUpdateVertexAttribVBOs(VkBool32 enable)                      { FUN_ENTRY(GL_LOG_TRACE); mUpdateState.VertexAttribVBOs = enable; }
-    inline void SetUpdateViewportState(VkBool32 enable)                         { FUN_ENTRY(GL_LOG_TRACE); mUpdateState.Viewport         = enable; }
-    inline void SetUpdatePipeline(VkBool32 enable)                              { FUN_ENTRY(GL_LOG_TRACE); mUpdateState.Pipeline         = enable; }
+    inline void SetDirty(uint32_t bits)                                         { FUN_ENTRY(GL_LOG_TRACE); mDirtyState |=  bits; }
+    inline void ClearDirty(uint32_t bits)                                       { FUN_ENTRY(GL_LOG_TRACE); mDirtyState &= ~bits; }
 
-    inline void SetInputAssemblyTopology(VkPrimitiveTopology topology)          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineInputAssemblyState.topology            = topology; mUpdateState.Pipeline = true;}
-    inline void SetMultisampleAlphaToCoverage(VkBool32 enable)                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineMultisampleState.alphaToCoverageEnable = enable;   mUpdateState.Pipeline = true; }
+    inline void SetInputAssemblyTopology(VkPrimitiveTopology topology)          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineInputAssemblyState.topology            = topology; mDirtyState |= DIRTY_INPUT_ASSEMBLY;}
+    inline void SetMultisampleAlphaToCoverage(VkBool32 enable)                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineMultisampleState.alphaToCoverageEnable = enable;   mDirtyState |= DIRTY_MULTISAMPLE; }
+    inline void SetMultisampleRasterizationSamples(VkSampleCountFlagBits samples) { FUN_ENTRY(GL_LOG_TRACE); if(mVkPipelineMultisampleState.rasterizationSamples != samples) {
+                                                                                                           mVkPipelineMultisampleState.rasterizationSamples  = samples;  mDirtyState |= DIRTY_MULTISAMPLE; } }
 
-    inline void SetRasterizationPolygonMode(VkPolygonMode mode)                 { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.polygonMode = mode; mUpdateState.Pipeline = true;}
+    inline void SetRasterizationPolygonMode(VkPolygonMode mode)                 { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.polygonMode = mode; mDirtyState |= DIRTY_RASTER;}
     inline void SetRasterizationCullMode(VkBool32 enable,
-                                         VkCullModeFlagBits mode)               { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.cullMode  = enable ? mode : VK_CULL_MODE_NONE; mUpdateState.Pipeline = true;}
-    inline void SetRasterizationFrontFace(VkFrontFace face)                     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.frontFace = face; mUpdateState.Pipeline = true;}
+                                         VkCullModeFlagBits mode)               { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.cullMode  = enable ? mode : VK_CULL_MODE_NONE; SetStateDirty(DIRTY_RASTER, DYNAMIC_CULL_MODE);}
+    inline void SetRasterizationFrontFace(VkFrontFace face)                     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.frontFace = face; SetStateDirty(DIRTY_RASTER, DYNAMIC_FRONT_FACE);}
 
-    inline void SetRasterizationDepthBiasEnable(VkBool32 enable)                { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.depthBiasEnable         = enable; mUpdateState.Pipeline = true;}
-    inline void SetRasterizationDepthBiasConstantFactor(float factor)           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.depthBiasConstantFactor = factor; mUpdateState.Pipeline = true;}
-    inline void SetRasterizationDepthBiasSlopeFactor(float factor)              { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.depthBiasSlopeFactor    = factor; mUpdateState.Pipeline = true;}
-    inline void SetRasterizationLineWidth(float lineWidth)                      { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.lineWidth = lineWidth; mUpdateState.Pipeline = true;}
+    inline void SetRasterizationDepthBiasEnable(VkBool32 enable)                { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.depthBiasEnable         = enable; SetStateDirty(DIRTY_RASTER, DYNAMIC_DEPTH_BIAS_ENABLE);}
+    inline void SetRasterizationDepthBiasConstantFactor(float factor)           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.depthBiasConstantFactor = factor; SetStateDirty(DIRTY_RASTER, DYNAMIC_DEPTH_BIAS);}
+    inline void SetRasterizationDepthBiasSlopeFactor(float factor)              { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.depthBiasSlopeFactor    = factor; SetStateDirty(DIRTY_RASTER, DYNAMIC_DEPTH_BIAS);}
+    inline void SetRasterizationLineWidth(float lineWidth)                      { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineRasterizationState.lineWidth = lineWidth; SetStateDirty(DIRTY_RASTER, DYNAMIC_LINE_WIDTH);}
 
-    inline void SetColorBlendAttachmentEnable(VkBool32 enable)                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.blendEnable = enable; mUpdateState.Pipeline = true; }
+    inline void SetColorBlendAttachmentEnable(VkBool32 enable)                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.blendEnable = enable; mDirtyState |= DIRTY_BLEND; }
     inline void SetColorBlendConstants(float *color)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendState.blendConstants[0] = color[0];
                                                                                                            mVkPipelineColorBlendState.blendConstants[1] = color[1];
                                                                                                            mVkPipelineColorBlendState.blendConstants[2] = color[2];
-                                                                                                           mVkPipelineColorBlendState.blendConstants[3] = color[3];    mUpdateState.Pipeline = true;}
-    inline void SetColorBlendAttachmentWriteMask(VkColorComponentFlags mask)    { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.colorWriteMask = mask; mUpdateState.Pipeline = true;}
-
-    inline void SetColorBlendAttachmentSrcColorFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.srcColorBlendFactor = factor; mUpdateState.Pipeline = true;}
-    inline void SetColorBlendAttachmentDstColorFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.dstColorBlendFactor = factor; mUpdateState.Pipeline = true;}
-    inline void SetColorBlendAttachmentSrcAlphaFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.srcAlphaBlendFactor = factor; mUpdateState.Pipeline = true;}
-    inline void SetColorBlendAttachmentDstAlphaFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.dstAlphaBlendFactor = factor; mUpdateState.Pipeline = true;}
-
-    inline void SetColorBlendAttachmentColorOp(VkBlendOp op)                    { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.colorBlendOp = op; mUpdateState.Pipeline = true;}
-    inline void SetColorBlendAttachmentAlphaOp(VkBlendOp op)                    { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.alphaBlendOp = op; mUpdateState.Pipeline = true;}
-
-    inline void SetDepthTestEnable(VkBool32 enable)                             { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthTestEnable        = enable; mUpdateState.Pipeline = true;}
-    inline void SetDepthWriteEnable(VkBool32 enable)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthWriteEnable       = enable; mUpdateState.Pipeline = true;}
-    inline void SetDepthCompareOp(VkCompareOp op)                               { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthCompareOp         = op;     mUpdateState.Pipeline = true;}
-    inline void SetDepthBoundsTestEnable(VkBool32 enable)                       { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthBoundsTestEnable  = enable; mUpdateState.Pipeline = true;}
-    inline void SetMinDepthBounds(float depth)                                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.minDepthBounds         = depth;  mUpdateState.Pipeline = true;}
-    inline void SetMaxDepthBounds(float depth)                                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.maxDepthBounds         = depth;  mUpdateState.Pipeline = true;}
-
-    inline void SetStencilTestEnable(VkBool32 enable)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.stencilTestEnable      = enable; mUpdateState.Pipeline = true;}
-
-    inline void SetStencilBackFailOp(VkStencilOp op)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.failOp      = op;     mUpdateState.Pipeline = true;}
-    inline void SetStencilBackPassOp(VkStencilOp op)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.passOp      = op;     mUpdateState.Pipeline = true;}
-    inline void SetStencilBackZFailOp(VkStencilOp op)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.depthFailOp = op;     mUpdateState.Pipeline = true;}
-    inline void SetStencilBackWriteMask(uint32_t mask)                          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.writeMask   = mask;   mUpdateState.Pipeline = true;}
-    inline void SetStencilBackCompareOp(VkCompareOp op)                         { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.compareOp   = op;     mUpdateState.Pipeline = true;}
-    inline void SetStencilBackCompareMask(uint32_t mask)                        { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.compareMask = mask;   mUpdateState.Pipeline = true;}
-    inline void SetStencilBackReference(uint32_t ref)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.reference   = ref;    mUpdateState.Pipeline = true;}
-
-    inline void SetStencilFrontFailOp(VkStencilOp op)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.failOp      = op;    mUpdateState.Pipeline = true;}
-    inline void SetStencilFrontPassOp(VkStencilOp op)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.passOp      = op;    mUpdateState.Pipeline = true;}
-    inline void SetStencilFrontZFailOp(VkStencilOp op)                          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.depthFailOp = op;    mUpdateState.Pipeline = true;}
-    inline void SetStencilFrontWriteMask(uint32_t mask)                         { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.writeMask   = mask;  mUpdateState.Pipeline = true;}
-    inline void SetStencilFrontCompareOp(VkCompareOp op)                        { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.compareOp   = op;    mUpdateState.Pipeline = true;}
-    inline void SetStencilFrontCompareMask(uint32_t mask)                       { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.compareMask = mask;  mUpdateState.Pipeline = true;}
-    inline void SetStencilFrontReference(uint32_t ref)                          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.reference   = ref;   mUpdateState.Pipeline = true;}
+                                                                                                           mVkPipelineColorBlendState.blendConstants[3] = color[3];    SetStateDirty(DIRTY_BLEND, DYNAMIC_BLEND_CONSTANTS);}
+    inline void SetColorBlendAttachmentWriteMask(VkColorComponentFlags mask)    { FUN_ENTRY(GL_LOG_TRACE); if(mVkPipelineColorBlendAttachmentState.colorWriteMask != mask) {
+                                                                                                           mVkPipelineColorBlendAttachmentState.colorWriteMask = mask; mDirtyState |= DIRTY_BLEND; } }
+
+    inline void SetColorBlendAttachmentSrcColorFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.srcColorBlendFactor = factor; mDirtyState |= DIRTY_BLEND;}
+    inline void SetColorBlendAttachmentDstColorFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.dstColorBlendFactor = factor; mDirtyState |= DIRTY_BLEND;}
+    inline void SetColorBlendAttachmentSrcAlphaFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.srcAlphaBlendFactor = factor; mDirtyState |= DIRTY_BLEND;}
+    inline void SetColorBlendAttachmentDstAlphaFactor(VkBlendFactor factor)     { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.dstAlphaBlendFactor = factor; mDirtyState |= DIRTY_BLEND;}
+
+    inline void SetColorBlendAttachmentColorOp(VkBlendOp op)                    { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.colorBlendOp = op; mDirtyState |= DIRTY_BLEND;}
+    inline void SetColorBlendAttachmentAlphaOp(VkBlendOp op)                    { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineColorBlendAttachmentState.alphaBlendOp = op; mDirtyState |= DIRTY_BLEND;}
+
+    inline void SetDepthTestEnable(VkBool32 enable)                             { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthTestEnable        = enable; SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_DEPTH_TEST_ENABLE);}
+    inline void SetDepthWriteEnable(VkBool32 enable)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthWriteEnable       = enable; SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_DEPTH_WRITE_ENABLE);}
+    inline void SetDepthCompareOp(VkCompareOp op)                               { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthCompareOp         = op;     SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_DEPTH_COMPARE_OP);}
+    inline void SetDepthBoundsTestEnable(VkBool32 enable)                       { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.depthBoundsTestEnable  = enable; mDirtyState |= DIRTY_DEPTH_STENCIL;}
+    inline void SetMinDepthBounds(float depth)                                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.minDepthBounds         = depth;  mDirtyState |= DIRTY_DEPTH_STENCIL;}
+    inline void SetMaxDepthBounds(float depth)                                  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.maxDepthBounds         = depth;  mDirtyState |= DIRTY_DEPTH_STENCIL;}
+
+    inline void SetStencilTestEnable(VkBool32 enable)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.stencilTestEnable      = enable; SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_TEST_ENABLE);}
+
+    inline void SetStencilBackFailOp(VkStencilOp op)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.failOp      = op;     SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilBackPassOp(VkStencilOp op)                            { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.passOp      = op;     SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilBackZFailOp(VkStencilOp op)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.depthFailOp = op;     SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilBackWriteMask(uint32_t mask)                          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.writeMask   = mask;   SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_WRITE_MASK);}
+    inline void SetStencilBackCompareOp(VkCompareOp op)                         { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.compareOp   = op;     SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilBackCompareMask(uint32_t mask)                        { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.compareMask = mask;   SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_COMPARE_MASK);}
+    inline void SetStencilBackReference(uint32_t ref)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.back.reference   = ref;    SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_REFERENCE);}
+
+    inline void SetStencilFrontFailOp(VkStencilOp op)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.failOp      = op;    SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilFrontPassOp(VkStencilOp op)                           { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.passOp      = op;    SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilFrontZFailOp(VkStencilOp op)                          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.depthFailOp = op;    SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilFrontWriteMask(uint32_t mask)                         { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.writeMask   = mask;  SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_WRITE_MASK);}
+    inline void SetStencilFrontCompareOp(VkCompareOp op)                        { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.compareOp   = op;    SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_OP);}
+    inline void SetStencilFrontCompareMask(uint32_t mask)                       { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.compareMask = mask;  SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_COMPARE_MASK);}
+    inline void SetStencilFrontReference(uint32_t ref)                          { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineDepthStencilState.front.reference   = ref;   SetStateDirty(DIRTY_DEPTH_STENCIL, DYNAMIC_STENCIL_REFERENCE);}
 
     inline void SetCache(VkPipelineCache cache)                                 { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineCache            = cache; }
     inline void SetLayout(VkPipelineLayout layout)                              { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineLayout           = layout; }
     inline void SetVertexInputState(
-                            VkPipelineVertexInputStateCreateInfo *vertexInput)  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineVertexInputState = vertexInput; }
+                            VkPipelineVertexInputStateCreateInfo *vertexInput)  { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineVertexInputState = vertexInput; mDirtyState |= DIRTY_VERTEX_INPUT; }
     inline void SetCacheManager(CacheManager *cacheManager)                     { FUN_ENTRY(GL_LOG_TRACE); mCacheManager = cacheManager; }
            void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height);
            void SetScissor(int32_t x, int32_t y, int32_t width, int32_t height);
@@ -37,8 +37,12 @@ RenderPass::RenderPass(const vkContext_t *vkContext)
 : mVkContext(vkContext),
   mVkPipelineBindPoint(VK_PIPELINE_BIND_POINT_GRAPHICS),
   mVkRenderPass(VK_NULL_HANDLE),
+  mVkSampleCount(VK_SAMPLE_COUNT_1_BIT),
   mColorClearEnabled(false), mDepthClearEnabled(false), mStencilClearEnabled(false),
   mColorWriteEnabled(true), mDepthWriteEnabled(true), mStencilWriteEnabled(false),
+  mColorLoadDiscardEnabled(false), mDepthLoadDiscardEnabled(false), mStencilLoadDiscardEnabled(false),
+  mColorStoreDiscardEnabled(false), mDepthStoreDiscardEnabled(false), mStencilStoreDiscardEnabled(false),
+  mMultisampleLoadDiscardEnabled(false), mMultisampleStoreDiscardEnabled(false),
   mStarted(false)
 {
     FUN_ENTRY(GL_LOG_TRACE);
@@ -73,17 +77,32 @@ RenderPass::Create(VkFormat colorFormat, VkFormat depthstencilFormat)
 
     VkAttachmentReference           color;
     VkAttachmentReference           depthstencil;
+    VkAttachmentReference           resolve;
     vector<VkAttachmentDescription> attachments;
 
+    /// The multisampled color attachment is resolved to a single sampled one
+    const bool hasResolve = colorFormat != VK_FORMAT_UNDEFINED && mVkSampleCount != VK_SAMPLE_COUNT_1_BIT;
+
+    // discarded contents are neither loaded at the beginning nor stored at the end of the render pass;
+    // multisampled contents only need to survive render passes that are split within a frame
+    const VkBool32           colorMsDiscard = hasResolve && mMultisampleLoadDiscardEnabled;
+    const VkAttachmentLoadOp colorLoadOp    = (mColorLoadDiscardEnabled || colorMsDiscard) ? VK_ATTACHMENT_LOAD_OP_DONT_CARE : VK_ATTACHMENT_LOAD_OP_LOAD;
+    const VkAttachmentLoadOp depthLoadOp    = mDepthLoadDiscardEnabled   ? VK_ATTACHMENT_LOAD_OP_DONT_CARE : VK_ATTACHMENT_LOAD_OP_LOAD;
+    const VkAttachmentLoadOp stencilLoadOp  = mStencilLoadDiscardEnabled ? VK_ATTACHMENT_LOAD_OP_DONT_CARE : VK_ATTACHMENT_LOAD_OP_LOAD;
+    const VkBool32           colorStore     = mColorWriteEnabled   && !mColorStoreDiscardEnabled &&
+                                              !(hasResolve && mMultisampleStoreDiscardEnabled);
+    const VkBool32           depthStore     = mDepthWriteEnabled   && !mDepthStoreDiscardEnabled;
+    const VkBool32           stencilStore   = mStencilWriteEnabled && !mStencilStoreDiscardEnabled;
+
     if(colorFormat != VK_FORMAT_UNDEFINED) {
 
         /// Color attachment
         VkAttachmentDescription attachmentColor;
         attachmentColor.flags           = 0;
         attachmentColor.format          = colorFormat;
-        attachmentColor.samples         = VK_SAMPLE_COUNT_1_BIT;
-        attachmentColor.loadOp          = (mColorClearEnabled && mColorWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentColor.storeOp         = mColorWriteEnabled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachmentColor.samples         = mVkSampleCount;
+        attachmentColor.loadOp          = (mColorClearEnabled && mColorWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : colorLoadOp;
+        attachmentColor.storeOp         = colorStore ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attachmentColor.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attachmentColor.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attachmentColor.initialLayout   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
@@ -104,11 +123,11 @@ RenderPass::Create(VkFormat colorFormat, VkFormat depthstencilFormat)
         VkAttachmentDescription attachmentDepthStencil;
         attachmentDepthStencil.flags          = 0;
         attachmentDepthStencil.format         = depthstencilFormat;
-        attachmentDepthStencil.samples        = VK_SAMPLE_COUNT_1_BIT;
-        attachmentDepthStencil.loadOp         = (isDepth   && mDepthClearEnabled && mDepthWriteEnabled)     ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentDepthStencil.storeOp        = (isDepth   && mDepthWriteEnabled)                           ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachmentDepthStencil.stencilLoadOp  = (isStencil && mStencilClearEnabled && mStencilWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentDepthStencil.stencilStoreOp = (isStencil && mStencilWriteEnabled)                         ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachmentDepthStencil.samples        = mVkSampleCount;
+        attachmentDepthStencil.loadOp         = (isDepth   && mDepthClearEnabled && mDepthWriteEnabled)     ? VK_ATTACHMENT_LOAD_OP_CLEAR  : depthLoadOp;
+        attachmentDepthStencil.storeOp        = (isDepth   && depthStore)                                   ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachmentDepthStencil.stencilLoadOp  = (isStencil && mStencilClearEnabled && mStencilWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : stencilLoadOp;
+        attachmentDepthStencil.stencilStoreOp = (isStencil && stencilStore)                                 ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attachmentDepthStencil.initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
         attachmentDepthStencil.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
@@ -118,13 +137,33 @@ RenderPass::Create(VkFormat colorFormat, VkFormat depthstencilFormat)
         depthstencil.layout       = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
     }
 
+    /// Single sampled color attachment the multisampled one is resolved to
+    if(hasResolve) {
+
+        VkAttachmentDescription attachmentResolve;
+        attachmentResolve.flags           = 0;
+        attachmentResolve.format          = colorFormat;
+        attachmentResolve.samples         = VK_SAMPLE_COUNT_1_BIT;
+        attachmentResolve.loadOp          = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachmentResolve.storeOp         = mColorStoreDiscardEnabled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+        attachmentResolve.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachmentResolve.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachmentResolve.initialLayout   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        attachmentResolve.finalLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        attachments.push_back(attachmentResolve);
+
+        resolve.attachment         = attachments.size() - 1;
+        resolve.layout             = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+
     VkSubpassDescription subpass;
     subpass.pipelineBindPoint       = mVkPipelineBindPoint;
     subpass.flags                   = 0;
     subpass.colorAttachmentCount    = colorFormat        != VK_FORMAT_UNDEFINED ? 1             : 0;
     subpass.pColorAttachments       = colorFormat        != VK_FORMAT_UNDEFINED ? &color        : nullptr;
     subpass.pDepthStencilAttachment = depthstencilFormat != VK_FORMAT_UNDEFINED ? &depthstencil : nullptr;
-    subpass.pResolveAttachments     = nullptr;
+    subpass.pResolveAttachments     = hasResolve ? &resolve : nullptr;
     subpass.inputAttachmentCount    = 0;
     subpass.pInputAttachments       = nullptr;
     subpass.preserveAttachmentCount = 0;
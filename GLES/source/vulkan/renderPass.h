@@ -40,6 +40,7 @@ private:
     VkRenderPass            mVkRenderPass;
     VkClearValue            mVkClearValues[2];
     VkRect2D                mVkRenderArea;
+    VkSampleCountFlagBits   mVkSampleCount;
 
     VkBool32                mColorClearEnabled;
     VkBool32                mDepthClearEnabled;
@@ -49,6 +50,17 @@ private:
     VkBool32                mDepthWriteEnabled;
     VkBool32                mStencilWriteEnabled;
 
+    VkBool32                mColorLoadDiscardEnabled;
+    VkBool32                mDepthLoadDiscardEnabled;
+    VkBool32                mStencilLoadDiscardEnabled;
+
+    VkBool32                mColorStoreDiscardEnabled;
+    VkBool32                mDepthStoreDiscardEnabled;
+    VkBool32                mStencilStoreDiscardEnabled;
+
+    VkBool32                mMultisampleLoadDiscardEnabled;
+    VkBool32                mMultisampleStoreDiscardEnabled;
+
     VkBool32                mStarted;
 
 public:
@@ -77,6 +89,9 @@ public:
     inline VkBool32         GetColorWriteEnabled(void)                    const { FUN_ENTRY(GL_LOG_TRACE); return mColorWriteEnabled;   }
     inline VkBool32         GetDepthWriteEnabled(void)                    const { FUN_ENTRY(GL_LOG_TRACE); return mDepthWriteEnabled;   }
     inline VkBool32         GetStencilWriteEnabled(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mStencilWriteEnabled; }
+    inline VkSampleCountFlagBits GetSampleCount(void)                       const { FUN_ENTRY(GL_LOG_TRACE); return mVkSampleCount;       }
+    inline const VkRect2D * GetClearArea(void)                            const { FUN_ENTRY(GL_LOG_TRACE); return &mVkRenderArea;       }
+    inline const VkClearValue * GetClearValues(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkClearValues;       }
     inline VkRenderPass*    GetRenderPass(void)                                 { FUN_ENTRY(GL_LOG_TRACE); return &mVkRenderPass; }
 
 // Set Functions
@@ -87,6 +102,15 @@ public:
     inline void             SetColorWriteEnabled(VkBool32 enable)               { FUN_ENTRY(GL_LOG_TRACE); mColorWriteEnabled   = enable;    }
     inline void             SetDepthWriteEnabled(VkBool32 enable)               { FUN_ENTRY(GL_LOG_TRACE); mDepthWriteEnabled   = enable;    }
     inline void             SetStencilWriteEnabled(VkBool32 enable)             { FUN_ENTRY(GL_LOG_TRACE); mStencilWriteEnabled = enable;    }
+    inline void             SetSampleCount(VkSampleCountFlagBits samples)       { FUN_ENTRY(GL_LOG_TRACE); mVkSampleCount       = samples;   }
+    inline void             SetColorLoadDiscardEnabled(VkBool32 enable)         { FUN_ENTRY(GL_LOG_TRACE); mColorLoadDiscardEnabled    = enable; }
+    inline void             SetDepthLoadDiscardEnabled(VkBool32 enable)         { FUN_ENTRY(GL_LOG_TRACE); mDepthLoadDiscardEnabled    = enable; }
+    inline void             SetStencilLoadDiscardEnabled(VkBool32 enable)       { FUN_ENTRY(GL_LOG_TRACE); mStencilLoadDiscardEnabled  = enable; }
+    inline void             SetColorStoreDiscardEnabled(VkBool32 enable)        { FUN_ENTRY(GL_LOG_TRACE); mColorStoreDiscardEnabled   = enable; }
+    inline void             SetDepthStoreDiscardEnabled(VkBool32 enable)        { FUN_ENTRY(GL_LOG_TRACE); mDepthStoreDiscardEnabled   = enable; }
+    inline void             SetStencilStoreDiscardEnabled(VkBool32 enable)      { FUN_ENTRY(GL_LOG_TRACE); mStencilStoreDiscardEnabled = enable; }
+    inline void             SetMultisampleLoadDiscardEnabled(VkBool32 enable)   { FUN_ENTRY(GL_LOG_TRACE); mMultisampleLoadDiscardEnabled  = enable; }
+    inline void             SetMultisampleStoreDiscardEnabled(VkBool32 enable)  { FUN_ENTRY(GL_LOG_TRACE); mMultisampleStoreDiscardEnabled = enable; }
 
            void             SetClearArea(const VkRect2D *rect);
            void             SetClearColorValue(const float *value);
@@ -28,6 +28,7 @@
  */
 
 #include "sampler.h"
+#include "samplerCache.h"
 
 namespace vulkanAPI {
 
@@ -62,7 +63,9 @@ Sampler::Release(void)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     if(mVkSampler != VK_NULL_HANDLE) {
-        vkDestroySampler(mVkContext->vkDevice, mVkSampler, nullptr);
+        if(mVkContext->vkSamplerCache) {
+            mVkContext->vkSamplerCache->Release(mVkSampler);
+        }
         mVkSampler = VK_NULL_HANDLE;
     }
 
@@ -102,12 +105,12 @@ Sampler::Create()
     samplerInfo.borderColor             = mVkBorderColor;
     samplerInfo.unnormalizedCoordinates = mUnnormalizedCoordinates;
 
-    VkResult err = vkCreateSampler(mVkContext->vkDevice, &samplerInfo, nullptr, &mVkSampler);
-    assert(!err);
+    // identical samplers are shared between textures
+    mVkSampler = mVkContext->vkSamplerCache->Acquire(&samplerInfo);
 
     mUpdated = false;
 
-    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_TOO_MANY_OBJECTS);
+    return mVkSampler != VK_NULL_HANDLE;
 }
 
 }
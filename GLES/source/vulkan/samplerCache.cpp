@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       samplerCache.cpp
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Device-wide cache of reference counted VkSampler objects
+ *
+ *  @scope
+ *
+ *  Textures with identical sampling parameters share a single VkSampler.
+ *  Samplers are looked up by their full creation state and destroyed
+ *  when the last texture referencing them releases them. This keeps the
+ *  number of live samplers bounded by the number of distinct parameter
+ *  combinations rather than the number of textures.
+ *
+ */
+
+#include "samplerCache.h"
+
+namespace vulkanAPI {
+
+SamplerCache::samplerKey_t::samplerKey_t(const VkSamplerCreateInfo *info)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    memset(static_cast<void *>(this), 0, sizeof(*this));
+
+    magFilter               = info->magFilter;
+    minFilter               = info->minFilter;
+    mipmapMode              = info->mipmapMode;
+    addressModeU            = info->addressModeU;
+    addressModeV            = info->addressModeV;
+    addressModeW            = info->addressModeW;
+    mipLodBias              = info->mipLodBias;
+    anisotropyEnable        = info->anisotropyEnable;
+    maxAnisotropy           = info->maxAnisotropy;
+    compareEnable           = info->compareEnable;
+    compareOp               = info->compareOp;
+    minLod                  = info->minLod;
+    maxLod                  = info->maxLod;
+    borderColor             = info->borderColor;
+    unnormalizedCoordinates = info->unnormalizedCoordinates;
+}
+
+bool
+SamplerCache::samplerKey_t::operator==(const samplerKey_t &other) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return !memcmp(this, &other, sizeof(*this));
+}
+
+size_t
+SamplerCache::samplerKeyHash_t::operator()(const samplerKey_t &key) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // FNV-1a over the key bytes
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&key);
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < sizeof(key); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+SamplerCache::SamplerCache(const vkContext_t *vkContext)
+: mVkContext(vkContext)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+SamplerCache::~SamplerCache()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Clear();
+}
+
+VkSampler
+SamplerCache::Acquire(const VkSamplerCreateInfo *info)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    const samplerKey_t key(info);
+
+    // textures of a share group acquire their samplers from different threads
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    samplerMap_t::iterator it = mSamplers.find(key);
+    if(it != mSamplers.end()) {
+        ++it->second.refCount;
+        return it->second.sampler;
+    }
+
+    VkSampler sampler = VK_NULL_HANDLE;
+    VkResult err = vkCreateSampler(mVkContext->vkDevice, info, nullptr, &sampler);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    samplerEntry_t entry = {sampler, 1};
+    mSamplers.insert(std::make_pair(key, entry));
+    mKeys.insert(std::make_pair(sampler, key));
+
+    return sampler;
+}
+
+void
+SamplerCache::Release(VkSampler sampler)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::unordered_map<VkSampler, samplerKey_t>::iterator keyIt = mKeys.find(sampler);
+    if(keyIt == mKeys.end()) {
+        return;
+    }
+
+    samplerMap_t::iterator it = mSamplers.find(keyIt->second);
+    assert(it != mSamplers.end());
+
+    if(--it->second.refCount == 0) {
+        vkDestroySampler(mVkContext->vkDevice, sampler, nullptr);
+        mSamplers.erase(it);
+        mKeys.erase(keyIt);
+    }
+}
+
+void
+SamplerCache::Clear(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for(auto &it : mSamplers) {
+        vkDestroySampler(mVkContext->vkDevice, it.second.sampler, nullptr);
+    }
+    mSamplers.clear();
+    mKeys.clear();
+}
+
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       samplerCache.h
+ *  @author     Think Silicon
+ *  @date       25/07/2018
+ *  @version    1.0
+ *
+ *  @brief      Device-wide cache of reference counted VkSampler objects
+ *
+ */
+
+#ifndef __VKSAMPLERCACHE_H__
+#define __VKSAMPLERCACHE_H__
+
+#include "context.h"
+#include <unordered_map>
+#include <mutex>
+
+namespace vulkanAPI {
+
+class SamplerCache {
+
+private:
+
+    // the sampler state that affects VkSampler creation, zero initialized
+    // so that it can be hashed and compared as plain memory
+    typedef struct samplerKey_t {
+        VkFilter                      magFilter;
+        VkFilter                      minFilter;
+        VkSamplerMipmapMode           mipmapMode;
+        VkSamplerAddressMode          addressModeU;
+        VkSamplerAddressMode          addressModeV;
+        VkSamplerAddressMode          addressModeW;
+        float                         mipLodBias;
+        VkBool32                      anisotropyEnable;
+        float                         maxAnisotropy;
+        VkBool32                      compareEnable;
+        VkCompareOp                   compareOp;
+        float                         minLod;
+        float                         maxLod;
+        VkBorderColor                 borderColor;
+        VkBool32                      unnormalizedCoordinates;
+
+        samplerKey_t(const VkSamplerCreateInfo *info);
+        bool operator==(const samplerKey_t &other) const;
+    } samplerKey_t;
+
+    struct samplerKeyHash_t {
+        size_t operator()(const samplerKey_t &key) const;
+    };
+
+    typedef struct samplerEntry_t {
+        VkSampler                     sampler;
+        uint32_t                      refCount;
+    } samplerEntry_t;
+
+    typedef std::unordered_map<samplerKey_t, samplerEntry_t, samplerKeyHash_t> samplerMap_t;
+
+    const
+    vkContext_t *                     mVkContext;
+
+    samplerMap_t                      mSamplers;
+    std::unordered_map<VkSampler, samplerKey_t> mKeys;
+    std::mutex                        mMutex;
+
+public:
+// Constructor
+    SamplerCache(const vkContext_t *vkContext = nullptr);
+
+// Destructor
+    ~SamplerCache();
+
+// Acquire/Release Functions
+    VkSampler                         Acquire(const VkSamplerCreateInfo *info);
+    void                              Release(VkSampler sampler);
+    void                              Clear(void);
+
+// Get Functions
+    inline size_t                     GetSize(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return mSamplers.size(); }
+
+// Set Functions
+    inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
+};
+
+}
+
+#endif // __VKSAMPLERCACHE_H__
@@ -118,6 +118,55 @@ FindSupportedDepthStencilFormat(VkPhysicalDevice dev, uint32_t depthSize, uint32
     );
 }
 
+static VkSampleCountFlags
+GetSupportedSampleCounts(VkPhysicalDevice dev)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(dev, &props);
+
+    return props.limits.framebufferColorSampleCounts   &
+           props.limits.framebufferDepthSampleCounts   &
+           props.limits.framebufferStencilSampleCounts;
+}
+
+uint32_t
+GetMaxSupportedSampleCount(VkPhysicalDevice dev)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    VkSampleCountFlags counts = GetSupportedSampleCounts(dev);
+    for(uint32_t samples = VK_SAMPLE_COUNT_64_BIT; samples > VK_SAMPLE_COUNT_1_BIT; samples >>= 1) {
+        if(counts & samples) {
+            return samples;
+        }
+    }
+
+    return 1;
+}
+
+/// Returns the smallest supported sample count that is at least 'samples',
+/// falling back to the largest one the device can render to.
+VkSampleCountFlagBits
+FindSupportedSampleCount(VkPhysicalDevice dev, uint32_t samples)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(samples <= 1) {
+        return VK_SAMPLE_COUNT_1_BIT;
+    }
+
+    VkSampleCountFlags counts = GetSupportedSampleCounts(dev);
+    for(uint32_t count = VK_SAMPLE_COUNT_2_BIT; count <= VK_SAMPLE_COUNT_64_BIT; count <<= 1) {
+        if(count >= samples && (counts & count)) {
+            return static_cast<VkSampleCountFlagBits>(count);
+        }
+    }
+
+    return static_cast<VkSampleCountFlagBits>(GetMaxSupportedSampleCount(dev));
+}
+
 bool
 VkFormatIsDepthStencil(VkFormat format)
 {
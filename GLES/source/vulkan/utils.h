@@ -31,6 +31,8 @@
 uint32_t                GetVkFormatStencilBits(VkFormat format);
 uint32_t                GetVkFormatDepthBits(VkFormat format);
 VkFormat                FindSupportedDepthStencilFormat(VkPhysicalDevice dev, uint32_t depthSize, uint32_t stencilSize);
+VkSampleCountFlagBits   FindSupportedSampleCount(VkPhysicalDevice dev, uint32_t samples);
+uint32_t                GetMaxSupportedSampleCount(VkPhysicalDevice dev);
 VkFormat                FindSupportedFormat(VkPhysicalDevice vkPhysicalDevice, const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 bool                    VkFormatIsDepthStencil(VkFormat format);
 bool                    VkFormatIsDepth(VkFormat format);
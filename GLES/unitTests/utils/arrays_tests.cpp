@@ -67,4 +67,44 @@ TEST_F(ObjectArrayTest, DeleteShaders)
 
 }
 
+TEST_F(ObjectArrayTest, ReuseShaders)
+{
+    for(size_t i=1; i<11; i++) {
+        ASSERT_EQ(i, ShaderArray.Allocate());
+        ASSERT_EQ(i, ShaderArray.GetObjectId(ShaderArray.GetObject(i)));
+    }
+
+    Shader *shader = ShaderArray.GetObject(5);
+    ASSERT_TRUE(ShaderArray.Deallocate(5));
+    ASSERT_EQ(~0u, ShaderArray.GetObjectId(shader));
+
+    ASSERT_EQ(5u, ShaderArray.Allocate());
+    ASSERT_FALSE(ShaderArray.ObjectExists(5));
+    ASSERT_EQ(11u, ShaderArray.Allocate());
+
+    ASSERT_EQ(5u, ShaderArray.GetObjectId(ShaderArray.GetObject(5)));
+}
+
+TEST_F(ObjectArrayTest, ArbitraryShaders)
+{
+    const uint32_t handles[] = {0xFFFFFFFFu, 0x7FFFFFF0u};
+
+    for(auto handle : handles) {
+        ASSERT_FALSE(ShaderArray.ObjectExists(handle));
+        ASSERT_EQ(handle, ShaderArray.GetObjectId(ShaderArray.GetObject(handle)));
+        ASSERT_TRUE(ShaderArray.ObjectExists(handle));
+    }
+
+    // arbitrary handles do not move the handles that are generated next
+    ASSERT_EQ(1u, ShaderArray.Allocate());
+    ASSERT_EQ(2u, ShaderArray.GetObjectId(ShaderArray.GetObject(2)));
+    ASSERT_EQ(3u, ShaderArray.Allocate());
+    ASSERT_EQ(3u, ShaderArray.GetObjectList().size());
+
+    for(auto handle : handles) {
+        ASSERT_TRUE(ShaderArray.Deallocate(handle));
+        ASSERT_FALSE(ShaderArray.ObjectExists(handle));
+    }
+}
+
 } //end of namespace
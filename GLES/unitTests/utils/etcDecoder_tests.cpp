@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "etcDecoder_tests.h"
+
+namespace Testing {
+
+// Code here will be called immediately after the constructor (right
+// before each test).
+void EtcDecoderTest::SetUp(void) {
+    DstData.assign(4 * 16, 0);
+}
+
+// Code here will be called immediately after each test (right
+// before the destructor).
+void EtcDecoderTest::TearDown() {
+    return;
+}
+
+// Blocks are stored big-endian
+void EtcDecoderTest::StoreBlock(uint64_t bits, uint8_t *dst) {
+    for(int i = 0; i < 8; ++i) {
+        dst[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    }
+}
+
+#define EXPECT_PIXEL(x, y, r, g, b, a)                                  \
+    EXPECT_EQ((r), Pixel(x, y)[0]); EXPECT_EQ((g), Pixel(x, y)[1]);     \
+    EXPECT_EQ((b), Pixel(x, y)[2]); EXPECT_EQ((a), Pixel(x, y)[3]);
+
+// Objects declared here can be used by all tests.
+
+TEST_F(EtcDecoderTest, Formats)
+{
+    GLint count = 0;
+    const GLenum *formats = GetEtcCompressedFormats(&count);
+
+    ASSERT_EQ(6, count);
+    for(GLint i = 0; i < count; ++i) {
+        EXPECT_TRUE(IsEtcCompressedFormat(formats[i]));
+    }
+    EXPECT_FALSE(IsEtcCompressedFormat(GL_RGBA));
+
+    EXPECT_EQ(16u, GetEtcCompressedImageSize(GL_ETC1_RGB8_OES, 5, 3));
+    EXPECT_EQ(64u, GetEtcCompressedImageSize(GL_COMPRESSED_RGBA8_ETC2_EAC, 8, 5));
+}
+
+TEST_F(EtcDecoderTest, Etc1Individual)
+{
+    // R 0x8, G 0x4, B 0x2 in both subblocks, table 0
+    const uint32_t hi = 0x88442200;
+    // (0,0): -large, (1,2): +large, rest: +small
+    const uint32_t lo = (1u << 16) | (1u << 0) | (1u << 6);
+    uint8_t block[8];
+    StoreBlock((static_cast<uint64_t>(hi) << 32) | lo, block);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_ETC1_RGB8_OES, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(0, 0, 128, 60, 26, 255);
+    EXPECT_PIXEL(1, 2, 144, 76, 42, 255);
+    EXPECT_PIXEL(3, 3, 138, 70, 36, 255);
+}
+
+TEST_F(EtcDecoderTest, Etc1Flip)
+{
+    // R 0x0 in the first subblock and 0xF in the second one
+    uint8_t block[8];
+
+    StoreBlock(static_cast<uint64_t>(0x0F000000) << 32, block);
+    ASSERT_TRUE(DecodeEtcImage(GL_ETC1_RGB8_OES, 4, 4, block, DstData.data()));
+    EXPECT_EQ(2,   Pixel(0, 3)[0]);
+    EXPECT_EQ(255, Pixel(3, 0)[0]);
+
+    StoreBlock(static_cast<uint64_t>(0x0F000001) << 32, block);
+    ASSERT_TRUE(DecodeEtcImage(GL_ETC1_RGB8_OES, 4, 4, block, DstData.data()));
+    EXPECT_EQ(255, Pixel(0, 3)[0]);
+    EXPECT_EQ(2,   Pixel(3, 0)[0]);
+}
+
+TEST_F(EtcDecoderTest, Etc1Differential)
+{
+    // R 16 with delta -1, differential bit set
+    uint8_t block[8];
+    StoreBlock(static_cast<uint64_t>(0x87000002) << 32, block);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_ETC1_RGB8_OES, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(0, 0, 134, 2, 2, 255);
+    EXPECT_PIXEL(3, 0, 125, 2, 2, 255);
+
+    std::vector<uint8_t> etc1 = DstData;
+    ASSERT_TRUE(DecodeEtcImage(GL_COMPRESSED_RGB8_ETC2, 4, 4, block, DstData.data()));
+    EXPECT_EQ(etc1, DstData);
+}
+
+TEST_F(EtcDecoderTest, Etc2TMode)
+{
+    // the red component overflows: 31 + 1
+    const uint32_t hi = (0x1Fu << 27) | (1u << 24) | (2u << 20) | (3u << 16) |
+                        (4u << 12) | (5u << 8) | (6u << 4) | (1u << 1) | 1u;
+    // (0,0): 0, (1,0): 1, (2,0): 2, (3,0): 3
+    const uint32_t lo = (1u << 4) | (1u << 24) | (1u << 28) | (1u << 12);
+    uint8_t block[8];
+    StoreBlock((static_cast<uint64_t>(hi) << 32) | lo, block);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_COMPRESSED_RGB8_ETC2, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(0, 0, 221, 34,  51, 255);
+    EXPECT_PIXEL(1, 0,  74, 91, 108, 255);
+    EXPECT_PIXEL(2, 0,  68, 85, 102, 255);
+    EXPECT_PIXEL(3, 0,  62, 79,  96, 255);
+}
+
+TEST_F(EtcDecoderTest, Etc2Planar)
+{
+    // the blue component underflows: 2 - 4
+    // RO 0x20, GO 0x40, BO 0x10, RH 0x3F, GH 0x40, BH 0x10, RV 0x20, GV 0x40, BV 0x10
+    const uint32_t hi = (0x20u << 25) | (1u << 24) | (2u << 11) | (1u << 10) | (0x1Fu << 2) | (1u << 1) | 1u;
+    const uint32_t lo = (0x40u << 25) | (0x10u << 19) | (0x20u << 13) | (0x40u << 6) | 0x10u;
+    uint8_t block[8];
+    StoreBlock((static_cast<uint64_t>(hi) << 32) | lo, block);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_COMPRESSED_RGB8_ETC2, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(0, 0, 130, 129, 65, 255);
+    EXPECT_PIXEL(3, 0, 224, 129, 65, 255);
+    EXPECT_PIXEL(0, 3, 130, 129, 65, 255);
+}
+
+TEST_F(EtcDecoderTest, Etc2Punchthrough)
+{
+    // R 16, opaque bit cleared
+    // (0,0): transparent, (2,0): +large, rest: no modifier
+    const uint32_t hi = 0x80000000;
+    const uint32_t lo = (1u << 16) | (1u << 8);
+    uint8_t block[8];
+    StoreBlock((static_cast<uint64_t>(hi) << 32) | lo, block);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(0, 0,   0, 0, 0,   0);
+    EXPECT_PIXEL(1, 0, 132, 0, 0, 255);
+    EXPECT_PIXEL(2, 0, 140, 8, 8, 255);
+}
+
+TEST_F(EtcDecoderTest, Etc2Eac)
+{
+    // alpha: base 128, multiplier 1, table 0, index 4 (+2) except for (0,0)
+    uint64_t alpha = (0x80ull << 56) | (1ull << 52);
+    for(int i = 1; i < 16; ++i) {
+        alpha |= 4ull << (45 - 3 * i);
+    }
+    uint8_t block[16];
+    StoreBlock(alpha, block);
+    StoreBlock(static_cast<uint64_t>(0x88442200) << 32, block + 8);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_COMPRESSED_RGBA8_ETC2_EAC, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(0, 0, 138, 70, 36, 125);
+    EXPECT_PIXEL(2, 1, 138, 70, 36, 130);
+}
+
+TEST_F(EtcDecoderTest, EacR11)
+{
+    uint64_t red = (0x80ull << 56) | (1ull << 52);
+    for(int i = 0; i < 16; ++i) {
+        red |= 4ull << (45 - 3 * i);
+    }
+    uint8_t block[8];
+    StoreBlock(red, block);
+
+    ASSERT_TRUE(DecodeEtcImage(GL_COMPRESSED_R11_EAC, 4, 4, block, DstData.data()));
+    EXPECT_PIXEL(1, 1, 130, 0, 0, 255);
+}
+
+TEST_F(EtcDecoderTest, PartialBlocks)
+{
+    uint8_t blocks[16];
+    StoreBlock(static_cast<uint64_t>(0x88442200) << 32, blocks);
+    StoreBlock(static_cast<uint64_t>(0x44444400) << 32, blocks + 8);
+
+    std::vector<uint8_t> dst(4 * 5 * 3, 0);
+    ASSERT_TRUE(DecodeEtcImage(GL_ETC1_RGB8_OES, 5, 3, blocks, dst.data()));
+    EXPECT_EQ(138, dst[4 * (2 * 5 + 3)]);
+    EXPECT_EQ(70,  dst[4 * (2 * 5 + 4)]);
+}
+
+TEST_F(EtcDecoderTest, SubImageMipLevel)
+{
+    // level 2 of a 24x24 texture is 6x6, regions are checked against it and not against level 0
+    EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR),          ValidateEtcSubImage(6, 6, 0, 0, 6, 6));
+    EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR),          ValidateEtcSubImage(6, 6, 4, 4, 2, 2));
+    EXPECT_EQ(static_cast<GLenum>(GL_INVALID_VALUE),     ValidateEtcSubImage(6, 6, 4, 4, 4, 4));
+    EXPECT_EQ(static_cast<GLenum>(GL_INVALID_VALUE),     ValidateEtcSubImage(6, 6, 0, 0, 24, 24));
+    EXPECT_EQ(static_cast<GLenum>(GL_INVALID_OPERATION), ValidateEtcSubImage(6, 6, 0, 0, 2, 4));
+    EXPECT_EQ(static_cast<GLenum>(GL_INVALID_OPERATION), ValidateEtcSubImage(6, 6, 2, 0, 4, 4));
+    EXPECT_EQ(static_cast<GLenum>(GL_INVALID_VALUE),     ValidateEtcSubImage(6, 6, 0x7FFFFFFC, 0, 4, 4));
+}
+
+} //end of namespace
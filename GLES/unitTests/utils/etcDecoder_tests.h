@@ -0,0 +1,36 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __ETCDECODER_TESTS_H__
+#define __ETCDECODER_TESTS_H__
+
+#include "gtest/gtest.h"
+#include "utils/etcDecoder.h"
+#include <vector>
+
+namespace Testing {
+
+class EtcDecoderTest : public ::testing::Test {
+protected:
+    void SetUp(void);
+    void TearDown(void);
+
+    void     StoreBlock(uint64_t bits, uint8_t *dst);
+    uint8_t *Pixel(int x, int y)                        { return &DstData[4 * (y * 4 + x)]; }
+
+    std::vector<uint8_t> DstData;
+};
+
+} //end of namespace
+
+#endif // __ETCDECODER_TESTS_H__
@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "pixelConverters_tests.h"
+#include <cstring>
+
+namespace Testing {
+
+// Code here will be called immediately after the constructor (right
+// before each test).
+void PixelConvertersTest::SetUp(void) {
+    SrcData.resize(4 * 1024);
+    for(size_t i = 0; i < SrcData.size(); ++i) {
+        SrcData[i] = static_cast<uint8_t>((i * 131u) ^ (i >> 3));
+    }
+}
+
+// Code here will be called immediately after each test (right
+// before the destructor).
+void PixelConvertersTest::TearDown() {
+    return;
+}
+
+// Objects declared here can be used by all tests.
+
+TEST_F(PixelConvertersTest, MatchScalar)
+{
+    // odd widths exercise the scalar tail of the vectorized converters
+    const uint32_t widths[] = { 1, 7, 8, 15, 16, 17, 31, 33, 255, 1024 };
+
+    for(uint32_t type = 0; type < ROW_CONVERTER_MAX; ++type) {
+        for(uint32_t width : widths) {
+            std::vector<uint8_t> dstScalar(width * 4, 0);
+            std::vector<uint8_t> dstFast(width * 4, 0);
+
+            GetScalarRowConverter(static_cast<rowConverter_e>(type))(SrcData.data(), dstScalar.data(), width);
+            GetRowConverter(static_cast<rowConverter_e>(type))(SrcData.data(), dstFast.data(), width);
+
+            ASSERT_EQ(dstScalar, dstFast) << "converter " << type << ", width " << width;
+        }
+    }
+}
+
+TEST_F(PixelConvertersTest, Convert565)
+{
+    const uint8_t src[] = { 0x00, 0xF8, 0xE0, 0x07, 0x1F, 0x00, 0xFF, 0xFF };
+    const uint8_t ref[] = { 0xFF, 0x00, 0x00, 0xFF,
+                            0x00, 0xFF, 0x00, 0xFF,
+                            0x00, 0x00, 0xFF, 0xFF,
+                            0xFF, 0xFF, 0xFF, 0xFF };
+    uint8_t dst[sizeof(ref)];
+
+    GetRowConverter(ROW_CONVERTER_565_TO_RGBA)(src, dst, 4);
+    ASSERT_EQ(0, memcmp(ref, dst, sizeof(ref)));
+}
+
+TEST_F(PixelConvertersTest, ConvertRGB)
+{
+    const uint8_t src[] = { 0x10, 0x20, 0x30, 0x40, 0x50, 0x60 };
+    const uint8_t ref[] = { 0x10, 0x20, 0x30, 0xFF, 0x40, 0x50, 0x60, 0xFF };
+    uint8_t dst[sizeof(ref)];
+
+    GetRowConverter(ROW_CONVERTER_RGB_TO_RGBA)(src, dst, 2);
+    ASSERT_EQ(0, memcmp(ref, dst, sizeof(ref)));
+}
+
+} //end of namespace
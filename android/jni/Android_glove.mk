@@ -72,6 +72,7 @@ LOCAL_SRC_FILES :=  $(SRC_PATH)/GLES/source/api/gl.cpp \
                     $(SRC_PATH)/GLES/source/resources/texture.cpp \
                     $(SRC_PATH)/GLES/source/resources/rect.cpp \
                     $(SRC_PATH)/GLES/source/resources/sampler.cpp \
+                    $(SRC_PATH)/GLES/source/resources/vertexArrayObject.cpp \
                     $(SRC_PATH)/GLES/source/state/stateManager.cpp \
                     $(SRC_PATH)/GLES/source/state/stateActiveObjects.cpp \
                     $(SRC_PATH)/GLES/source/state/stateInputAssembly.cpp \
@@ -87,6 +88,7 @@ LOCAL_SRC_FILES :=  $(SRC_PATH)/GLES/source/api/gl.cpp \
                     $(SRC_PATH)/GLES/source/utils/glLogger.cpp \
                     $(SRC_PATH)/GLES/source/utils/glUtils.cpp \
                     $(SRC_PATH)/GLES/source/utils/cacheManager.cpp \
+                    $(SRC_PATH)/GLES/source/utils/commandStream.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/cbManager.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/clearPass.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/commandBufferPool.cpp \
@@ -144,6 +146,7 @@ LOCAL_SRC_FILES := $(SRC_PATH)/EGL/source/api/eglContext.cpp \
                    $(SRC_PATH)/EGL/source/api/eglConfig.cpp \
                    $(SRC_PATH)/EGL/source/api/egl.cpp \
                    $(SRC_PATH)/EGL/source/api/eglSurface.cpp \
+                   $(SRC_PATH)/EGL/source/api/eglSync.cpp \
                    $(SRC_PATH)/EGL/source/api/eglDisplay.cpp \
                    $(SRC_PATH)/EGL/source/display/displayDriver.cpp \
                    $(SRC_PATH)/EGL/source/display/displayDriversContainer.cpp \